@@ -0,0 +1,559 @@
+#define VGFW_IMPLEMENTATION
+#include "vgfw.hpp"
+
+#include <benchmark/benchmark.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <fstream>
+
+// CPU micro-benchmarks of vgfw's hot paths. Built with VGFW_NULL_GL, so everything that touches a RenderContext runs
+// without a GPU and only vgfw's own CPU cost is measured.
+//
+// Usage: vgfw-bench [google benchmark flags], results are also written to vgfw-bench.json unless --benchmark_out is
+// given.
+
+using namespace vgfw;
+
+// -------- hashing --------
+
+void benchHashCombine(benchmark::State& state)
+{
+    uint32_t i {0};
+    for (auto _ : state)
+    {
+        ++i;
+        std::size_t seed {0};
+        utils::hashCombine(seed, i, 1.0f, i * 3u, static_cast<int32_t>(i));
+        benchmark::DoNotOptimize(seed);
+    }
+}
+BENCHMARK(benchHashCombine);
+
+void benchHashVertexAttribute(benchmark::State& state)
+{
+    renderer::VertexAttribute attribute {.vertType = renderer::VertexAttribute::Type::eFloat3, .offset = 0};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::hash<renderer::VertexAttribute> {}(attribute));
+        attribute.offset = (attribute.offset + 4) & 63;
+    }
+}
+BENCHMARK(benchHashVertexAttribute);
+
+void benchHashTextureDesc(benchmark::State& state)
+{
+    renderer::framegraph::FrameGraphTexture::Desc desc {
+        .extent = {1280, 720},
+        .format = renderer::PixelFormat::eRGBA16F,
+    };
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::hash<renderer::framegraph::FrameGraphTexture::Desc> {}(desc));
+        desc.numMipLevels = desc.numMipLevels % 8 + 1;
+    }
+}
+BENCHMARK(benchHashTextureDesc);
+
+void benchHashBufferDesc(benchmark::State& state)
+{
+    renderer::framegraph::FrameGraphBuffer::Desc desc {.size = 256};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::hash<renderer::framegraph::FrameGraphBuffer::Desc> {}(desc));
+        desc.size = desc.size % 4096 + 256;
+    }
+}
+BENCHMARK(benchHashBufferDesc);
+
+// -------- vertex formats --------
+
+void setMeshAttributes(renderer::VertexFormat::Builder& builder)
+{
+    using Type = renderer::VertexAttribute::Type;
+
+    builder.setAttribute(renderer::AttributeLocation::ePosition, {.vertType = Type::eFloat3, .offset = 0})
+        .setAttribute(renderer::AttributeLocation::eNormal_Color, {.vertType = Type::eFloat3, .offset = 12})
+        .setAttribute(renderer::AttributeLocation::eTexCoords, {.vertType = Type::eFloat2, .offset = 24})
+        .setAttribute(renderer::AttributeLocation::eTangent, {.vertType = Type::eFloat4, .offset = 32});
+}
+
+// The builder caches formats by hash, state.range(0) keeps a reference alive so that the cache hits
+void benchVertexFormatBuild(benchmark::State& state)
+{
+    std::shared_ptr<renderer::VertexFormat> cached;
+    if (state.range(0))
+    {
+        renderer::VertexFormat::Builder builder;
+        setMeshAttributes(builder);
+        cached = builder.build();
+    }
+
+    for (auto _ : state)
+    {
+        renderer::VertexFormat::Builder builder;
+        setMeshAttributes(builder);
+        benchmark::DoNotOptimize(builder.build());
+    }
+}
+BENCHMARK(benchVertexFormatBuild)->ArgName("cached")->Arg(0)->Arg(1);
+
+void benchGetVertexArray(benchmark::State& state)
+{
+    auto& rc = renderer::getRenderContext();
+
+    renderer::VertexFormat::Builder builder;
+    setMeshAttributes(builder);
+    const auto vertexFormat = builder.build();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(rc.getVertexArray(vertexFormat->getAttributes()));
+}
+BENCHMARK(benchGetVertexArray);
+
+// The VAO is cached on the format, against the attribute hash above
+void benchGetVertexArrayFromFormat(benchmark::State& state)
+{
+    auto& rc = renderer::getRenderContext();
+
+    renderer::VertexFormat::Builder builder;
+    setMeshAttributes(builder);
+    const auto vertexFormat = builder.build();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(rc.getVertexArray(*vertexFormat));
+}
+BENCHMARK(benchGetVertexArrayFromFormat);
+
+// -------- pipelines --------
+
+renderer::GraphicsPipeline buildPipeline(bool blend)
+{
+    // The null backend accepts any program name
+    return renderer::GraphicsPipeline::Builder {}
+        .setShaderProgram(1)
+        .setDepthStencil({.depthTest = true, .depthCompareOp = renderer::CompareOp::eLessOrEqual})
+        .setBlendState(0,
+                       {
+                           .enabled   = blend,
+                           .srcColor  = renderer::BlendFactor::eSrcAlpha,
+                           .destColor = renderer::BlendFactor::eOneMinusSrcAlpha,
+                       })
+        .build();
+}
+
+void benchGraphicsPipelineBuild(benchmark::State& state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(buildPipeline(true));
+}
+BENCHMARK(benchGraphicsPipelineBuild);
+
+// state.range(0) alternates between two pipelines that differ in one blend state, otherwise rebinds the same one
+void benchBindGraphicsPipeline(benchmark::State& state)
+{
+    auto&            rc = renderer::getRenderContext();
+    const std::array pipelines {buildPipeline(false), buildPipeline(true)};
+
+    for (uint32_t i {0}; auto _ : state)
+        rc.bindGraphicsPipeline(pipelines[state.range(0) ? i++ % 2 : 0]);
+}
+BENCHMARK(benchBindGraphicsPipeline)->ArgName("alternate")->Arg(0)->Arg(1);
+
+// -------- frame arena --------
+
+// state.range(0) allocates the draw buffer list of beginRendering from the frame arena instead of the heap
+void benchFrameArenaVector(benchmark::State& state)
+{
+    auto& arena = memory::getFrameArena();
+
+    for (auto _ : state)
+    {
+        arena.nextFrame();
+        for (uint32_t i {0}; i < 64; ++i)
+        {
+            if (state.range(0))
+            {
+                memory::FrameVector<GLenum> colorBuffers(4);
+                benchmark::DoNotOptimize(colorBuffers.data());
+            }
+            else
+            {
+                std::vector<GLenum> colorBuffers(4);
+                benchmark::DoNotOptimize(colorBuffers.data());
+            }
+        }
+    }
+}
+BENCHMARK(benchFrameArenaVector)->ArgName("arena")->Arg(0)->Arg(1);
+
+// -------- mesh building --------
+
+resource::MeshPrimitive makeGridPrimitive(uint32_t numQuadsPerSide)
+{
+    resource::MeshPrimitive primitive;
+
+    const auto numVerticesPerSide = numQuadsPerSide + 1;
+    for (uint32_t y {0}; y < numVerticesPerSide; ++y)
+    {
+        for (uint32_t x {0}; x < numVerticesPerSide; ++x)
+        {
+            const glm::vec2 uv {x / float(numQuadsPerSide), y / float(numQuadsPerSide)};
+            primitive.record.positions.emplace_back(uv.x, 0.0f, uv.y);
+            primitive.record.normals.emplace_back(0.0f, 1.0f, 0.0f);
+            primitive.record.texcoords.push_back(uv);
+            primitive.record.tangents.emplace_back(1.0f, 0.0f, 0.0f, 1.0f);
+        }
+    }
+
+    for (uint32_t y {0}; y < numQuadsPerSide; ++y)
+    {
+        for (uint32_t x {0}; x < numQuadsPerSide; ++x)
+        {
+            const auto i = y * numVerticesPerSide + x;
+            const auto j = i + numVerticesPerSide;
+            primitive.indices.insert(primitive.indices.end(), {i, j, i + 1, i + 1, j, j + 1});
+        }
+    }
+
+    primitive.vertexCount = static_cast<uint32_t>(primitive.record.positions.size());
+    return primitive;
+}
+
+void benchMeshPrimitiveBuild(benchmark::State& state)
+{
+    auto&           rc = renderer::getRenderContext();
+    resource::Model model;
+
+    const auto prototype = makeGridPrimitive(static_cast<uint32_t>(state.range(0)));
+
+    std::optional<resource::MeshPrimitive>         primitive;
+    std::optional<renderer::VertexFormat::Builder> builder;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        // Nothing is in flight with the null backend, the previous buffers can be destroyed right away
+        if (primitive)
+        {
+            primitive->release(rc);
+            rc.collectGarbage(0);
+        }
+        primitive.emplace(prototype);
+        primitive->ownerModel = &model;
+        builder.emplace();
+        setMeshAttributes(*builder);
+        state.ResumeTiming();
+
+        primitive->build(*builder, glm::vec3 {2.0f}, rc);
+    }
+    state.SetItemsProcessed(state.iterations() * prototype.vertexCount);
+
+    if (primitive)
+    {
+        primitive->release(rc);
+        rc.collectGarbage(0);
+    }
+}
+BENCHMARK(benchMeshPrimitiveBuild)->ArgName("quads")->Arg(16)->Arg(128)->Arg(512);
+
+// -------- math --------
+
+std::vector<math::AABB> makeBoxes(size_t count)
+{
+    std::vector<math::AABB> boxes(count);
+    for (size_t i {0}; i < count; ++i)
+    {
+        const glm::vec3 center {float(i % 32), float(i / 32 % 32), float(i / 1024)};
+        boxes[i] = {.min = center - 0.5f, .max = center + 0.5f};
+    }
+    return boxes;
+}
+
+void benchAABBTransform(benchmark::State& state)
+{
+    const auto boxes     = makeBoxes(1024);
+    const auto transform = glm::rotate(glm::translate(glm::mat4 {1.0f}, glm::vec3 {1.0f, 2.0f, 3.0f}),
+                                       glm::radians(30.0f),
+                                       glm::vec3 {0.0f, 1.0f, 0.0f});
+    for (auto _ : state)
+    {
+        for (const auto& box : boxes)
+            benchmark::DoNotOptimize(box.transform(transform));
+    }
+    state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+BENCHMARK(benchAABBTransform);
+
+void benchAABBMerge(benchmark::State& state)
+{
+    const auto boxes = makeBoxes(1024);
+    for (auto _ : state)
+    {
+        auto bounds = boxes.front();
+        for (const auto& box : boxes)
+            bounds.merge(box);
+        benchmark::DoNotOptimize(bounds);
+    }
+    state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+BENCHMARK(benchAABBMerge);
+
+void benchBuildCascades(benchmark::State& state)
+{
+    const auto projection     = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    const auto view           = glm::lookAt(glm::vec3 {0.0f, 2.0f, 5.0f}, glm::vec3 {0.0f}, glm::vec3 {0, 1, 0});
+    const auto lightDirection = glm::normalize(glm::vec3 {-0.3f, -1.0f, -0.2f});
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(renderer::shadow::buildCascades(
+            0.1f, 100.0f, projection * view, lightDirection, static_cast<uint32_t>(state.range(0)), 0.94f, 2048));
+    }
+}
+BENCHMARK(benchBuildCascades)->ArgName("cascades")->Arg(1)->Arg(4);
+
+// -------- scene graph --------
+
+// Moves a percentage of the leaves of a hierarchy (fan-out 8) every frame, then propagates and uploads the transforms
+void benchSceneUpdate(benchmark::State& state)
+{
+    auto&      rc          = renderer::getRenderContext();
+    const auto numNodes    = static_cast<uint32_t>(state.range(0));
+    const auto movingRatio = state.range(1) / 100.0f;
+
+    resource::MeshPrimitive meshPrimitive;
+    meshPrimitive.aabb = {.min = glm::vec3 {-0.5f}, .max = glm::vec3 {0.5f}};
+
+    scene::Scene                   scene;
+    std::vector<scene::NodeHandle> nodes {scene.createNode()};
+    for (uint32_t i {1}; i < numNodes; ++i)
+    {
+        const scene::Transform local {.translation = {float(i % 8), 0.0f, 0.0f}};
+        nodes.push_back(scene.createNode(nodes[(i - 1) / 8], local, &meshPrimitive));
+    }
+    scene.update();
+
+    const auto numMoving = std::max(static_cast<uint32_t>(numNodes * movingRatio), 1u);
+    float      time {0.0f};
+    for (auto _ : state)
+    {
+        time += 0.01f;
+        for (uint32_t i {0}; i < numMoving; ++i)
+            scene.setLocalTransform(nodes[numNodes - 1 - i], {.translation = {time, float(i), 0.0f}});
+
+        benchmark::DoNotOptimize(scene.update());
+        benchmark::DoNotOptimize(&scene.uploadTransforms(rc));
+    }
+    state.SetItemsProcessed(state.iterations() * numMoving);
+
+    scene.release(rc);
+    rc.collectGarbage(0);
+}
+BENCHMARK(benchSceneUpdate)
+    ->ArgNames({"nodes", "moving"})
+    ->Args({10000, 1})
+    ->Args({10000, 100})
+    ->Args({50000, 1})
+    ->Args({50000, 100});
+
+// -------- framegraph transient resources --------
+
+// A frame's worth of acquire/release plus the heartbeat. With a short frame time the pools are reused, with
+// dt >= 1s (state.range(0) == 0) every idle resource is destroyed and recreated the next frame.
+void benchTransientResources(benchmark::State& state)
+{
+    using namespace renderer::framegraph;
+
+    const std::array<FrameGraphTexture::Desc, 4> textureDescs {{
+        {.extent = {1280, 720}, .format = renderer::PixelFormat::eRGBA16F},
+        {.extent = {1280, 720}, .format = renderer::PixelFormat::eRGBA8_UNorm},
+        {.extent = {1280, 720}, .format = renderer::PixelFormat::eDepth24},
+        {.extent = {2048, 2048}, .layers = 4, .format = renderer::PixelFormat::eDepth24, .shadowSampler = true},
+    }};
+    const std::array<FrameGraphBuffer::Desc, 2> bufferDescs {{{.size = 256}, {.size = 4096}}};
+
+    const auto dt = state.range(0) ? 1.0f / 60.0f : 1.0f;
+
+    TransientResources transientResources {renderer::getRenderContext()};
+    for (auto _ : state)
+    {
+        std::array<renderer::Texture*, 2 * textureDescs.size()> textures {};
+        std::array<renderer::Buffer*, bufferDescs.size()>       buffers {};
+
+        for (size_t i {0}; i < textures.size(); ++i)
+            textures[i] = transientResources.acquireTexture(textureDescs[i % textureDescs.size()]);
+        for (size_t i {0}; i < buffers.size(); ++i)
+            buffers[i] = transientResources.acquireBuffer(bufferDescs[i]);
+
+        for (size_t i {0}; i < textures.size(); ++i)
+            transientResources.releaseTexture(textureDescs[i % textureDescs.size()], textures[i]);
+        for (size_t i {0}; i < buffers.size(); ++i)
+            transientResources.releaseBuffer(bufferDescs[i], buffers[i]);
+
+        transientResources.update(dt);
+    }
+}
+BENCHMARK(benchTransientResources)->ArgName("reuse")->Arg(1)->Arg(0);
+
+// -------- model loading --------
+
+std::filesystem::path getBenchDirectory()
+{
+    const auto directory = std::filesystem::temp_directory_path() / "vgfw-bench";
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+std::filesystem::path writeGridOBJ(uint32_t numQuadsPerSide)
+{
+    const auto path      = getBenchDirectory() / fmt::format("grid_{0}.obj", numQuadsPerSide);
+    const auto primitive = makeGridPrimitive(numQuadsPerSide);
+
+    std::ofstream file {path};
+    for (const auto& p : primitive.record.positions)
+        file << fmt::format("v {0} {1} {2}\n", p.x, p.y, p.z);
+    for (const auto& uv : primitive.record.texcoords)
+        file << fmt::format("vt {0} {1}\n", uv.x, uv.y);
+    file << "vn 0 1 0\n";
+    for (size_t i {0}; i < primitive.indices.size(); i += 3)
+    {
+        const auto a = primitive.indices[i] + 1, b = primitive.indices[i + 1] + 1, c = primitive.indices[i + 2] + 1;
+        file << fmt::format("f {0}/{0}/1 {1}/{1}/1 {2}/{2}/1\n", a, b, c);
+    }
+    return path;
+}
+
+// Embeds the buffer as a base64 data URI, so the parsing cost includes decoding it
+std::filesystem::path writeGridGLTF(uint32_t numQuadsPerSide)
+{
+    const auto path      = getBenchDirectory() / fmt::format("grid_{0}.gltf", numQuadsPerSide);
+    const auto primitive = makeGridPrimitive(numQuadsPerSide);
+
+    tinygltf::Model  gltfModel;
+    tinygltf::Buffer buffer;
+
+    const auto append = [&](const void* data, size_t size) {
+        const auto offset = buffer.data.size();
+        buffer.data.resize(offset + size);
+        std::memcpy(buffer.data.data() + offset, data, size);
+
+        tinygltf::BufferView bufferView;
+        bufferView.buffer     = 0;
+        bufferView.byteOffset = offset;
+        bufferView.byteLength = size;
+        gltfModel.bufferViews.push_back(bufferView);
+        return static_cast<int>(gltfModel.bufferViews.size() - 1);
+    };
+    const auto addAccessor = [&](int bufferView, int componentType, int type, size_t count) {
+        tinygltf::Accessor accessor;
+        accessor.bufferView    = bufferView;
+        accessor.componentType = componentType;
+        accessor.type          = type;
+        accessor.count         = count;
+        gltfModel.accessors.push_back(accessor);
+        return static_cast<int>(gltfModel.accessors.size() - 1);
+    };
+
+    const auto& record      = primitive.record;
+    const auto  vertexCount = record.positions.size();
+
+    tinygltf::Primitive gltfPrimitive;
+    gltfPrimitive.material = 0;
+    gltfPrimitive.indices  = addAccessor(append(primitive.indices.data(), primitive.indices.size() * sizeof(uint32_t)),
+                                        TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT,
+                                        TINYGLTF_TYPE_SCALAR,
+                                        primitive.indices.size());
+    gltfPrimitive.attributes["POSITION"] =
+        addAccessor(append(record.positions.data(), vertexCount * sizeof(glm::vec3)),
+                    TINYGLTF_COMPONENT_TYPE_FLOAT,
+                    TINYGLTF_TYPE_VEC3,
+                    vertexCount);
+    gltfPrimitive.attributes["NORMAL"] = addAccessor(append(record.normals.data(), vertexCount * sizeof(glm::vec3)),
+                                                     TINYGLTF_COMPONENT_TYPE_FLOAT,
+                                                     TINYGLTF_TYPE_VEC3,
+                                                     vertexCount);
+    gltfPrimitive.attributes["TEXCOORD_0"] =
+        addAccessor(append(record.texcoords.data(), vertexCount * sizeof(glm::vec2)),
+                    TINYGLTF_COMPONENT_TYPE_FLOAT,
+                    TINYGLTF_TYPE_VEC2,
+                    vertexCount);
+    gltfPrimitive.attributes["TANGENT"] = addAccessor(append(record.tangents.data(), vertexCount * sizeof(glm::vec4)),
+                                                      TINYGLTF_COMPONENT_TYPE_FLOAT,
+                                                      TINYGLTF_TYPE_VEC4,
+                                                      vertexCount);
+
+    tinygltf::Mesh mesh;
+    mesh.name = "grid";
+    mesh.primitives.push_back(gltfPrimitive);
+
+    gltfModel.buffers.push_back(buffer);
+    gltfModel.meshes.push_back(mesh);
+    gltfModel.materials.emplace_back();
+    gltfModel.asset.version = "2.0";
+
+    tinygltf::TinyGLTF writer;
+    writer.WriteGltfSceneToFile(&gltfModel, path.generic_string(), true, true, false, false);
+    return path;
+}
+
+void benchLoadModel(benchmark::State& state, std::filesystem::path (*writeModel)(uint32_t))
+{
+    auto&      rc   = renderer::getRenderContext();
+    const auto path = writeModel(static_cast<uint32_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        resource::Model model;
+        if (!io::loadModel(path, model, rc))
+        {
+            state.SkipWithError("Failed to load the generated model");
+            break;
+        }
+        benchmark::DoNotOptimize(model.aabb);
+
+        // Nothing is in flight with the null backend, the buffers can be destroyed right away
+        model.release(rc);
+        rc.collectGarbage(0);
+    }
+}
+BENCHMARK_CAPTURE(benchLoadModel, obj, writeGridOBJ)->ArgName("quads")->Arg(16)->Arg(128);
+BENCHMARK_CAPTURE(benchLoadModel, gltf, writeGridGLTF)->ArgName("quads")->Arg(16)->Arg(128);
+
+int main(int argc, char** argv)
+{
+    // Always keep a JSON report, so regressions can be tracked over time
+    std::vector<char*> args {argv, argv + argc};
+    std::string        outArg {"--benchmark_out=vgfw-bench.json"};
+    std::string        outFormatArg {"--benchmark_out_format=json"};
+    if (std::none_of(args.cbegin(), args.cend(), [](const char* arg) {
+            return std::string_view {arg}.starts_with("--benchmark_out=");
+        }))
+    {
+        args.push_back(outArg.data());
+        args.push_back(outFormatArg.data());
+    }
+
+    auto numArgs = static_cast<int>(args.size());
+    benchmark::Initialize(&numArgs, args.data());
+    if (benchmark::ReportUnrecognizedArguments(numArgs, args.data()))
+        return -1;
+
+    // Init VGFW
+    if (!vgfw::init())
+    {
+        std::cerr << "Failed to initialize VGFW" << std::endl;
+        return -1;
+    }
+    // Trace logging of resource creation would dominate some of the measurements
+    log::g_Logger->set_level(spdlog::level::warn);
+
+    // Init renderer on a null window, the GL calls are stubs
+    auto window = vgfw::window::create({.title = "vgfw-bench"}, vgfw::window::WindowType::eNull);
+    vgfw::renderer::init({.window = window});
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    vgfw::shutdown();
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+add_requires("benchmark")
+
+-- target defination, name: vgfw-bench
+target("vgfw-bench")
+    -- set target kind: executable
+    set_kind("binary")
+
+    -- add source files
+    add_files("main.cpp")
+
+    -- add deps
+    add_deps("vgfw")
+
+    -- add packages
+    add_packages("benchmark")
+
+    -- add defines: no GPU needed, GL calls are stubs
+    add_defines("VGFW_NULL_GL")
+
+    -- set target directory
+    set_targetdir("$(buildir)/$(plat)/$(arch)/$(mode)/bench")
@@ -29,6 +29,21 @@ void main()
 }
 )";
 
+struct Vertex
+{
+    glm::vec3 position;
+    glm::vec3 color;
+
+    // The vertex format is derived from this list at compile time
+    static constexpr auto getVertexFields()
+    {
+        return std::array {
+            VGFW_VERTEX_FIELD(Vertex, position, ePosition),
+            VGFW_VERTEX_FIELD(Vertex, color, eNormal_Color),
+        };
+    }
+};
+
 int main()
 {
     // Init VGFW
@@ -48,15 +63,10 @@ int main()
     auto& rc = vgfw::renderer::getRenderContext();
 
     // Build vertex format
-    auto vertexFormat = vgfw::renderer::VertexFormat::Builder {}
-                            .setAttribute(vgfw::renderer::AttributeLocation::ePosition,
-                                          {.vertType = vgfw::renderer::VertexAttribute::Type::eFloat3, .offset = 0})
-                            .setAttribute(vgfw::renderer::AttributeLocation::eNormal_Color,
-                                          {.vertType = vgfw::renderer::VertexAttribute::Type::eFloat3, .offset = 12})
-                            .build();
+    const auto& vertexFormat = vgfw::renderer::VertexFormat::get<Vertex>();
 
     // Get vertex array object
-    auto vao = rc.getVertexArray(vertexFormat->getAttributes());
+    auto vao = rc.getVertexArray(*vertexFormat);
 
     // Create shader program
     auto program = rc.createGraphicsProgram(vertexShaderSource, fragmentShaderSource);
@@ -79,11 +89,11 @@ int main()
 
     // clang-format off
     // Vertices
-    float vertices[] = {
-        // Position                                    // Color
-         0.0f,  0.5f, 0.0f,   1.0f, 0.0f, 0.0f,
-        -0.5f, -0.5f, 0.0f,   0.0f, 1.0f, 0.0f,
-         0.5f, -0.5f, 0.0f,   0.0f, 0.0f, 1.0f
+    Vertex vertices[] = {
+        // Position                  // Color
+        {{ 0.0f,  0.5f, 0.0f},   {1.0f, 0.0f, 0.0f}},
+        {{-0.5f, -0.5f, 0.0f},   {0.0f, 1.0f, 0.0f}},
+        {{ 0.5f, -0.5f, 0.0f},   {0.0f, 0.0f, 1.0f}}
     };
 
     // Indices
@@ -64,7 +64,7 @@ int main()
                             .build();
 
     // Get vertex array object
-    auto vao = rc.getVertexArray(vertexFormat->getAttributes());
+    auto vao = rc.getVertexArray(*vertexFormat);
 
     // Create shader program
     auto program = rc.createGraphicsProgram(vertexShaderSource, fragmentShaderSource);
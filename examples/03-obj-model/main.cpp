@@ -93,7 +93,7 @@ int main()
     }
 
     // Get vertex array object
-    auto vao = rc.getVertexArray(spotModel.meshPrimitives[0].vertexFormat->getAttributes());
+    auto vao = rc.getVertexArray(*spotModel.meshPrimitives[0].vertexFormat);
 
     // Create shader program
     auto program = rc.createGraphicsProgram(vertexShaderSource, fragmentShaderSource);
@@ -155,7 +155,7 @@ int main()
     }
 
     // Get vertex array object
-    auto vao = rc.getVertexArray(suzanneModel.meshPrimitives[0].vertexFormat->getAttributes());
+    auto vao = rc.getVertexArray(*suzanneModel.meshPrimitives[0].vertexFormat);
 
     // Create shader program
     auto program = rc.createGraphicsProgram(vertexShaderSource, fragmentShaderSource);
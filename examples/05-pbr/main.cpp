@@ -88,22 +88,14 @@ int main()
     // Create a texture sampler
     auto sampler = rc.createSampler({.maxAnisotropy = 8});
 
-    vgfw::time::TimePoint lastTime = vgfw::time::Clock::now();
-
     // Main loop
     while (!window->shouldClose())
     {
         VGFW_PROFILE_NAMED_SCOPE("Main Loop");
 
-        vgfw::time::TimePoint currentTime = vgfw::time::Clock::now();
-        vgfw::time::Duration  deltaTime   = currentTime - lastTime;
-        lastTime                          = currentTime;
-
-        float deltaTimeSeconds = deltaTime.count();
-
         window->onTick();
 
-        camera.update(window, deltaTimeSeconds);
+        camera.update(window, vgfw::renderer::getFrameStatsRecorder().getDeltaTime());
 
         uploadCamera(cameraBuffer, camera.data, rc);
         uploadLight(lightBuffer, light, rc);
@@ -120,7 +112,7 @@ int main()
 
             for (auto& meshPrimitive : sponza.meshPrimitives)
             {
-                auto vao = rc.getVertexArray(meshPrimitive.vertexFormat->getAttributes());
+                auto vao = rc.getVertexArray(*meshPrimitive.vertexFormat);
 
                 // Build a graphics pipeline
                 auto graphicsPipeline = vgfw::renderer::GraphicsPipeline::Builder {}
@@ -150,13 +142,13 @@ int main()
         ImGui::Begin("PBR");
         ImGui::SliderFloat("Camera FOV", &camera.fov, 1.0f, 179.0f);
         ImGui::Text("Press CAPSLOCK to toggle the camera (W/A/S/D/Q/E + Mouse)");
+        const auto frameStats = vgfw::renderer::getFrameStatsRecorder().getReport();
+        ImGui::Text("Frame: p50 %.2f ms, p99 %.2f ms", frameStats.frame.p50, frameStats.frame.p99);
         ImGui::End();
 
         vgfw::renderer::endFrame();
 
         vgfw::renderer::present();
-
-        VGFW_PROFILE_END_OF_FRAME
     }
 
     // Cleanup
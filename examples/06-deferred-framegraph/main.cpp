@@ -26,7 +26,10 @@ int main()
     auto window = vgfw::window::create({.title = "06-deferred-framegraph"});
 
     // Init renderer
-    vgfw::renderer::init({.window = window});
+    vgfw::renderer::init({.window = window, .trackLatency = true});
+
+    // Init job system, texture decoding is spread across the workers
+    vgfw::jobs::init();
 
     // Get render context
     auto& rc = vgfw::renderer::getRenderContext();
@@ -52,7 +55,9 @@ int main()
     // Create a texture sampler
     auto sampler = rc.createSampler({.maxAnisotropy = 8});
 
-    vgfw::time::TimePoint lastTime = vgfw::time::Clock::now();
+    // Dump the per-frame timings of the last frames when the renderer shuts down
+    auto& frameStatsRecorder = vgfw::renderer::getFrameStatsRecorder();
+    frameStatsRecorder.setExportOnExit("FrameStats.csv");
 
     // Define render passes
     GBufferPass          gBufferPass(rc);
@@ -68,11 +73,7 @@ int main()
     {
         VGFW_PROFILE_NAMED_SCOPE("Main Loop");
 
-        vgfw::time::TimePoint currentTime = vgfw::time::Clock::now();
-        vgfw::time::Duration  deltaTime   = currentTime - lastTime;
-        lastTime                          = currentTime;
-
-        float dt = deltaTime.count();
+        const float dt = frameStatsRecorder.getDeltaTime();
 
         window->onTick();
 
@@ -124,8 +125,25 @@ int main()
         {
             renderTarget = static_cast<RenderTarget>(currentItem);
         }
+
+        const auto frameStats = frameStatsRecorder.getReport();
+        ImGui::Text("Frame: p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, stutters %u",
+                    frameStats.frame.p50,
+                    frameStats.frame.p95,
+                    frameStats.frame.p99,
+                    frameStats.numStutters);
+        ImGui::Text("CPU: p50 %.2f ms, GPU: p50 %.2f ms", frameStats.cpu.p50, frameStats.gpu.p50);
+
+        // Replay with: vgfw-replay Sponza.vgtrace
+        auto& traceCapture = vgfw::renderer::getTraceCapture();
+        ImGui::BeginDisabled(traceCapture.isCapturing());
+        if (ImGui::Button("Capture Trace (60 frames)"))
+            traceCapture.capture("Sponza.vgtrace", 60);
+        ImGui::EndDisabled();
         ImGui::End();
 
+        vgfw::renderer::getLatencyTracker().drawOverlay();
+
         vgfw::renderer::endFrame();
 
         vgfw::renderer::present();
@@ -61,9 +61,9 @@ FrameGraphResource DeferredLightingPass::addToGraph(FrameGraph& fg, FrameGraphBl
 
             auto& rc = *static_cast<vgfw::renderer::RenderContext*>(ctx);
 
-            const vgfw::renderer::RenderingInfo renderingInfo {
-                .area             = {.extent = extent},
-                .colorAttachments = {{
+            const vgfw::renderer::FrameRenderingInfo renderingInfo {
+                {.extent = extent},
+                {{
                     .image      = vgfw::renderer::framegraph::getTexture(resources, data.sceneColorHDR),
                     .clearValue = glm::vec4 {0.0f},
                 }},
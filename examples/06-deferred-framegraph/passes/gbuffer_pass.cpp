@@ -58,23 +58,22 @@ void GBufferPass::addToGraph(FrameGraph&                                       f
             constexpr glm::vec4 kBlackColor {0.0f};
             constexpr float     kFarPlane {1.0f};
 
-            vgfw::renderer::RenderingInfo renderingInfo = {
-                .area = {.extent = resolution},
-                .colorAttachments =
-                    {
-                        {.image      = vgfw::renderer::framegraph::getTexture(resources, data.position),
-                         .clearValue = kBlackColor},
-                        {.image      = vgfw::renderer::framegraph::getTexture(resources, data.normal),
-                         .clearValue = kBlackColor},
-                        {.image      = vgfw::renderer::framegraph::getTexture(resources, data.albedo),
-                         .clearValue = kBlackColor},
-                        {.image      = vgfw::renderer::framegraph::getTexture(resources, data.emissive),
-                         .clearValue = kBlackColor},
-                        {.image      = vgfw::renderer::framegraph::getTexture(resources, data.metallicRoughnessAO),
-                         .clearValue = kBlackColor},
-                    },
-                .depthAttachment = vgfw::renderer::AttachmentInfo {
-                    .image = vgfw::renderer::framegraph::getTexture(resources, data.depth), .clearValue = kFarPlane}};
+            const vgfw::renderer::FrameRenderingInfo renderingInfo {
+                {.extent = resolution},
+                {
+                    {.image      = vgfw::renderer::framegraph::getTexture(resources, data.position),
+                     .clearValue = kBlackColor},
+                    {.image      = vgfw::renderer::framegraph::getTexture(resources, data.normal),
+                     .clearValue = kBlackColor},
+                    {.image      = vgfw::renderer::framegraph::getTexture(resources, data.albedo),
+                     .clearValue = kBlackColor},
+                    {.image      = vgfw::renderer::framegraph::getTexture(resources, data.emissive),
+                     .clearValue = kBlackColor},
+                    {.image      = vgfw::renderer::framegraph::getTexture(resources, data.metallicRoughnessAO),
+                     .clearValue = kBlackColor},
+                },
+                vgfw::renderer::AttachmentInfo {.image = vgfw::renderer::framegraph::getTexture(resources, data.depth),
+                                                .clearValue = kFarPlane}};
 
             auto frameBuffer = rc.beginRendering(renderingInfo);
 
@@ -114,7 +113,7 @@ vgfw::renderer::GraphicsPipeline& GBufferPass::getPipeline(const vgfw::renderer:
 
 vgfw::renderer::GraphicsPipeline GBufferPass::createPipeline(const vgfw::renderer::VertexFormat& vertexFormat)
 {
-    auto vertexArrayObject = m_RenderContext.getVertexArray(vertexFormat.getAttributes());
+    auto vertexArrayObject = m_RenderContext.getVertexArray(vertexFormat);
 
     auto program = m_RenderContext.createGraphicsProgram(vgfw::utils::readFileAllText("shaders/geometry.vert"),
                                                          vgfw::utils::readFileAllText("shaders/gbuffer.frag"));
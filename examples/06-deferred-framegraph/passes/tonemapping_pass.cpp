@@ -43,9 +43,9 @@ FrameGraphResource TonemappingPass::addToGraph(FrameGraph& fg, FrameGraphResourc
             VGFW_PROFILE_GL("Tone-mapping Pass");
             VGFW_PROFILE_NAMED_SCOPE("Tone-mapping Pass");
 
-            const vgfw::renderer::RenderingInfo renderingInfo {
-                .area             = {.extent = extent},
-                .colorAttachments = {{
+            const vgfw::renderer::FrameRenderingInfo renderingInfo {
+                {.extent = extent},
+                {{
                     .image = vgfw::renderer::framegraph::getTexture(resources, data.output),
                 }},
             };
@@ -29,7 +29,7 @@ target("06-deferred-framegraph")
     add_packages("shaderc", "tracy")
 
     -- add defines
-    add_defines("VGFW_ENABLE_TRACY", "VGFW_ENABLE_GL_DEBUG")
+    add_defines("VGFW_ENABLE_TRACY", "VGFW_ENABLE_GL_DEBUG", "VGFW_ENABLE_TRACE_CAPTURE")
 
     -- set target directory
     set_targetdir("$(buildir)/$(plat)/$(arch)/$(mode)/examples/06-deferred-framegraph")
\ No newline at end of file
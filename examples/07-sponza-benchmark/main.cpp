@@ -0,0 +1,438 @@
+#define VGFW_IMPLEMENTATION
+#include "vgfw.hpp"
+
+#include "render_target.hpp"
+
+#include "uniforms/camera_uniform.hpp"
+#include "uniforms/light_uniform.hpp"
+
+#include "pass_resource/scene_color_data.hpp"
+
+#include "passes/deferred_lighting_pass.hpp"
+#include "passes/final_composition_pass.hpp"
+#include "passes/gbuffer_pass.hpp"
+#include "passes/tonemapping_pass.hpp"
+
+// Renders Sponza with the passes of 06-deferred-framegraph along a fixed camera path and writes a summary JSON with
+// per-frame and per-pass CPU/GPU timings and the load-time breakdown of Sponza. Every frame depends on its index only
+// (never on the elapsed time), so runs are comparable between machines and builds. The window stays hidden; on a
+// machine without a GPU run it with --llvmpipe under a virtual display (xvfb-run).
+//
+// Usage: 07-sponza-benchmark [--frames N] [--warmup N] [--width W] [--height H] [--out summary.json]
+//                            [--golden dir] [--golden-threshold rmse] [--llvmpipe]
+
+struct BenchmarkOptions
+{
+    uint32_t                             numFrames {600};
+    uint32_t                             numWarmupFrames {60};
+    uint32_t                             width {1280};
+    uint32_t                             height {720};
+    std::filesystem::path                summaryPath {"SponzaBenchmark.json"};
+    std::optional<std::filesystem::path> goldenDirectory;
+    float                                goldenThreshold {2.0f}; // RMSE in 8-bit units
+    bool                                 llvmpipe {false};
+};
+
+std::optional<BenchmarkOptions> parseOptions(int argc, char** argv)
+{
+    BenchmarkOptions options {};
+
+    // Malformed numbers (std::stoi / std::stof throw) fall back to the usage message
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg {argv[i]};
+            const bool             hasValue = i + 1 < argc;
+
+            if (arg == "--frames" && hasValue)
+                options.numFrames = std::max(std::stoi(argv[++i]), 1);
+            else if (arg == "--warmup" && hasValue)
+                options.numWarmupFrames = std::max(std::stoi(argv[++i]), 0);
+            else if (arg == "--width" && hasValue)
+                options.width = std::max(std::stoi(argv[++i]), 1);
+            else if (arg == "--height" && hasValue)
+                options.height = std::max(std::stoi(argv[++i]), 1);
+            else if (arg == "--out" && hasValue)
+                options.summaryPath = argv[++i];
+            else if (arg == "--golden" && hasValue)
+                options.goldenDirectory = argv[++i];
+            else if (arg == "--golden-threshold" && hasValue)
+                options.goldenThreshold = std::stof(argv[++i]);
+            else if (arg == "--llvmpipe")
+                options.llvmpipe = true;
+            else
+                return std::nullopt;
+        }
+    }
+    catch (const std::exception&)
+    {
+        return std::nullopt;
+    }
+    return options;
+}
+
+// Forces Mesa's software rasterizer with a fixed number of threads, must run before the GL context is created
+void useLlvmpipe()
+{
+#if VGFW_PLATFORM_LINUX
+    setenv("LIBGL_ALWAYS_SOFTWARE", "1", 1);
+    setenv("GALLIUM_DRIVER", "llvmpipe", 1);
+    setenv("LP_NUM_THREADS", "4", 0);
+#else
+    VGFW_WARN("[SponzaBenchmark] --llvmpipe is only supported on Linux");
+#endif
+}
+
+struct CameraKey
+{
+    glm::vec3 position;
+    float     yaw;
+    float     pitch;
+};
+
+// Down the nave, around the far end and back along the upper gallery
+constexpr std::array kCameraPath {
+    CameraKey {{-1150.0f, 200.0f, -45.0f}, 90.0f, 0.0f},
+    CameraKey {{-300.0f, 250.0f, -45.0f}, 90.0f, -5.0f},
+    CameraKey {{600.0f, 300.0f, -45.0f}, 110.0f, -10.0f},
+    CameraKey {{1100.0f, 500.0f, 300.0f}, 200.0f, 10.0f},
+    CameraKey {{300.0f, 650.0f, 350.0f}, 270.0f, 15.0f},
+    CameraKey {{-700.0f, 500.0f, 0.0f}, 270.0f, 5.0f},
+    CameraKey {{-1150.0f, 200.0f, -45.0f}, 450.0f, 0.0f},
+};
+
+glm::vec3 catmullRom(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3, float t)
+{
+    const auto t2 = t * t;
+    const auto t3 = t2 * t;
+    return 0.5f * (2.0f * p1 + (p2 - p0) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
+                   (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+}
+
+// t in [0, 1]: a spline through the keys for the position, linear for the angles
+void placeCamera(Camera& camera, float t, const std::shared_ptr<vgfw::window::Window>& window)
+{
+    const auto numSegments = static_cast<int>(kCameraPath.size()) - 1;
+    const auto position    = std::clamp(t, 0.0f, 1.0f) * numSegments;
+    const auto segment     = std::min(static_cast<int>(position), numSegments - 1);
+    const auto s           = position - segment;
+
+    const auto& key = [&](int i) -> const CameraKey& { return kCameraPath[std::clamp(i, 0, numSegments)]; };
+
+    camera.data.position = catmullRom(
+        key(segment - 1).position, key(segment).position, key(segment + 1).position, key(segment + 2).position, s);
+    camera.yaw   = glm::mix(key(segment).yaw, key(segment + 1).yaw, s);
+    camera.pitch = glm::mix(key(segment).pitch, key(segment + 1).pitch, s);
+    camera.updateData(window);
+}
+
+struct PassTimings
+{
+    std::string name;
+    uint32_t    numSamples {0};
+    double      cpuMs {0.0};
+    double      gpuMs {0.0};
+};
+
+struct GoldenResult
+{
+    uint32_t frameIndex {0};
+    double   rmse {0.0};
+    bool     created {false};
+    bool     passed {false};
+};
+
+// Root mean square error over the RGB channels, in 8-bit units
+double computeRmse(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b)
+{
+    double sum {0.0};
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (i % 4 == 3)
+            continue;
+        const double d = static_cast<double>(a[i]) - static_cast<double>(b[i]);
+        sum += d * d;
+    }
+    return std::sqrt(sum / (a.size() / 4 * 3));
+}
+
+GoldenResult compareGolden(const std::filesystem::path&   directory,
+                           uint32_t                       frameIndex,
+                           const std::vector<uint8_t>&    pixels,
+                           const vgfw::renderer::Extent2D extent,
+                           float                          threshold)
+{
+    GoldenResult result {.frameIndex = frameIndex};
+
+    // GL rows start at the bottom
+    stbi_set_flip_vertically_on_load_thread(true);
+    stbi_flip_vertically_on_write(1);
+
+    const auto goldenPath = directory / fmt::format("frame_{0:05}.png", frameIndex);
+    int        width {0}, height {0}, numChannels {0};
+    auto*      golden = stbi_load(goldenPath.generic_string().c_str(), &width, &height, &numChannels, 4);
+
+    if (!golden)
+    {
+        std::filesystem::create_directories(directory);
+        stbi_write_png(goldenPath.generic_string().c_str(), extent.width, extent.height, 4, pixels.data(), 0);
+        result.created = result.passed = true;
+        VGFW_INFO("[SponzaBenchmark] Created golden image: {0}", goldenPath.generic_string());
+        return result;
+    }
+
+    if (width == static_cast<int>(extent.width) && height == static_cast<int>(extent.height))
+    {
+        const std::vector<uint8_t> expected(golden, golden + pixels.size());
+
+        result.rmse   = computeRmse(pixels, expected);
+        result.passed = result.rmse <= threshold;
+    }
+    else
+    {
+        result.rmse = std::numeric_limits<double>::infinity();
+        VGFW_ERROR("[SponzaBenchmark] Golden image size mismatch: {0}", goldenPath.generic_string());
+    }
+    stbi_image_free(golden);
+
+    if (!result.passed)
+    {
+        const auto diffPath = directory / fmt::format("frame_{0:05}_actual.png", frameIndex);
+        stbi_write_png(diffPath.generic_string().c_str(), extent.width, extent.height, 4, pixels.data(), 0);
+        VGFW_ERROR("[SponzaBenchmark] Frame {0} differs from the golden image (RMSE {1:.3f}), wrote {2}",
+                   frameIndex,
+                   result.rmse,
+                   diffPath.generic_string());
+    }
+    return result;
+}
+
+std::string makeSummaryJson(const BenchmarkOptions&          options,
+                            const std::vector<PassTimings>&  passes,
+                            const std::vector<GoldenResult>& goldenResults)
+{
+    std::string json = fmt::format("{{\"renderer\":\"{0}\",\"width\":{1},\"height\":{2},\"warmup_frames\":{3},",
+                                   vgfw::utils::escapeJson(reinterpret_cast<const char*>(glGetString(GL_RENDERER))),
+                                   options.width,
+                                   options.height,
+                                   options.numWarmupFrames);
+
+    json += fmt::format("\"frames\":{0},\"passes\":[", vgfw::renderer::getFrameStatsRecorder().exportJson());
+    for (size_t i = 0; i < passes.size(); ++i)
+    {
+        const auto& pass = passes[i];
+        json += fmt::format("{0}{{\"name\":\"{1}\",\"samples\":{2},\"cpu_ms\":{3:.4f},\"gpu_ms\":{4:.4f}}}",
+                            i > 0 ? "," : "",
+                            vgfw::utils::escapeJson(pass.name),
+                            pass.numSamples,
+                            pass.cpuMs / std::max(pass.numSamples, 1u),
+                            pass.gpuMs / std::max(pass.numSamples, 1u));
+    }
+
+    json += "],\"golden\":[";
+    for (size_t i = 0; i < goldenResults.size(); ++i)
+    {
+        const auto& result = goldenResults[i];
+        json += fmt::format("{0}{{\"frame\":{1},\"rmse\":{2:.4f},\"created\":{3},\"passed\":{4}}}",
+                            i > 0 ? "," : "",
+                            result.frameIndex,
+                            std::isfinite(result.rmse) ? result.rmse : -1.0,
+                            result.created,
+                            result.passed);
+    }
+    json += fmt::format("],\"load\":{0}}}", vgfw::io::exportLoadReportsJson());
+    return json;
+}
+
+int main(int argc, char** argv)
+{
+    const auto options = parseOptions(argc, argv);
+    if (!options)
+    {
+        std::cerr << "Usage: 07-sponza-benchmark [--frames N] [--warmup N] [--width W] [--height H] "
+                     "[--out summary.json] [--golden dir] [--golden-threshold rmse] [--llvmpipe]"
+                  << std::endl;
+        return -1;
+    }
+
+    if (options->llvmpipe)
+        useLlvmpipe();
+
+    // Init VGFW
+    if (!vgfw::init())
+    {
+        std::cerr << "Failed to initialize VGFW" << std::endl;
+        return -1;
+    }
+
+    // Create a hidden window of the benchmark resolution
+    auto window = vgfw::window::create({
+        .title     = "07-sponza-benchmark",
+        .width     = options->width,
+        .height    = options->height,
+        .isVisible = false,
+    });
+
+    // Init renderer, no frame pacing so that the frame times are the rendering cost only
+    vgfw::renderer::init({.window = window, .enableGpuProfiler = true});
+
+    // Init job system, texture decoding is spread across the workers
+    vgfw::jobs::init();
+
+    // Get render context
+    auto& rc = vgfw::renderer::getRenderContext();
+
+    // Create transient resources
+    vgfw::renderer::framegraph::TransientResources transientResources(rc);
+
+    // Load model
+    vgfw::resource::Model sponza {};
+    if (!vgfw::io::loadModel("assets/models/Sponza/glTF/Sponza.gltf", sponza, rc))
+    {
+        return -1;
+    }
+
+    DirectionalLight light {};
+    Camera           camera {};
+
+    // Define render passes
+    GBufferPass          gBufferPass(rc);
+    DeferredLightingPass deferredLightingPass(rc);
+    TonemappingPass      tonemappingPass(rc);
+    FinalCompositionPass finalCompositionPass(rc);
+
+    const vgfw::renderer::Extent2D resolution {.width = options->width, .height = options->height};
+
+    // Transient resources age by a fixed step, not by the measured frame time
+    constexpr float kFixedDt {1.0f / 60.0f};
+
+    const auto renderFrame = [&](uint32_t frameIndex, std::vector<uint8_t>* readback) {
+        VGFW_PROFILE_NAMED_SCOPE("Benchmark Frame");
+
+        window->onTick();
+
+        placeCamera(camera, static_cast<float>(frameIndex) / std::max(options->numFrames - 1, 1u), window);
+
+        FrameGraph           fg;
+        FrameGraphBlackboard blackboard;
+
+        uploadCameraUniform(fg, blackboard, camera.data);
+        uploadLightUniform(fg, blackboard, light);
+
+        gBufferPass.addToGraph(fg, blackboard, resolution, sponza.meshPrimitives);
+
+        auto& sceneColor = blackboard.add<SceneColorData>();
+        sceneColor.hdr   = deferredLightingPass.addToGraph(fg, blackboard);
+        sceneColor.ldr   = tonemappingPass.addToGraph(fg, sceneColor.hdr);
+
+        finalCompositionPass.compose(fg, blackboard, RenderTarget::eFinal);
+
+        // Golden images are read from the tone-mapped texture, the default framebuffer of a hidden window is not
+        // guaranteed to be rendered to
+        if (readback)
+        {
+            const auto ldr = sceneColor.ldr;
+            fg.addCallbackPass(
+                "Readback Pass",
+                [&](FrameGraph::Builder& builder, auto&) {
+                    builder.read(ldr);
+                    builder.setSideEffect();
+                },
+                [=](const auto&, FrameGraphPassResources& resources, void*) {
+                    auto&      texture = vgfw::renderer::framegraph::getTexture(resources, ldr);
+                    const auto extent  = texture.getExtent();
+                    readback->resize(extent.width * extent.height * 4);
+                    vgfw::renderer::RenderContext::download(texture,
+                                                            0,
+                                                            GL_RGBA,
+                                                            GL_UNSIGNED_BYTE,
+                                                            static_cast<GLsizei>(readback->size()),
+                                                            readback->data());
+                });
+        }
+
+        fg.compile();
+
+        vgfw::renderer::beginFrame();
+
+        fg.execute(&rc, &transientResources);
+
+        transientResources.update(kFixedDt);
+
+        vgfw::renderer::endFrame();
+
+        vgfw::renderer::present();
+    };
+
+    // Warm-up: shader compilation, transient resource pools and driver caches settle down
+    for (uint32_t i = 0; i < options->numWarmupFrames; ++i)
+        renderFrame(i % options->numFrames, nullptr);
+
+    // Timed run, the GPU profiler results lag a few frames and are accumulated as they arrive
+    auto& frameStatsRecorder = vgfw::renderer::getFrameStatsRecorder();
+    frameStatsRecorder.init(options->numFrames);
+
+    const auto& gpuProfiler = vgfw::renderer::getGpuProfiler();
+    const auto  firstFrame  = gpuProfiler.getResultsFrameIndex() + vgfw::renderer::GpuProfiler::kNumFrames;
+    auto        lastResults = gpuProfiler.getResultsFrameIndex();
+
+    std::vector<PassTimings> passes;
+    for (uint32_t i = 0; i < options->numFrames; ++i)
+    {
+        renderFrame(i, nullptr);
+
+        if (gpuProfiler.getResultsFrameIndex() == lastResults || gpuProfiler.getResultsFrameIndex() < firstFrame)
+            continue;
+        lastResults = gpuProfiler.getResultsFrameIndex();
+
+        for (const auto& result : gpuProfiler.getResults())
+        {
+            auto it = std::find_if(
+                passes.begin(), passes.end(), [&](const PassTimings& pass) { return pass.name == result.name; });
+            if (it == passes.end())
+                it = passes.insert(passes.end(), PassTimings {.name = result.name});
+
+            ++it->numSamples;
+            it->cpuMs += result.cpuDurationMs;
+            it->gpuMs += result.durationMs;
+        }
+    }
+
+    const auto report = frameStatsRecorder.getReport();
+    VGFW_INFO("[SponzaBenchmark] {0} frames: p50 {1:.3f} ms, p95 {2:.3f} ms, p99 {3:.3f} ms (CPU p50 {4:.3f} ms, "
+              "GPU p50 {5:.3f} ms)",
+              report.numFrames,
+              report.frame.p50,
+              report.frame.p95,
+              report.frame.p99,
+              report.cpu.p50,
+              report.gpu.p50);
+
+    // Golden images of a few frames along the path, rendered after the timed run so the readbacks do not stall it
+    std::vector<GoldenResult> goldenResults;
+    if (options->goldenDirectory)
+    {
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            const auto           frameIndex = (options->numFrames - 1) * i / 3;
+            std::vector<uint8_t> pixels;
+            renderFrame(frameIndex, &pixels);
+            goldenResults.push_back(
+                compareGolden(*options->goldenDirectory, frameIndex, pixels, resolution, options->goldenThreshold));
+        }
+    }
+
+    if (!vgfw::utils::writeFileAllText(options->summaryPath, makeSummaryJson(*options, passes, goldenResults)))
+        VGFW_ERROR("[SponzaBenchmark] Failed to write {0}", options->summaryPath.generic_string());
+    else
+        VGFW_INFO("[SponzaBenchmark] Wrote {0}", options->summaryPath.generic_string());
+
+    const bool passed = std::all_of(
+        goldenResults.cbegin(), goldenResults.cend(), [](const GoldenResult& result) { return result.passed; });
+
+    // Cleanup
+    vgfw::shutdown();
+
+    return passed ? 0 : 1;
+}
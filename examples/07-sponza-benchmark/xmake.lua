@@ -0,0 +1,32 @@
+-- target defination, name: 07-sponza-benchmark
+target("07-sponza-benchmark")
+    -- set target kind: executable
+    set_kind("binary")
+
+    -- reuse the passes of 06-deferred-framegraph
+    add_includedirs("../06-deferred-framegraph")
+
+    -- set values
+    set_values("asset_files", "assets/models/Sponza/**")
+    set_values("shader_root", "$(scriptdir)/../06-deferred-framegraph/shaders")
+
+    -- add rules
+    add_rules("copy_assets", "preprocess_shaders")
+
+    -- add source files
+    add_files("main.cpp")
+    add_files("../06-deferred-framegraph/camera.cpp")
+    add_files("../06-deferred-framegraph/passes/*.cpp")
+    add_files("../06-deferred-framegraph/uniforms/*.cpp")
+
+    -- add shaders
+    add_files("../06-deferred-framegraph/shaders/**")
+
+    -- add deps
+    add_deps("vgfw")
+
+    -- add packages
+    add_packages("shaderc")
+
+    -- set target directory
+    set_targetdir("$(buildir)/$(plat)/$(arch)/$(mode)/examples/07-sponza-benchmark")
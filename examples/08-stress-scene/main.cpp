@@ -0,0 +1,804 @@
+#define VGFW_IMPLEMENTATION
+#include "vgfw.hpp"
+
+#include <random>
+
+// Generates synthetic scenes of N instances from the bundled cube, spot and Suzanne meshes and measures how the CPU
+// submit time and the GPU time scale with N. Every instance picks one of M materials (a texture out of T and a tint)
+// and one of K meshes, each mesh having its own vertex format. The instances are stacked D layers deep with depth
+// writes off, so every pixel they cover is shaded D times. The scene depends on the options only (fixed seed), so runs
+// are comparable between machines and builds.
+//
+// Submit modes:
+//   immediate:   one RenderContext draw per instance, pipeline / texture / tint bound on change
+//   commandlist: the same commands recorded into CommandLists on the job system, then executed on the GL thread
+//   instanced:   one instanced draw per (mesh, material) batch, transforms read from the storage buffer of a
+//                vgfw::scene::Scene holding one root node per instance
+//
+// Usage: 08-stress-scene [--instances 1000,10000,...] [--materials M] [--formats K] [--textures T] [--overdraw D]
+//                        [--mode immediate|commandlist|instanced] [--sorted] [--frames N] [--warmup N]
+//                        [--width W] [--height H] [--out summary.json] [--llvmpipe]
+
+const char* kSceneVertexShaderSource = R"(
+#version 450
+
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec2 aTexCoords;
+
+layout(location = 0) out vec3 vNormal;
+layout(location = 1) out vec2 vTexCoords;
+
+layout(std430, binding = 0) readonly buffer InstanceBuffer
+{
+    mat4 instanceModels[];
+};
+
+uniform mat4 viewProjection;
+uniform mat4 model;
+uniform int  instanced;
+uniform uint firstInstance;
+
+void main()
+{
+    const mat4 m = instanced != 0 ? instanceModels[firstInstance + gl_InstanceID] : model;
+    gl_Position  = viewProjection * m * vec4(aPos, 1.0);
+    vNormal      = mat3(m) * aNormal;
+    vTexCoords   = aTexCoords;
+}
+)";
+
+const char* kSceneFragmentShaderSource = R"(
+#version 450
+
+layout(location = 0) in vec3 vNormal;
+layout(location = 1) in vec2 vTexCoords;
+
+layout(location = 0) out vec4 FragColor;
+
+layout(binding = 0) uniform sampler2D albedo;
+
+uniform vec4 tint;
+
+void main()
+{
+    const float diffuse = max(dot(normalize(vNormal), normalize(vec3(0.3, 0.5, 1.0))), 0.0) * 0.8 + 0.2;
+    FragColor = vec4(texture(albedo, vTexCoords).rgb * tint.rgb * diffuse, 1.0);
+}
+)";
+
+const char* kPresentVertexShaderSource = R"(
+#version 450
+
+layout(location = 0) out vec2 vTexCoords;
+
+void main()
+{
+    vTexCoords  = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(vTexCoords * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+const char* kPresentFragmentShaderSource = R"(
+#version 450
+
+layout(location = 0) in vec2 vTexCoords;
+
+layout(location = 0) out vec4 FragColor;
+
+layout(binding = 0) uniform sampler2D sceneColor;
+
+void main() { FragColor = texture(sceneColor, vTexCoords); }
+)";
+
+enum class SubmitMode
+{
+    eImmediate,
+    eCommandList,
+    eInstanced,
+};
+
+const char* toString(SubmitMode mode)
+{
+    switch (mode)
+    {
+        case SubmitMode::eCommandList:
+            return "commandlist";
+        case SubmitMode::eInstanced:
+            return "instanced";
+        default:
+            return "immediate";
+    }
+}
+
+struct StressOptions
+{
+    std::vector<uint32_t> instanceCounts {1000, 10000, 100000, 1000000};
+    uint32_t              numMaterials {64};
+    uint32_t              numVertexFormats {3};
+    uint32_t              numTextures {16};
+    uint32_t              overdraw {1};
+    SubmitMode            mode {SubmitMode::eImmediate};
+    bool                  sorted {false}; // Sorted by state instead of shuffled, instanced mode always sorts
+    uint32_t              numFrames {30};
+    uint32_t              numWarmupFrames {5};
+    uint32_t              width {1280};
+    uint32_t              height {720};
+    std::filesystem::path summaryPath {"StressScene.json"};
+    bool                  llvmpipe {false};
+};
+
+std::optional<StressOptions> parseOptions(int argc, char** argv)
+{
+    StressOptions options {};
+
+    // Malformed numbers (std::stoi throws) fall back to the usage message
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg {argv[i]};
+            const bool             hasValue = i + 1 < argc;
+
+            if (arg == "--instances" && hasValue)
+            {
+                options.instanceCounts.clear();
+                std::stringstream stream {argv[++i]};
+                for (std::string count; std::getline(stream, count, ',');)
+                    options.instanceCounts.push_back(std::max(std::stoi(count), 1));
+                if (options.instanceCounts.empty())
+                    return std::nullopt;
+            }
+            else if (arg == "--materials" && hasValue)
+                options.numMaterials = std::max(std::stoi(argv[++i]), 1);
+            else if (arg == "--formats" && hasValue)
+                options.numVertexFormats = std::clamp(std::stoi(argv[++i]), 1, 3);
+            else if (arg == "--textures" && hasValue)
+                options.numTextures = std::max(std::stoi(argv[++i]), 1);
+            else if (arg == "--overdraw" && hasValue)
+                options.overdraw = std::max(std::stoi(argv[++i]), 1);
+            else if (arg == "--mode" && hasValue)
+            {
+                const std::string_view mode {argv[++i]};
+                if (mode == "immediate")
+                    options.mode = SubmitMode::eImmediate;
+                else if (mode == "commandlist")
+                    options.mode = SubmitMode::eCommandList;
+                else if (mode == "instanced")
+                    options.mode = SubmitMode::eInstanced;
+                else
+                    return std::nullopt;
+            }
+            else if (arg == "--sorted")
+                options.sorted = true;
+            else if (arg == "--frames" && hasValue)
+                options.numFrames = std::max(std::stoi(argv[++i]), 1);
+            else if (arg == "--warmup" && hasValue)
+                options.numWarmupFrames = std::max(std::stoi(argv[++i]), 0);
+            else if (arg == "--width" && hasValue)
+                options.width = std::max(std::stoi(argv[++i]), 1);
+            else if (arg == "--height" && hasValue)
+                options.height = std::max(std::stoi(argv[++i]), 1);
+            else if (arg == "--out" && hasValue)
+                options.summaryPath = argv[++i];
+            else if (arg == "--llvmpipe")
+                options.llvmpipe = true;
+            else
+                return std::nullopt;
+        }
+    }
+    catch (const std::exception&)
+    {
+        return std::nullopt;
+    }
+    return options;
+}
+
+// Forces Mesa's software rasterizer with a fixed number of threads, must run before the GL context is created
+void useLlvmpipe()
+{
+#if VGFW_PLATFORM_LINUX
+    setenv("LIBGL_ALWAYS_SOFTWARE", "1", 1);
+    setenv("GALLIUM_DRIVER", "llvmpipe", 1);
+    setenv("LP_NUM_THREADS", "4", 0);
+#else
+    VGFW_WARN("[StressScene] --llvmpipe is only supported on Linux");
+#endif
+}
+
+// Unit cube with per-face normals, a vertex format (position, normal) of its own
+bool buildCube(vgfw::resource::Model& model, vgfw::renderer::RenderContext& rc)
+{
+    constexpr std::array<glm::vec3, 6> kNormals {{
+        {1.0f, 0.0f, 0.0f},
+        {-1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, -1.0f},
+    }};
+    constexpr std::array<glm::vec2, 4> kCorners {{{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}}};
+
+    auto& meshPrimitive = model.addMeshPrimitive();
+    meshPrimitive.name  = "Cube";
+
+    for (const auto& normal : kNormals)
+    {
+        // u x v == normal, so the corners are counter-clockwise seen from outside
+        const glm::vec3 u {normal.y, normal.z, normal.x};
+        const glm::vec3 v = glm::cross(normal, u);
+
+        const auto base = static_cast<uint32_t>(meshPrimitive.record.positions.size());
+        for (const auto& corner : kCorners)
+        {
+            meshPrimitive.record.positions.push_back(0.5f * (normal + corner.x * u + corner.y * v));
+            meshPrimitive.record.normals.push_back(normal);
+        }
+        meshPrimitive.indices.insert(meshPrimitive.indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+    meshPrimitive.vertexCount = static_cast<uint32_t>(meshPrimitive.record.positions.size());
+
+    auto vertexFormatBuilder = vgfw::renderer::VertexFormat::Builder {};
+    vertexFormatBuilder
+        .setAttribute(vgfw::renderer::AttributeLocation::ePosition,
+                      {.vertType = vgfw::renderer::VertexAttribute::Type::eFloat3, .offset = 0})
+        .setAttribute(vgfw::renderer::AttributeLocation::eNormal_Color,
+                      {.vertType = vgfw::renderer::VertexAttribute::Type::eFloat3, .offset = sizeof(float) * 3});
+
+    meshPrimitive.ownerModel        = &model;
+    meshPrimitive.indexInOwnerModel = 0;
+    meshPrimitive.build(vertexFormatBuilder, glm::vec3 {1.0f}, rc);
+
+    return true;
+}
+
+// 64x64 two-color checkerboard, the colors derived from the index
+vgfw::renderer::Texture createCheckerTexture(vgfw::renderer::RenderContext& rc, uint32_t index)
+{
+    constexpr uint32_t kSize {64};
+    constexpr uint32_t kCellSize {8};
+
+    std::minstd_rand random {index + 1};
+    const auto       randomColor = [&] { return static_cast<uint32_t>(0xFF000000u | (random() & 0x00FFFFFFu)); };
+    const uint32_t   colors[2] {randomColor(), randomColor()};
+
+    std::vector<uint32_t> pixels(kSize * kSize);
+    for (uint32_t y = 0; y < kSize; ++y)
+    {
+        for (uint32_t x = 0; x < kSize; ++x)
+            pixels[y * kSize + x] = colors[((x / kCellSize) + (y / kCellSize)) % 2];
+    }
+
+    auto texture = rc.createTexture2D({kSize, kSize}, vgfw::renderer::PixelFormat::eRGBA8_UNorm);
+    rc.upload(texture, 0, {kSize, kSize}, {.format = GL_RGBA, .dataType = GL_UNSIGNED_BYTE, .pixels = pixels.data()})
+        .setupSampler(texture,
+                      {
+                          .minFilter = vgfw::renderer::TexelFilter::eLinear,
+                          .magFilter = vgfw::renderer::TexelFilter::eLinear,
+                      });
+    return texture;
+}
+
+struct Material
+{
+    uint32_t  textureIndex {0};
+    glm::vec4 tint {1.0f};
+};
+
+struct Instance
+{
+    uint32_t               meshIndex {0};
+    uint32_t               materialIndex {0};
+    vgfw::scene::Transform transform {};
+    glm::mat4              model {1.0f};
+};
+
+// A run of instances sharing mesh and material, drawn with one instanced draw
+struct Batch
+{
+    uint32_t meshIndex {0};
+    uint32_t materialIndex {0};
+    uint32_t firstInstance {0};
+    uint32_t numInstances {0};
+};
+
+struct StressScene
+{
+    std::vector<Instance> instances;
+    std::vector<Batch>    batches;
+    glm::mat4             viewProjection {1.0f};
+
+    vgfw::scene::Scene transforms; // Instanced mode only, draw i is instance i
+};
+
+// Instances fill a grid that covers the viewport, cell i / D holds the D layers of instances i..i+D-1
+StressScene generateScene(const StressOptions&                                     options,
+                          uint32_t                                                 numInstances,
+                          const std::vector<const vgfw::resource::MeshPrimitive*>& meshes)
+{
+    StressScene scene {};
+    scene.instances.resize(numInstances);
+
+    const auto aspect   = static_cast<float>(options.width) / static_cast<float>(options.height);
+    const auto numCells = (numInstances + options.overdraw - 1) / options.overdraw;
+    const auto columns  = std::max(static_cast<uint32_t>(std::ceil(std::sqrt(numCells * aspect))), 1u);
+    const auto rows     = (numCells + columns - 1) / columns;
+
+    std::mt19937                          random {42};
+    std::uniform_real_distribution<float> angle {0.0f, glm::radians(360.0f)};
+
+    for (uint32_t i = 0; i < numInstances; ++i)
+    {
+        auto& instance         = scene.instances[i];
+        instance.meshIndex     = random() % static_cast<uint32_t>(meshes.size());
+        instance.materialIndex = random() % options.numMaterials;
+
+        // Fit the mesh into the cell, rotated around its center
+        const auto& aabb     = meshes[instance.meshIndex]->aabb;
+        const auto  scale    = 0.9f / vgfw::math::max3(aabb.getExtent());
+        const auto  cell     = i / options.overdraw;
+        const auto  layer    = i % options.overdraw;
+        const auto  rotation = glm::angleAxis(angle(random), glm::normalize(glm::vec3 {0.3f, 1.0f, 0.2f}));
+        const auto  center   = glm::vec3 {
+            (cell % columns) + 0.5f, (cell / columns) + 0.5f, -static_cast<float>(layer) / options.overdraw};
+
+        instance.transform = {
+            .translation = center - rotation * (scale * aabb.getCenter()),
+            .rotation    = rotation,
+            .scale       = glm::vec3 {scale},
+        };
+        instance.model = instance.transform.toMatrix();
+    }
+
+    if (options.sorted || options.mode == SubmitMode::eInstanced)
+    {
+        std::stable_sort(scene.instances.begin(), scene.instances.end(), [](const Instance& a, const Instance& b) {
+            return std::tie(a.meshIndex, a.materialIndex) < std::tie(b.meshIndex, b.materialIndex);
+        });
+    }
+
+    if (options.mode == SubmitMode::eInstanced)
+    {
+        // Root nodes created in order are drawn in order, so the batches are contiguous ranges of draws
+        std::vector<vgfw::scene::NodeHandle> nodes(numInstances);
+        for (uint32_t i = 0; i < numInstances; ++i)
+        {
+            const auto& instance = scene.instances[i];
+            nodes[i]             = scene.transforms.createNode({}, instance.transform, meshes[instance.meshIndex]);
+        }
+        scene.transforms.update();
+
+        for (uint32_t i = 0; i < numInstances; ++i)
+        {
+            const auto& instance = scene.instances[i];
+            if (scene.batches.empty() || scene.batches.back().meshIndex != instance.meshIndex ||
+                scene.batches.back().materialIndex != instance.materialIndex)
+            {
+                scene.batches.push_back({
+                    .meshIndex     = instance.meshIndex,
+                    .materialIndex = instance.materialIndex,
+                    .firstInstance = scene.transforms.getDrawIndex(nodes[i]),
+                });
+            }
+            assert(scene.transforms.getDrawIndex(nodes[i]) ==
+                   scene.batches.back().firstInstance + scene.batches.back().numInstances);
+            ++scene.batches.back().numInstances;
+        }
+    }
+
+    // Orthographic view of the grid, the layers spread over z in (-1, 0]
+    scene.viewProjection = glm::ortho(0.0f,
+                                      static_cast<float>(columns),
+                                      0.0f,
+                                      static_cast<float>(std::max(rows, 1u)),
+                                      -2.0f,
+                                      2.0f);
+
+    return scene;
+}
+
+struct StepResult
+{
+    uint32_t numInstances {0};
+    uint32_t numDrawCalls {0};
+
+    std::vector<double> submitMs {}; // CPU time of the stress pass, recording included
+    std::vector<double> gpuMs {};
+
+    vgfw::renderer::FrameStatsReport frames {};
+    vgfw::renderer::RenderStats      renderStats {};
+};
+
+double percentile(std::vector<double> values, double p)
+{
+    if (values.empty())
+        return 0.0;
+
+    std::sort(values.begin(), values.end());
+    return values[static_cast<size_t>(p * (values.size() - 1) + 0.5)];
+}
+
+std::string makeSummaryJson(const StressOptions& options, const std::vector<StepResult>& steps)
+{
+    std::string json = fmt::format("{{\"renderer\":\"{0}\",\"mode\":\"{1}\",\"sorted\":{2},\"materials\":{3},"
+                                   "\"formats\":{4},\"textures\":{5},\"overdraw\":{6},\"width\":{7},\"height\":{8},"
+                                   "\"frames\":{9},\"steps\":[",
+                                   vgfw::utils::escapeJson(reinterpret_cast<const char*>(glGetString(GL_RENDERER))),
+                                   toString(options.mode),
+                                   options.sorted || options.mode == SubmitMode::eInstanced,
+                                   options.numMaterials,
+                                   options.numVertexFormats,
+                                   options.numTextures,
+                                   options.overdraw,
+                                   options.width,
+                                   options.height,
+                                   options.numFrames);
+
+    const auto summaryOf = [](const std::vector<double>& values) {
+        const auto mean =
+            values.empty() ? 0.0 : std::accumulate(values.cbegin(), values.cend(), 0.0) / values.size();
+        return fmt::format("{{\"mean\":{0:.4f},\"p50\":{1:.4f},\"p95\":{2:.4f},\"max\":{3:.4f}}}",
+                           mean,
+                           percentile(values, 0.5),
+                           percentile(values, 0.95),
+                           percentile(values, 1.0));
+    };
+
+    for (size_t i = 0; i < steps.size(); ++i)
+    {
+        const auto& step = steps[i];
+        json += fmt::format("{0}{{\"instances\":{1},\"draw_calls\":{2},\"submit_ms\":{3},\"gpu_ms\":{4},"
+                            "\"frame_ms_p50\":{5:.4f},\"pipeline_binds\":{6},\"texture_binds\":{7},"
+                            "\"redundant_binds_skipped\":{8}}}",
+                            i > 0 ? "," : "",
+                            step.numInstances,
+                            step.numDrawCalls,
+                            summaryOf(step.submitMs),
+                            summaryOf(step.gpuMs),
+                            step.frames.frame.p50,
+                            step.renderStats.pipelineBinds,
+                            step.renderStats.textureBinds,
+                            step.renderStats.redundantBindsSkipped);
+    }
+    json += "]}";
+    return json;
+}
+
+int main(int argc, char** argv)
+{
+    const auto options = parseOptions(argc, argv);
+    if (!options)
+    {
+        std::cerr << "Usage: 08-stress-scene [--instances 1000,10000,...] [--materials M] [--formats K] "
+                     "[--textures T] [--overdraw D] [--mode immediate|commandlist|instanced] [--sorted] "
+                     "[--frames N] [--warmup N] [--width W] [--height H] [--out summary.json] [--llvmpipe]"
+                  << std::endl;
+        return -1;
+    }
+
+    if (options->llvmpipe)
+        useLlvmpipe();
+
+    // Init VGFW
+    if (!vgfw::init())
+    {
+        std::cerr << "Failed to initialize VGFW" << std::endl;
+        return -1;
+    }
+
+    // Create a hidden window of the benchmark resolution
+    auto window = vgfw::window::create({
+        .title     = "08-stress-scene",
+        .width     = options->width,
+        .height    = options->height,
+        .isVisible = false,
+    });
+
+    // Init renderer, no frame pacing so that the frame times are the rendering cost only
+    vgfw::renderer::init({.window = window, .enableGpuProfiler = true});
+
+    // Init job system, command lists are recorded on the workers
+    vgfw::jobs::init();
+
+    // Get render context
+    auto& rc = vgfw::renderer::getRenderContext();
+
+    // Create transient resources
+    vgfw::renderer::framegraph::TransientResources transientResources(rc);
+
+    // Meshes: one vertex format each
+    vgfw::resource::Model cube {};
+    vgfw::resource::Model spot {};
+    vgfw::resource::Model suzanne {};
+    if (!buildCube(cube, rc) || !vgfw::io::loadModel("assets/models/spot/spot.obj", spot, rc) ||
+        !vgfw::io::loadModel("assets/models/Suzanne/Suzanne.gltf", suzanne, rc))
+    {
+        return -1;
+    }
+
+    const std::array<const vgfw::resource::MeshPrimitive*, 3> kAllMeshes {
+        &cube.meshPrimitives[0], &spot.meshPrimitives[0], &suzanne.meshPrimitives[0]};
+    const std::vector<const vgfw::resource::MeshPrimitive*> meshes(kAllMeshes.cbegin(),
+                                                                   kAllMeshes.cbegin() + options->numVertexFormats);
+
+    // Textures & materials
+    std::vector<vgfw::renderer::Texture> textures;
+    for (uint32_t i = 0; i < options->numTextures; ++i)
+        textures.push_back(createCheckerTexture(rc, i));
+
+    std::vector<Material> materials(options->numMaterials);
+    {
+        std::mt19937                          random {7};
+        std::uniform_real_distribution<float> channel {0.3f, 1.0f};
+        for (uint32_t i = 0; i < options->numMaterials; ++i)
+        {
+            materials[i] = {
+                .textureIndex = i % options->numTextures,
+                .tint         = {channel(random), channel(random), channel(random), 1.0f},
+            };
+        }
+    }
+
+    // Pipelines: one per vertex format, depth writes off so that the layers overdraw
+    std::vector<vgfw::renderer::GraphicsPipeline> pipelines;
+    for (const auto* mesh : meshes)
+    {
+        pipelines.push_back(vgfw::renderer::GraphicsPipeline::Builder {}
+                                .setDepthStencil({
+                                    .depthTest      = true,
+                                    .depthWrite     = false,
+                                    .depthCompareOp = vgfw::renderer::CompareOp::eLessOrEqual,
+                                })
+                                .setRasterizerState({
+                                    .polygonMode = vgfw::renderer::PolygonMode::eFill,
+                                    .cullMode    = vgfw::renderer::CullMode::eBack,
+                                    .scissorTest = false,
+                                })
+                                .setVAO(rc.getVertexArray(*mesh->vertexFormat))
+                                .setShaderProgram(rc.createGraphicsProgram(kSceneVertexShaderSource,
+                                                                           kSceneFragmentShaderSource))
+                                .build());
+    }
+
+    auto presentPipeline =
+        vgfw::renderer::GraphicsPipeline::Builder {}
+            .setShaderProgram(rc.createGraphicsProgram(kPresentVertexShaderSource, kPresentFragmentShaderSource))
+            .setDepthStencil({
+                .depthTest  = false,
+                .depthWrite = false,
+            })
+            .setRasterizerState({
+                .polygonMode = vgfw::renderer::PolygonMode::eFill,
+                .cullMode    = vgfw::renderer::CullMode::eBack,
+                .scissorTest = false,
+            })
+            .build();
+
+    const vgfw::renderer::Extent2D resolution {.width = options->width, .height = options->height};
+
+    // Command lists: one per job chunk, reused across frames
+    constexpr uint32_t                       kCommandListGrainSize {4096};
+    std::vector<vgfw::renderer::CommandList> commandLists;
+
+    // Records the commands of instances [begin, end), binding state only when it changes
+    const auto recordInstances = [&](auto& target, const StressScene& scene, uint32_t begin, uint32_t end) {
+        uint32_t lastMesh {~0u};
+        uint32_t lastMaterial {~0u};
+        for (auto i = begin; i < end; ++i)
+        {
+            const auto& instance = scene.instances[i];
+            if (instance.meshIndex != lastMesh)
+            {
+                target.bindGraphicsPipeline(pipelines[instance.meshIndex])
+                    .setUniformMat4("viewProjection", scene.viewProjection)
+                    .setUniform1i("instanced", 0);
+                lastMesh     = instance.meshIndex;
+                lastMaterial = ~0u;
+            }
+            if (instance.materialIndex != lastMaterial)
+            {
+                const auto& material = materials[instance.materialIndex];
+                target.bindTexture(0, textures[material.textureIndex]).setUniformVec4("tint", material.tint);
+                lastMaterial = instance.materialIndex;
+            }
+            target.setUniformMat4("model", instance.model).drawMeshPrimitive(*meshes[instance.meshIndex]);
+        }
+    };
+
+    const auto submitScene = [&](StressScene& scene) {
+        const auto numInstances = static_cast<uint32_t>(scene.instances.size());
+        switch (options->mode)
+        {
+            case SubmitMode::eImmediate:
+                recordInstances(rc, scene, 0, numInstances);
+                break;
+
+            case SubmitMode::eCommandList:
+                commandLists.resize(vgfw::jobs::getNumChunks(numInstances, kCommandListGrainSize));
+                vgfw::jobs::parallelFor(numInstances, kCommandListGrainSize, [&](uint32_t begin, uint32_t end) {
+                    auto& commandList = commandLists[begin / kCommandListGrainSize];
+                    commandList.reset();
+                    recordInstances(commandList, scene, begin, end);
+                });
+                for (const auto& commandList : commandLists)
+                    rc.execute(commandList);
+                break;
+
+            case SubmitMode::eInstanced:
+                // Static instances: the upload only happens until every buffer of the ring holds the transforms
+                rc.bindStorageBuffer(0, scene.transforms.uploadTransforms(rc));
+                for (const auto& batch : scene.batches)
+                {
+                    const auto& mesh     = *meshes[batch.meshIndex];
+                    const auto& material = materials[batch.materialIndex];
+                    rc.bindGraphicsPipeline(pipelines[batch.meshIndex])
+                        .setUniformMat4("viewProjection", scene.viewProjection)
+                        .setUniform1i("instanced", 1)
+                        .setUniform1ui("firstInstance", batch.firstInstance)
+                        .bindTexture(0, textures[material.textureIndex])
+                        .setUniformVec4("tint", material.tint)
+                        .draw(*rc.get(mesh.vertexBuffer),
+                              *rc.get(mesh.indexBuffer),
+                              {
+                                  .topology    = vgfw::renderer::PrimitiveTopology::eTriangleList,
+                                  .numVertices = mesh.vertexCount,
+                                  .numIndices  = mesh.indexCount,
+                              },
+                              batch.numInstances);
+                }
+                break;
+        }
+    };
+
+    // Transient resources age by a fixed step, not by the measured frame time
+    constexpr float kFixedDt {1.0f / 60.0f};
+
+    double lastSubmitMs {0.0};
+
+    const auto renderFrame = [&](StressScene& scene) {
+        VGFW_PROFILE_NAMED_SCOPE("Stress Frame");
+
+        window->onTick();
+
+        struct StressData
+        {
+            FrameGraphResource color;
+            FrameGraphResource depth;
+        };
+
+        FrameGraph fg;
+
+        const auto& stressData = fg.addCallbackPass<StressData>(
+            "Stress Pass",
+            [&](FrameGraph::Builder& builder, StressData& data) {
+                data.color = builder.create<vgfw::renderer::framegraph::FrameGraphTexture>(
+                    "Scene Color", {.extent = resolution, .format = vgfw::renderer::PixelFormat::eRGBA8_UNorm});
+                data.color = builder.write(data.color);
+
+                data.depth = builder.create<vgfw::renderer::framegraph::FrameGraphTexture>(
+                    "Depth", {.extent = resolution, .format = vgfw::renderer::PixelFormat::eDepth32F});
+                data.depth = builder.write(data.depth);
+            },
+            [&](const StressData& data, FrameGraphPassResources& resources, void* ctx) {
+                NAMED_DEBUG_MARKER("Stress Pass");
+                VGFW_PROFILE_GL("Stress Pass");
+                VGFW_PROFILE_NAMED_SCOPE("Stress Pass");
+
+                auto& rc = *static_cast<vgfw::renderer::RenderContext*>(ctx);
+
+                const auto framebuffer = rc.beginRendering(vgfw::renderer::FrameRenderingInfo {
+                    {.extent = resolution},
+                    {
+                        {.image      = vgfw::renderer::framegraph::getTexture(resources, data.color),
+                         .clearValue = glm::vec4 {0.1f, 0.1f, 0.1f, 1.0f}},
+                    },
+                    vgfw::renderer::AttachmentInfo {
+                        .image = vgfw::renderer::framegraph::getTexture(resources, data.depth), .clearValue = 1.0f}});
+
+                const auto begin = vgfw::time::Clock::now();
+                submitScene(scene);
+                lastSubmitMs =
+                    std::chrono::duration<double, std::milli>(vgfw::time::Clock::now() - begin).count();
+
+                rc.endRendering(framebuffer);
+            });
+
+        const auto sceneColor = stressData.color;
+        fg.addCallbackPass(
+            "Present Pass",
+            [&](FrameGraph::Builder& builder, auto&) {
+                builder.read(sceneColor);
+                builder.setSideEffect();
+            },
+            [&](const auto&, FrameGraphPassResources& resources, void* ctx) {
+                NAMED_DEBUG_MARKER("Present Pass");
+                VGFW_PROFILE_GL("Present Pass");
+                VGFW_PROFILE_NAMED_SCOPE("Present Pass");
+
+                auto& rc = *static_cast<vgfw::renderer::RenderContext*>(ctx);
+                rc.beginRendering({.extent = resolution}, glm::vec4 {0.0f});
+                rc.bindGraphicsPipeline(presentPipeline)
+                    .bindTexture(0, vgfw::renderer::framegraph::getTexture(resources, sceneColor))
+                    .drawFullScreenTriangle();
+            });
+
+        fg.compile();
+
+        vgfw::renderer::beginFrame();
+
+        fg.execute(&rc, &transientResources);
+
+        transientResources.update(kFixedDt);
+
+        vgfw::renderer::endFrame();
+
+        vgfw::renderer::present();
+    };
+
+    auto&       frameStatsRecorder = vgfw::renderer::getFrameStatsRecorder();
+    const auto& gpuProfiler        = vgfw::renderer::getGpuProfiler();
+
+    std::vector<StepResult> steps;
+    for (const auto numInstances : options->instanceCounts)
+    {
+        auto scene = generateScene(*options, numInstances, meshes);
+
+        StepResult step {
+            .numInstances = numInstances,
+            .numDrawCalls = options->mode == SubmitMode::eInstanced ? static_cast<uint32_t>(scene.batches.size()) :
+                                                                      numInstances,
+        };
+
+        // Warm-up: shader variants, transient resource pools and driver caches settle down
+        for (uint32_t i = 0; i < options->numWarmupFrames; ++i)
+            renderFrame(scene);
+
+        // Timed run, the GPU profiler results lag a few frames and are collected as they arrive
+        frameStatsRecorder.init(options->numFrames);
+
+        const auto firstFrame  = gpuProfiler.getResultsFrameIndex() + vgfw::renderer::GpuProfiler::kNumFrames;
+        auto       lastResults = gpuProfiler.getResultsFrameIndex();
+        for (uint32_t i = 0; i < options->numFrames; ++i)
+        {
+            renderFrame(scene);
+            step.submitMs.push_back(lastSubmitMs);
+
+            if (gpuProfiler.getResultsFrameIndex() == lastResults || gpuProfiler.getResultsFrameIndex() < firstFrame)
+                continue;
+            lastResults = gpuProfiler.getResultsFrameIndex();
+
+            for (const auto& result : gpuProfiler.getResults())
+            {
+                if (result.name == "Stress Pass")
+                    step.gpuMs.push_back(result.durationMs);
+            }
+        }
+
+        step.frames      = frameStatsRecorder.getReport();
+        step.renderStats = rc.getFrameStats();
+
+        VGFW_INFO("[StressScene] {0} instances, {1} draws: submit p50 {2:.3f} ms, GPU p50 {3:.3f} ms",
+                  step.numInstances,
+                  step.numDrawCalls,
+                  percentile(step.submitMs, 0.5),
+                  percentile(step.gpuMs, 0.5));
+
+        steps.push_back(std::move(step));
+    }
+
+    if (!vgfw::utils::writeFileAllText(options->summaryPath, makeSummaryJson(*options, steps)))
+        VGFW_ERROR("[StressScene] Failed to write {0}", options->summaryPath.generic_string());
+    else
+        VGFW_INFO("[StressScene] Wrote {0}", options->summaryPath.generic_string());
+
+    // Cleanup
+    for (auto& texture : textures)
+        rc.destroy(texture);
+    for (auto& pipeline : pipelines)
+        rc.destroy(pipeline);
+    rc.destroy(presentPipeline);
+
+    vgfw::shutdown();
+
+    return 0;
+}
@@ -0,0 +1,22 @@
+-- target defination, name: 08-stress-scene
+target("08-stress-scene")
+    -- set target kind: executable
+    set_kind("binary")
+
+    -- set values
+    set_values("asset_files", "assets/models/spot/**", "assets/models/Suzanne/**")
+
+    -- add rules
+    add_rules("copy_assets")
+
+    -- add source files
+    add_files("main.cpp")
+
+    -- add deps
+    add_deps("vgfw")
+
+    -- add defines
+    add_defines("VGFW_ENABLE_RENDER_STATS")
+
+    -- set target directory
+    set_targetdir("$(buildir)/$(plat)/$(arch)/$(mode)/examples/08-stress-scene")
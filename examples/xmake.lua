@@ -4,4 +4,6 @@ includes("02-cube")
 includes("03-obj-model")
 includes("04-gltf-model")
 includes("05-pbr")
-includes("06-deferred-framegraph")
\ No newline at end of file
+includes("06-deferred-framegraph")
+includes("07-sponza-benchmark")
+includes("08-stress-scene")
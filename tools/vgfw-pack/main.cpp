@@ -0,0 +1,141 @@
+#define VGFW_IMPLEMENTATION
+#include "vgfw.hpp"
+
+// Packs loose asset files into a single archive that vgfw::vfs::mount can memory-map.
+// Entry paths are relative to --root (the working directory by default), which is where the pack is mounted later.
+//
+// Usage: vgfw-pack <output> <file or directory>... [--root dir] [--lz4] [--min-ratio R]
+
+struct PackOptions
+{
+    std::filesystem::path              outputPath;
+    std::vector<std::filesystem::path> inputPaths;
+    std::filesystem::path              rootPath {"."};
+    bool                               compress {false};
+    float                              minCompressionRatio {0.9f};
+};
+
+std::optional<PackOptions> parseOptions(int argc, char** argv)
+{
+    PackOptions options {};
+
+    // Malformed numbers (std::stof throws) fall back to the usage message
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg {argv[i]};
+            const bool             hasValue = i + 1 < argc;
+
+            if (arg == "--root" && hasValue)
+                options.rootPath = argv[++i];
+            else if (arg == "--lz4")
+                options.compress = true;
+            else if (arg == "--min-ratio" && hasValue)
+                options.minCompressionRatio = std::clamp(std::stof(argv[++i]), 0.0f, 1.0f);
+            else if (arg.starts_with("--"))
+                return std::nullopt;
+            else if (options.outputPath.empty())
+                options.outputPath = arg;
+            else
+                options.inputPaths.emplace_back(arg);
+        }
+    }
+    catch (const std::exception&)
+    {
+        return std::nullopt;
+    }
+
+    if (options.outputPath.empty() || options.inputPaths.empty())
+        return std::nullopt;
+    return options;
+}
+
+// Expands directories recursively, sorted so that the same inputs always produce the same pack
+std::optional<std::vector<vgfw::vfs::PackSource>> collectSources(const PackOptions& options)
+{
+    const auto rootPath = std::filesystem::absolute(options.rootPath).lexically_normal();
+
+    std::vector<vgfw::vfs::PackSource> sources;
+    const auto                         addFile = [&](const std::filesystem::path& filePath) {
+        const auto packPath = std::filesystem::absolute(filePath).lexically_normal().lexically_relative(rootPath);
+        if (packPath.empty() || packPath.generic_string().starts_with(".."))
+        {
+            std::cerr << "File is outside of the root directory: " << filePath.generic_string() << std::endl;
+            return false;
+        }
+        sources.push_back({.filePath = filePath, .packPath = packPath.generic_string(), .compress = options.compress});
+        return true;
+    };
+
+    for (const auto& inputPath : options.inputPaths)
+    {
+        if (std::filesystem::is_directory(inputPath))
+        {
+            for (const auto& dirEntry : std::filesystem::recursive_directory_iterator(inputPath))
+            {
+                if (dirEntry.is_regular_file() && !addFile(dirEntry.path()))
+                    return std::nullopt;
+            }
+        }
+        else if (std::filesystem::is_regular_file(inputPath))
+        {
+            if (!addFile(inputPath))
+                return std::nullopt;
+        }
+        else
+        {
+            std::cerr << "No such file or directory: " << inputPath.generic_string() << std::endl;
+            return std::nullopt;
+        }
+    }
+
+    std::sort(sources.begin(), sources.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.packPath < rhs.packPath;
+    });
+    sources.erase(std::unique(sources.begin(),
+                              sources.end(),
+                              [](const auto& lhs, const auto& rhs) { return lhs.packPath == rhs.packPath; }),
+                  sources.end());
+    return sources;
+}
+
+int main(int argc, char** argv)
+{
+    const auto options = parseOptions(argc, argv);
+    if (!options)
+    {
+        std::cerr << "Usage: vgfw-pack <output> <file or directory>... [--root dir] [--lz4] [--min-ratio R]"
+                  << std::endl;
+        return -1;
+    }
+
+    // Init VGFW, only for logging
+    if (!vgfw::init({.async = false}))
+    {
+        std::cerr << "Failed to initialize VGFW" << std::endl;
+        return -1;
+    }
+
+    const auto sources = collectSources(*options);
+    if (!sources || !vgfw::vfs::writePack(options->outputPath, *sources, options->minCompressionRatio))
+    {
+        vgfw::shutdown();
+        return -1;
+    }
+
+    uint64_t totalSize = 0;
+    for (const auto& source : *sources)
+        totalSize += std::filesystem::file_size(source.filePath);
+
+    std::cout << fmt::format("{0}: {1} files, {2:.2f} MiB -> {3:.2f} MiB",
+                             options->outputPath.generic_string(),
+                             sources->size(),
+                             totalSize / (1024.0 * 1024.0),
+                             std::filesystem::file_size(options->outputPath) / (1024.0 * 1024.0))
+              << std::endl;
+
+    vgfw::shutdown();
+
+    return 0;
+}
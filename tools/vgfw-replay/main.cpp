@@ -0,0 +1,143 @@
+#define VGFW_IMPLEMENTATION
+#include "vgfw.hpp"
+
+// Replays a trace captured with vgfw::renderer::TraceCapture and reports the frame time percentiles.
+//
+// Usage: vgfw-replay <trace> [--loops N] [--warmup N] [--csv path] [--json path] [--show]
+
+struct ReplayOptions
+{
+    std::filesystem::path                tracePath;
+    uint32_t                             numLoops {10};
+    uint32_t                             numWarmupLoops {1};
+    std::optional<std::filesystem::path> csvPath;
+    std::optional<std::filesystem::path> jsonPath;
+    bool                                 show {false};
+};
+
+std::optional<ReplayOptions> parseOptions(int argc, char** argv)
+{
+    ReplayOptions options {};
+
+    // Malformed numbers (std::stoi throws) fall back to the usage message
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg {argv[i]};
+            const bool             hasValue = i + 1 < argc;
+
+            if (arg == "--loops" && hasValue)
+                options.numLoops = std::max(std::stoi(argv[++i]), 1);
+            else if (arg == "--warmup" && hasValue)
+                options.numWarmupLoops = std::max(std::stoi(argv[++i]), 0);
+            else if (arg == "--csv" && hasValue)
+                options.csvPath = argv[++i];
+            else if (arg == "--json" && hasValue)
+                options.jsonPath = argv[++i];
+            else if (arg == "--show")
+                options.show = true;
+            else if (!arg.starts_with("--") && options.tracePath.empty())
+                options.tracePath = arg;
+            else
+                return std::nullopt;
+        }
+    }
+    catch (const std::exception&)
+    {
+        return std::nullopt;
+    }
+
+    if (options.tracePath.empty())
+        return std::nullopt;
+    return options;
+}
+
+void printSummary(const char* name, const vgfw::renderer::FrameTimeSummary& summary)
+{
+    std::cout << fmt::format("{0:<8} mean {1:8.3f} | p50 {2:8.3f} | p95 {3:8.3f} | p99 {4:8.3f} | max {5:8.3f} ms",
+                             name,
+                             summary.mean,
+                             summary.p50,
+                             summary.p95,
+                             summary.p99,
+                             summary.max)
+              << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    const auto options = parseOptions(argc, argv);
+    if (!options)
+    {
+        std::cerr << "Usage: vgfw-replay <trace> [--loops N] [--warmup N] [--csv path] [--json path] [--show]"
+                  << std::endl;
+        return -1;
+    }
+
+    // Init VGFW
+    if (!vgfw::init())
+    {
+        std::cerr << "Failed to initialize VGFW" << std::endl;
+        return -1;
+    }
+
+    vgfw::renderer::TracePlayer player;
+    if (!player.load(options->tracePath))
+        return -1;
+
+    // The window only provides the GL context and a default framebuffer of the captured size
+    const auto extent = player.getExtent();
+    auto       window = vgfw::window::create(
+        {.title = "vgfw-replay", .width = extent.width, .height = extent.height, .isVisible = options->show});
+
+    // Init renderer, frames are neither synchronized to the display nor limited
+    vgfw::renderer::init({.window = window});
+
+    auto& rc                 = vgfw::renderer::getRenderContext();
+    auto& frameStatsRecorder = vgfw::renderer::getFrameStatsRecorder();
+
+    player.createResources(rc);
+
+    const auto numFrames = player.getNumFrames();
+    for (uint32_t loop = 0; loop < options->numWarmupLoops + options->numLoops && !window->shouldClose(); ++loop)
+    {
+        // Drop the warm-up frames (shader compilation, first uploads) from the statistics
+        if (loop == options->numWarmupLoops)
+            frameStatsRecorder.init(options->numLoops * numFrames);
+
+        for (uint32_t frame = 0; frame < numFrames; ++frame)
+        {
+            window->onTick();
+
+            vgfw::renderer::beginFrame();
+            player.replayFrame(frame);
+            vgfw::renderer::endFrame();
+
+            vgfw::renderer::present();
+        }
+    }
+
+    const auto report = frameStatsRecorder.getReport();
+    std::cout << fmt::format("{0}: {1} frames x {2} loops, {3} stutters",
+                             options->tracePath.generic_string(),
+                             numFrames,
+                             options->numLoops,
+                             report.numStutters)
+              << std::endl;
+    printSummary("Frame", report.frame);
+    printSummary("CPU", report.cpu);
+    printSummary("GPU", report.gpu);
+    printSummary("Present", report.present);
+
+    if (options->csvPath)
+        frameStatsRecorder.exportToFile(*options->csvPath);
+    if (options->jsonPath)
+        frameStatsRecorder.exportToFile(*options->jsonPath);
+
+    // Cleanup
+    player.destroyResources();
+    vgfw::shutdown();
+
+    return 0;
+}
@@ -0,0 +1,13 @@
+-- target defination, name: vgfw-replay
+target("vgfw-replay")
+    -- set target kind: executable
+    set_kind("binary")
+
+    -- add source files
+    add_files("main.cpp")
+
+    -- add deps
+    add_deps("vgfw")
+
+    -- set target directory
+    set_targetdir("$(buildir)/$(plat)/$(arch)/$(mode)/tools/vgfw-replay")
@@ -0,0 +1,2 @@
+includes("vgfw-replay")
+includes("vgfw-pack")
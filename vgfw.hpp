@@ -18,13 +18,26 @@
 #define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 
-#include <algorithm>
 #include <array>
+#include <condition_variable>
 #include <iostream>
 #include <limits>
 #include <numeric>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef VGFW_ENABLE_LZ4
+#include <lz4.h>
+#include <lz4hc.h>
+#endif
 #endif
 
 // Currently, we only support Windows & Linux (DSA is not available on macOS (GL 4.1))
@@ -58,33 +71,93 @@
 #define VGFW_RENDER_API_OPENGL_MIN_MINOR 6
 #endif
 
+// Same values as spdlog's SPDLOG_LEVEL_*
+#define VGFW_LOG_LEVEL_TRACE 0
+#define VGFW_LOG_LEVEL_DEBUG 1
+#define VGFW_LOG_LEVEL_INFO 2
+#define VGFW_LOG_LEVEL_WARN 3
+#define VGFW_LOG_LEVEL_ERROR 4
+#define VGFW_LOG_LEVEL_CRITICAL 5
+#define VGFW_LOG_LEVEL_OFF 6
+
+// Log calls below this level compile to nothing, their arguments are not even evaluated
+#ifndef VGFW_ACTIVE_LOG_LEVEL
+#ifdef NDEBUG
+#define VGFW_ACTIVE_LOG_LEVEL VGFW_LOG_LEVEL_INFO
+#else
+#define VGFW_ACTIVE_LOG_LEVEL VGFW_LOG_LEVEL_TRACE
+#endif
+#endif
+
+#if VGFW_ACTIVE_LOG_LEVEL <= VGFW_LOG_LEVEL_TRACE
 #define VGFW_TRACE(...) ::vgfw::log::g_Logger->trace(__VA_ARGS__)
+#else
+#define VGFW_TRACE(...) (void)0
+#endif
+#if VGFW_ACTIVE_LOG_LEVEL <= VGFW_LOG_LEVEL_DEBUG
+#define VGFW_DEBUG(...) ::vgfw::log::g_Logger->debug(__VA_ARGS__)
+#else
+#define VGFW_DEBUG(...) (void)0
+#endif
+#if VGFW_ACTIVE_LOG_LEVEL <= VGFW_LOG_LEVEL_INFO
 #define VGFW_INFO(...) ::vgfw::log::g_Logger->info(__VA_ARGS__)
+#else
+#define VGFW_INFO(...) (void)0
+#endif
+#if VGFW_ACTIVE_LOG_LEVEL <= VGFW_LOG_LEVEL_WARN
 #define VGFW_WARN(...) ::vgfw::log::g_Logger->warn(__VA_ARGS__)
+#else
+#define VGFW_WARN(...) (void)0
+#endif
+#if VGFW_ACTIVE_LOG_LEVEL <= VGFW_LOG_LEVEL_ERROR
 #define VGFW_ERROR(...) ::vgfw::log::g_Logger->error(__VA_ARGS__)
+#else
+#define VGFW_ERROR(...) (void)0
+#endif
+#if VGFW_ACTIVE_LOG_LEVEL <= VGFW_LOG_LEVEL_CRITICAL
 #define VGFW_CRITICAL(...) ::vgfw::log::g_Logger->critical(__VA_ARGS__)
+#else
+#define VGFW_CRITICAL(...) (void)0
+#endif
 
 // clang-format off
 #include <spdlog/spdlog.h>
+#include <spdlog/async.h>
 #include <spdlog/fmt/ostr.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 // clang-format on
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <chrono>
+#include <coroutine>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <deque>
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <unordered_map>
+#include <tuple>
 #include <variant>
+#include <vector>
 
 #include <glad/glad.h>
 
+// Pastes __LINE__ into scope variable names, the extra level expands it first
+#define VGFW_PROFILE_CONCAT_IMPL(a, b) a##b
+#define VGFW_PROFILE_CONCAT(a, b) VGFW_PROFILE_CONCAT_IMPL(a, b)
+
 #ifdef VGFW_ENABLE_TRACY
 #define TRACY_ENABLE
 #include <tracy/Tracy.hpp>
@@ -99,23 +172,48 @@
 #define VGFW_PROFILE_GL(__VA_ARGS__) TracyGpuZone(__VA_ARGS__);
 #define VGFW_PROFILE_GL_COLLECT TracyGpuCollect;
 #else
+#ifdef VGFW_ENABLE_BUILTIN_PROFILER
+// Built-in CPU profiler (see vgfw::profiler), used when Tracy is not compiled in
+#define VGFW_PROFILE_FUNCTION \
+    const ::vgfw::profiler::ScopedZone VGFW_PROFILE_CONCAT(vgfwZone, __LINE__) { __FUNCTION__ };
+#define VGFW_PROFILE_NAMED_SCOPE(name) \
+    const ::vgfw::profiler::ScopedZone VGFW_PROFILE_CONCAT(vgfwZone, __LINE__) { name };
+#define VGFW_PROFILE_END_OF_FRAME ::vgfw::profiler::endFrame();
+#else
 #define VGFW_PROFILE_FUNCTION
 #define VGFW_PROFILE_NAMED_SCOPE(__VA_ARGS__)
 #define VGFW_PROFILE_END_OF_FRAME
+#endif
 
 #define VGFW_PROFILE_GL_INIT_CONTEXT
 #define VGFW_PROFILE_GL(__VA_ARGS__)
 #define VGFW_PROFILE_GL_COLLECT
 #endif
 
+#ifdef VGFW_ENABLE_RENDER_STATS
+#define VGFW_RENDER_STAT(stat, value) m_Stats.stat += (value);
+#else
+#define VGFW_RENDER_STAT(stat, value)
+#endif
+
+// RenderContext hooks of renderer::TraceCapture
+#ifdef VGFW_ENABLE_TRACE_CAPTURE
+#define VGFW_CAPTURE(...) ::vgfw::renderer::g_TraceCapture.__VA_ARGS__;
+#else
+#define VGFW_CAPTURE(...)
+#endif
+
+// Debug markers double as scopes of the built-in GPU profiler (renderer::GpuProfiler)
 #ifdef VGFW_ENABLE_GL_DEBUG
 #define NAMED_DEBUG_MARKER(name) \
-    const ::vgfw::renderer::DebugMarker dm##__LINE__ { name }
+    const ::vgfw::renderer::DebugMarker VGFW_PROFILE_CONCAT(dm, __LINE__) { name }
 #define DEBUG_MARKER() \
-    const ::vgfw::renderer::DebugMarker dm##__LINE__ { __FUNCTION__ }
+    const ::vgfw::renderer::DebugMarker VGFW_PROFILE_CONCAT(dm, __LINE__) { __FUNCTION__ }
 #else
-#define NAMED_DEBUG_MARKER(name)
-#define DEBUG_MARKER()
+#define NAMED_DEBUG_MARKER(name) \
+    const ::vgfw::renderer::GpuScope VGFW_PROFILE_CONCAT(gs, __LINE__) { name }
+#define DEBUG_MARKER() \
+    const ::vgfw::renderer::GpuScope VGFW_PROFILE_CONCAT(gs, __LINE__) { __FUNCTION__ }
 #endif
 
 #include <GLFW/glfw3.h>
@@ -129,6 +227,7 @@
 #include <GLFW/glfw3native.h>
 
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 #include <fg/Blackboard.hpp>
@@ -162,9 +261,127 @@ namespace vgfw
         template<typename T, typename... Rest>
         void hashCombine(std::size_t& seed, const T& v, const Rest&... rest);
 
-        std::string readFileAllText(const std::filesystem::path& filePath);
+        std::string          readFileAllText(const std::filesystem::path& filePath);
+        std::vector<uint8_t> readFileAllBytes(const std::filesystem::path& filePath);
+        bool                 writeFileAllText(const std::filesystem::path& filePath, std::string_view text);
+
+        // Escapes a string for use inside a JSON string literal
+        std::string escapeJson(std::string_view str);
     } // namespace utils
 
+    namespace vfs
+    {
+        // Pack archive layout: PackHeader | blobs (each aligned to kPackAlignment) | PackEntry[numEntries] | paths
+        // All structs are stored as-is, in the (little-endian) byte order of the supported platforms.
+        constexpr uint32_t kPackMagic     = 0x4b504756; // "VGPK"
+        constexpr uint32_t kPackVersion   = 1;
+        constexpr uint64_t kPackAlignment = 64;
+
+        enum class PackCompression : uint32_t
+        {
+            eNone = 0,
+            eLZ4 // LZ4 block, needs VGFW_ENABLE_LZ4 to read and write
+        };
+
+        struct PackHeader
+        {
+            uint32_t magic {kPackMagic};
+            uint32_t version {kPackVersion};
+            uint32_t numEntries {0};
+            uint32_t reserved {0};
+            uint64_t indexOffset {0}; // PackEntry[numEntries]
+            uint64_t pathsOffset {0}; // Entry paths, not null-terminated
+            uint64_t pathsSize {0};
+        };
+
+        struct PackEntry
+        {
+            uint64_t        offset {0};
+            uint64_t        storedSize {0};
+            uint64_t        size {0}; // Uncompressed
+            uint32_t        pathOffset {0};
+            uint32_t        pathLength {0};
+            PackCompression compression {PackCompression::eNone};
+            uint32_t        reserved {0};
+        };
+
+        // Read-only memory mapping of a whole file
+        class MappedFile
+        {
+        public:
+            MappedFile() = default;
+            MappedFile(const MappedFile&) = delete;
+            MappedFile(MappedFile&&) noexcept;
+            ~MappedFile();
+
+            MappedFile& operator=(const MappedFile&) = delete;
+            MappedFile& operator=(MappedFile&&) noexcept;
+
+            bool open(const std::filesystem::path& filePath);
+            void close();
+
+            // Asks the OS to page in [offset, offset + size) ahead of use
+            void prefetch(uint64_t offset, uint64_t size) const;
+
+            const uint8_t* data() const { return m_Data; }
+            uint64_t       size() const { return m_Size; }
+            bool           isOpen() const { return m_Data != nullptr; }
+
+        private:
+            const uint8_t* m_Data {nullptr};
+            uint64_t       m_Size {0};
+        };
+
+        // Contents of a file read through the VFS. Uncompressed pack entries point straight into the mapped pack,
+        // which is kept alive for as long as the FileData exists; everything else owns its bytes.
+        class FileData
+        {
+        public:
+            FileData() = default;
+            explicit FileData(std::vector<uint8_t>&& bytes) : m_Storage(std::move(bytes)) {}
+            FileData(std::shared_ptr<const MappedFile> mapping, const uint8_t* data, size_t size) :
+                m_Mapping(std::move(mapping)), m_View(data), m_ViewSize(size)
+            {}
+
+            const uint8_t* data() const { return m_Mapping ? m_View : m_Storage.data(); }
+            size_t         size() const { return m_Mapping ? m_ViewSize : m_Storage.size(); }
+            bool           empty() const { return size() == 0; }
+            bool           isMapped() const { return m_Mapping != nullptr; }
+
+            std::string_view     text() const { return {reinterpret_cast<const char*>(data()), size()}; }
+            std::vector<uint8_t> toBytes() &&;
+
+        private:
+            std::vector<uint8_t>              m_Storage;
+            std::shared_ptr<const MappedFile> m_Mapping;
+            const uint8_t*                    m_View {nullptr};
+            size_t                            m_ViewSize {0};
+        };
+
+        // Mounts a pack archive so that its entries shadow loose files under mountPoint (relative to the working
+        // directory when empty). Later mounts take precedence over earlier ones.
+        bool mount(const std::filesystem::path& packPath, const std::filesystem::path& mountPoint = {});
+        bool unmount(const std::filesystem::path& packPath);
+        void unmountAll();
+
+        // Lookups go through the mounted packs first, then fall back to the native filesystem
+        bool                    exists(const std::filesystem::path& filePath);
+        std::optional<uint64_t> getFileSize(const std::filesystem::path& filePath);
+        std::optional<FileData> readFile(const std::filesystem::path& filePath);
+
+        struct PackSource
+        {
+            std::filesystem::path filePath; // On disk
+            std::string           packPath; // Path inside the pack, relative to the mount point
+            bool                  compress {false};
+        };
+
+        // Compressed entries are stored uncompressed when LZ4 saves less than (1 - minCompressionRatio) of their size
+        bool writePack(const std::filesystem::path&   packPath,
+                       const std::vector<PackSource>& sources,
+                       float                          minCompressionRatio = 0.9f);
+    } // namespace vfs
+
     namespace time
     {
         using Clock     = std::chrono::high_resolution_clock;
@@ -194,12 +411,249 @@ namespace vgfw
 
     namespace log
     {
-        static std::shared_ptr<spdlog::logger> g_Logger = nullptr;
+        // Defined once, in the translation unit with VGFW_IMPLEMENTATION
+        extern std::shared_ptr<spdlog::logger> g_Logger;
+
+        struct LogInitInfo
+        {
+            // Messages are formatted and written by a background thread, callers only enqueue them
+            bool     async {true};
+            uint32_t queueSize {8192};
+            // When the queue is full: drop the oldest message instead of blocking the caller
+            bool dropOldestOnOverflow {false};
+            // Errors are flushed right away, lower levels periodically
+            std::chrono::seconds flushInterval {1};
+        };
 
-        void init();
+        void init(const LogInitInfo& initInfo = {});
         void shutdown();
     } // namespace log
 
+    namespace profiler
+    {
+        // A finished zone, timestamps in nanoseconds since profiler start. The name must outlive the profiler.
+        struct ZoneEvent
+        {
+            const char* name {nullptr};
+            uint64_t    beginNs {0};
+            uint64_t    endNs {0};
+        };
+
+        class ScopedZone
+        {
+        public:
+            explicit ScopedZone(const char* name);
+            ~ScopedZone();
+
+            ScopedZone(const ScopedZone&)            = delete;
+            ScopedZone& operator=(const ScopedZone&) = delete;
+
+        private:
+            const char* m_Name {nullptr};
+            uint64_t    m_BeginNs {0};
+        };
+
+        void setEnabled(bool enabled);
+        bool isEnabled();
+
+        uint64_t now();
+
+        // Names the calling thread in exported traces
+        void setThreadName(std::string_view name);
+
+        // Appends a zone to the calling thread's ring buffer (lock-free, overwrites the oldest zones when full)
+        void recordZone(const char* name, uint64_t beginNs, uint64_t endNs);
+
+        void endFrame();
+
+        // Chrome trace-event JSON (chrome://tracing, Perfetto) of all zones still held in the ring buffers
+        std::string exportChromeTrace();
+        bool        exportChromeTrace(const std::filesystem::path& filePath);
+
+        // Writes a Chrome trace of the next numFrames frames to filePath once they are done
+        void captureFrames(uint32_t numFrames, const std::filesystem::path& filePath);
+    } // namespace profiler
+
+    namespace jobs
+    {
+        using Job = std::function<void()>;
+
+        // Fork/join counter, incremented for every job submitted against it and decremented when the job finishes.
+        class Counter
+        {
+        public:
+            Counter()               = default;
+            Counter(const Counter&) = delete;
+            Counter(Counter&&)      = delete;
+            ~Counter()              = default;
+
+            Counter& operator=(const Counter&) = delete;
+            Counter& operator=(Counter&&)      = delete;
+
+            void add(uint32_t n = 1) { m_Value.fetch_add(n, std::memory_order_relaxed); }
+            void done() { m_Value.fetch_sub(1, std::memory_order_release); }
+
+            bool     isDone() const { return m_Value.load(std::memory_order_acquire) == 0; }
+            uint32_t getValue() const { return m_Value.load(std::memory_order_acquire); }
+
+        private:
+            std::atomic<uint32_t> m_Value {0};
+        };
+
+        struct JobSystemInitInfo
+        {
+            // Defaults to (hardware threads - 1), the calling thread is worker 0.
+            std::optional<uint32_t> numWorkers {};
+            // Capacity of every worker's deque, must be a power of 2. Jobs submitted to a full deque run inline.
+            uint32_t queueCapacity {4096};
+        };
+
+        /**
+         * @brief Start the work-stealing scheduler. Must be called from the GL thread, which becomes worker 0 and
+         * the only thread that executes jobs pinned with runOnGLThread.
+         *
+         * Without init (or after shutdown) every job runs inline on the submitting thread.
+         */
+        void init(const JobSystemInitInfo& initInfo = {});
+        void shutdown();
+        bool isInitialized();
+
+        // Number of threads executing jobs, including the GL thread.
+        uint32_t getNumThreads();
+        // Index of the calling thread in [0, getNumThreads()), or -1 for threads unknown to the scheduler.
+        int32_t getThreadIndex();
+        bool    isGLThread();
+
+        void run(Job job, Counter* counter = nullptr);
+        // Blocks until the counter reaches zero, executing pending jobs meanwhile.
+        void wait(const Counter& counter);
+
+        // Queue a job that has to run on the GL thread, it is executed by pumpGLThread (called in beginFrame).
+        void runOnGLThread(Job job, Counter* counter = nullptr);
+        void pumpGLThread();
+
+        // [0, count) is always split into the same ceil(count / grainSize) chunks, independent of the number of
+        // workers and of scheduling, so per-chunk results can be combined in a deterministic order.
+        inline constexpr uint32_t getNumChunks(uint32_t count, uint32_t grainSize)
+        {
+            return grainSize > 0 ? (count + grainSize - 1) / grainSize : 0;
+        }
+
+        // Calls fn(begin, end) for every chunk and returns once all chunks are done.
+        void parallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& fn);
+
+        // Reduces map(i) over [0, count). Chunks are reduced in index order, so the result is bit-identical for any
+        // number of workers (given the same grain size).
+        template<typename T, typename MapFn, typename ReduceFn>
+        T parallelReduce(uint32_t count, uint32_t grainSize, T identity, MapFn&& map, ReduceFn&& reduce)
+        {
+            std::vector<T> partials(getNumChunks(count, grainSize), identity);
+            parallelFor(count, grainSize, [&](uint32_t begin, uint32_t end) {
+                auto& partial = partials[begin / grainSize];
+                for (auto i = begin; i < end; ++i)
+                    partial = reduce(partial, map(i));
+            });
+
+            auto result = identity;
+            for (const auto& partial : partials)
+                result = reduce(result, partial);
+            return result;
+        }
+
+        // Writes map(i) to slot i, the output order never depends on which thread produced an element.
+        template<typename T, typename MapFn>
+        std::vector<T> parallelMap(uint32_t count, uint32_t grainSize, MapFn&& map)
+        {
+            std::vector<T> results(count);
+            parallelFor(count, grainSize, [&](uint32_t begin, uint32_t end) {
+                for (auto i = begin; i < end; ++i)
+                    results[i] = map(i);
+            });
+            return results;
+        }
+    } // namespace jobs
+
+    namespace memory
+    {
+        /**
+         * @brief Double-buffered bump allocator for CPU memory that lives for one frame.
+         *
+         * Allocations are carved from the half of the current frame and never freed one by one. nextFrame flips to
+         * the other half and rewinds it, so memory handed out in frame N stays valid until the end of frame N + 1.
+         * When a half runs out, allocations fall back to the upstream resource and the half grows at its next rewind,
+         * so steady-state frames stop touching the heap after a few frames. GL thread only.
+         */
+        class FrameArena final : public std::pmr::memory_resource
+        {
+        public:
+            explicit FrameArena(size_t                     initialCapacity = 256 * 1024,
+                                std::pmr::memory_resource* upstream        = std::pmr::new_delete_resource());
+            FrameArena(const FrameArena&) = delete;
+            FrameArena(FrameArena&&)      = delete;
+            ~FrameArena() override;
+
+            FrameArena& operator=(const FrameArena&) = delete;
+            FrameArena& operator=(FrameArena&&)      = delete;
+
+            // Called by renderer::beginFrame
+            void nextFrame();
+
+            // Capacity of one half
+            size_t getCapacity() const;
+            // Bytes allocated in the current frame, overflow included
+            size_t   getUsedBytes() const;
+            size_t   getPeakBytes() const { return m_PeakBytes; }
+            uint64_t getNumOverflows() const { return m_NumOverflows; }
+
+        private:
+            void* do_allocate(size_t bytes, size_t alignment) override;
+            void  do_deallocate(void* p, size_t bytes, size_t alignment) override;
+            bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+            struct Block
+            {
+                std::byte* data {nullptr};
+                size_t     capacity {0};
+                size_t     offset {0};
+                size_t     overflowBytes {0};
+
+                bool contains(const void* p) const;
+            };
+
+            void allocateBlock(Block&, size_t capacity);
+            void releaseBlock(Block&);
+
+        private:
+            std::pmr::memory_resource* m_Upstream {nullptr};
+            size_t                     m_InitialCapacity {0};
+            std::array<Block, 2>       m_Blocks {};
+            uint32_t                   m_Current {0};
+            size_t                     m_PeakBytes {0};
+            uint64_t                   m_NumOverflows {0};
+        };
+
+        FrameArena& getFrameArena();
+
+        // std::pmr::vector that allocates from the frame arena by default, copies included
+        template<typename T>
+        class FrameVector : public std::pmr::vector<T>
+        {
+            using Base = std::pmr::vector<T>;
+
+        public:
+            FrameVector() : Base(&getFrameArena()) {}
+            FrameVector(std::initializer_list<T> init) : Base(init, &getFrameArena()) {}
+            explicit FrameVector(size_t count) : Base(count, &getFrameArena()) {}
+            explicit FrameVector(std::pmr::memory_resource* resource) : Base(resource) {}
+
+            FrameVector(const FrameVector& other) : Base(other, &getFrameArena()) {}
+            FrameVector(FrameVector&&) noexcept = default;
+
+            FrameVector& operator=(const FrameVector&)     = default;
+            FrameVector& operator=(FrameVector&&) noexcept = default;
+        };
+    } // namespace memory
+
     namespace window
     {
         enum class AASample
@@ -213,17 +667,20 @@ namespace vgfw
 
         struct WindowInitInfo
         {
-            std::string title        = "VGFW Window";
-            uint32_t    width        = 1024;
-            uint32_t    height       = 768;
-            bool        isResizable  = false;
-            bool        isFullScreen = false;
-            AASample    aaSample     = AASample::e1;
+            std::string title         = "VGFW Window";
+            uint32_t    width         = 1024;
+            uint32_t    height        = 768;
+            bool        isResizable   = false;
+            bool        isFullScreen  = false;
+            AASample    aaSample      = AASample::e1;
+            bool        isEventDriven = false; // See Window::setEventDriven
+            bool        isVisible     = true;  // Hidden windows still own a GL context (offscreen tools)
         };
 
         enum class WindowType
         {
             eGLFW = 0,
+            eNull, // No display, see NullWindow
         };
 
         class Window
@@ -251,6 +708,42 @@ namespace vgfw
              */
             virtual void onTick() = 0;
 
+            /**
+             * @brief Get the time of the last event poll (the input sample point of the current frame)
+             *
+             * @return time::TimePoint
+             */
+            time::TimePoint getLastPollTime() const { return m_LastPollTime; }
+
+            /**
+             * @brief Event-driven mode for tool applications: onTick blocks until input, a resize or requestRedraw()
+             * arrives (or idleTimeout expires), and shouldRedraw() tells whether the frame needs rendering.
+             *
+             * @param enabled
+             * @param idleTimeout
+             */
+            void setEventDriven(bool enabled, time::Duration idleTimeout = time::Duration {1.0f})
+            {
+                m_EventDriven = enabled;
+                m_IdleTimeout = idleTimeout;
+            }
+
+            bool isEventDriven() const { return m_EventDriven; }
+
+            /**
+             * @brief Ask for a frame to be rendered, wakes up an event-driven window. Thread-safe.
+             *
+             */
+            virtual void requestRedraw() = 0;
+
+            /**
+             * @brief Whether the frame after the last onTick should be rendered. Always false while minimized (onTick
+             * then blocks until an event arrives), in event-driven mode only true when something changed.
+             *
+             * @return bool
+             */
+            bool shouldRedraw() const { return m_ShouldRedraw; }
+
             /**
              * @brief Get the width of window
              *
@@ -284,6 +777,13 @@ namespace vgfw
              *
              */
             virtual void shutdown() = 0;
+
+            time::TimePoint m_LastPollTime {};
+
+            bool                  m_EventDriven {false};
+            time::Duration        m_IdleTimeout {1.0f};
+            bool                  m_ShouldRedraw {true};
+            std::atomic<uint32_t> m_PendingRedraws {0};
         };
 
         class GLFWWindow final : public Window
@@ -307,6 +807,8 @@ namespace vgfw
 
             virtual void setHideCursor(bool hide) override;
 
+            virtual void requestRedraw() override;
+
             virtual void* getPlatformWindow() const override { return m_Window; }
 
             virtual void* getNativeWindow() const override
@@ -323,6 +825,9 @@ namespace vgfw
         protected:
             virtual void shutdown() override;
 
+        private:
+            void onEvent();
+
         private:
             GLFWwindow* m_Window {nullptr};
 
@@ -337,16 +842,82 @@ namespace vgfw
             WindowData m_Data;
         };
 
+        /**
+         * @brief Window without a display or input for VGFW_NULL_GL builds: CPU-overhead benchmarks, tests and asset
+         * processing on machines without a GPU. Never closes on its own, see requestClose.
+         *
+         */
+        class NullWindow final : public Window
+        {
+        public:
+            virtual WindowType getType() override { return WindowType::eNull; }
+
+            virtual bool init(const WindowInitInfo& initInfo) override;
+
+            virtual void onTick() override;
+
+            virtual uint32_t getWidth() const override { return m_Width; }
+
+            virtual uint32_t getHeight() const override { return m_Height; }
+
+            virtual bool shouldClose() const override { return m_ShouldClose; }
+            virtual bool isMinimized() const override { return false; }
+
+            virtual void makeCurrentContext() override {}
+            virtual void swapBuffers() override;
+
+            virtual void setHideCursor(bool) override {}
+
+            virtual void requestRedraw() override;
+
+            virtual void* getPlatformWindow() const override { return nullptr; }
+            virtual void* getNativeWindow() const override { return nullptr; }
+
+            void requestClose() { m_ShouldClose = true; }
+
+        protected:
+            virtual void shutdown() override {}
+
+        private:
+            uint32_t m_Width {0};
+            uint32_t m_Height {0};
+            bool     m_ShouldClose {false};
+        };
+
         std::shared_ptr<Window> create(const WindowInitInfo& windowInitInfo, WindowType type = WindowType::eGLFW);
     } // namespace window
 
     namespace renderer
     {
+        // Times the enclosed GL commands with the built-in GPU profiler, no-op while the profiler is disabled
+        class GpuScope
+        {
+        public:
+            explicit GpuScope(std::string_view name);
+            ~GpuScope();
+
+            GpuScope(const GpuScope&)            = delete;
+            GpuScope& operator=(const GpuScope&) = delete;
+
+        private:
+            int32_t m_Index {-1};
+        };
+
         class DebugMarker
         {
         public:
             explicit DebugMarker(std::string_view name);
             ~DebugMarker();
+
+        private:
+            GpuScope m_GpuScope;
+        };
+
+        enum class VSyncMode : int8_t
+        {
+            eOff      = 0,
+            eOn       = 1,
+            eAdaptive = -1 // Tears instead of stalling when a frame misses the vblank (falls back to eOn)
         };
 
         class GraphicsContext
@@ -359,6 +930,7 @@ namespace vgfw
 
             void        swapBuffers();
             static void setVSync(bool vsyncEnabled);
+            static void setVSyncMode(VSyncMode mode);
 
             bool isSupportDSA() const { return m_SupportDSA; }
 
@@ -374,63 +946,330 @@ namespace vgfw
             std::shared_ptr<window::Window> m_Window {nullptr};
         };
 
-        class Buffer
+#ifdef VGFW_NULL_GL
+        // Null GL backend: every GL entry point is a CPU-only stub (synthetic object names, nothing is rendered), so
+        // RenderContext, the framegraph and the loaders run without a driver and vgfw's own CPU cost can be measured
+        namespace nullgl
         {
-            friend class RenderContext;
-
-        public:
-            Buffer()              = default;
-            Buffer(const Buffer&) = delete;
-            Buffer(Buffer&&) noexcept;
-            virtual ~Buffer();
-
-            Buffer& operator=(const Buffer&) = delete;
-            Buffer& operator=(Buffer&&) noexcept;
-
-            explicit operator bool() const;
-
-            GLsizeiptr getSize() const;
-            bool       isMapped() const;
+            struct CallCount
+            {
+                std::string_view function;
+                uint64_t         count {0};
+            };
 
-        protected:
-            Buffer(GLuint id, GLsizeiptr size);
+            void setCallLogging(bool enabled); // Log every GL call at trace level
+            bool isCallLogging();
 
-            explicit operator GLuint() const;
+            uint64_t               getNumCalls();
+            std::vector<CallCount> getCallCounts(); // Called entry points only, most called first
+            void                   resetCallCounts();
+        } // namespace nullgl
+#endif
 
-        protected:
-            GLuint     m_Id {GL_NONE};
-            GLsizeiptr m_Size {0};
-            void*      m_MappedMemory {nullptr};
+        struct FramePacingInfo
+        {
+            uint32_t             maxFramesInFlight {2};
+            VSyncMode            vsyncMode {VSyncMode::eOff};
+            std::optional<float> targetFrameRate {}; // Frames per second, unlimited if not set
         };
 
-        enum class IndexType
+        struct FramePacingStats
         {
-            eUnknown = 0,
-            eUInt8   = 1,
-            eUInt16  = 2,
-            eUInt32  = 4
+            time::Duration cpuWait {0.0f};    // Time blocked on frames in flight + frame rate limiter
+            time::Duration gpuLatency {0.0f}; // Submit to fence signal of the most recently retired frame
+            uint32_t       framesInFlight {0};
         };
 
-        class IndexBuffer final : public Buffer
+        /**
+         * @brief Limits the number of frames queued to the driver with one fence per frame and optionally caps the
+         * frame rate (sleep, then spin for the last stretch).
+         *
+         */
+        class FramePacer
         {
-            friend class RenderContext;
-
         public:
-            IndexBuffer() = default;
+            FramePacer()                  = default;
+            FramePacer(const FramePacer&) = delete;
+            FramePacer(FramePacer&&)      = delete;
 
-            IndexType  getIndexType() const;
-            GLsizeiptr getCapacity() const;
+            FramePacer& operator=(const FramePacer&) = delete;
+            FramePacer& operator=(FramePacer&&)      = delete;
+
+            void init(const FramePacingInfo& info);
+            void shutdown();
+
+            // Called by renderer::present right after the swap
+            void onPresent();
+
+            void setMaxFramesInFlight(uint32_t n);
+            void setVSyncMode(VSyncMode mode);
+            void setTargetFrameRate(std::optional<float> fps);
+
+            const FramePacingInfo&  getInfo() const { return m_Info; }
+            const FramePacingStats& getStats() const { return m_Stats; }
 
         private:
-            IndexBuffer(Buffer, IndexType);
+            void retireFrames(bool block);
+            void limitFrameRate();
 
         private:
-            IndexType m_IndexType {IndexType::eUnknown};
+            struct InFlightFrame
+            {
+                GLsync          fence {nullptr};
+                time::TimePoint submitTime;
+            };
+
+            FramePacingInfo           m_Info {};
+            FramePacingStats          m_Stats {};
+            std::deque<InFlightFrame> m_InFlightFrames;
+            time::TimePoint           m_LastFrameEnd {};
         };
 
-        class VertexBuffer final : public Buffer
+        struct FrameLatencySample
         {
-            friend class RenderContext;
+            uint64_t       frameIndex {0};
+            time::Duration inputToSubmit {0.0f}; // Event poll to present
+            time::Duration submitToGpu {0.0f};   // Present to GPU completion
+            time::Duration inputToGpu {0.0f};    // Event poll to GPU completion (input-to-photon minus scanout)
+        };
+
+        // In milliseconds
+        struct LatencyDistribution
+        {
+            float min {0.0f};
+            float avg {0.0f};
+            float p50 {0.0f};
+            float p95 {0.0f};
+            float p99 {0.0f};
+            float max {0.0f};
+        };
+
+        struct LatencyReport
+        {
+            uint32_t            numSamples {0};
+            LatencyDistribution inputToSubmit {};
+            LatencyDistribution submitToGpu {};
+            LatencyDistribution inputToGpu {};
+        };
+
+        /**
+         * @brief Measures per-frame latency from the event poll through submission to GPU completion. GPU completion
+         * comes from a GL_TIMESTAMP query issued after the swap, mapped onto the CPU clock.
+         *
+         */
+        class LatencyTracker
+        {
+        public:
+            LatencyTracker()                      = default;
+            LatencyTracker(const LatencyTracker&) = delete;
+            LatencyTracker(LatencyTracker&&)      = delete;
+
+            LatencyTracker& operator=(const LatencyTracker&) = delete;
+            LatencyTracker& operator=(LatencyTracker&&)      = delete;
+
+            void init(uint32_t historySize = 240);
+            void shutdown();
+
+            bool isEnabled() const { return m_Enabled; }
+
+            // Called by renderer::present right after the swap
+            void onPresent(time::TimePoint inputTime);
+
+            const std::vector<FrameLatencySample>& getSamples() const { return m_Samples; } // Ring buffer, unordered
+            LatencyReport                          getReport() const;
+
+            void drawOverlay(bool* open = nullptr) const;
+
+        private:
+            void calibrate();
+            void collect();
+
+        private:
+            struct PendingFrame
+            {
+                GLuint          query {GL_NONE};
+                uint64_t        frameIndex {0};
+                time::TimePoint inputTime;
+                time::TimePoint submitTime;
+            };
+
+            bool                            m_Enabled {false};
+            uint64_t                        m_FrameIndex {0};
+            std::deque<PendingFrame>        m_PendingFrames;
+            std::vector<GLuint>             m_FreeQueries;
+            std::vector<FrameLatencySample> m_Samples;
+            uint32_t                        m_HistorySize {0};
+            uint32_t                        m_NextSample {0};
+
+            // GPU timestamp (ns) = CPU time + offset, refreshed periodically against clock drift
+            int64_t m_GpuToCpuOffset {0};
+        };
+
+        struct PipelineStatistics
+        {
+            uint64_t verticesSubmitted {0};
+            uint64_t primitivesSubmitted {0};
+            uint64_t fragmentShaderInvocations {0};
+        };
+
+        struct GpuScopeResult
+        {
+            std::string                       name;
+            uint32_t                          depth {0};
+            double                            startMs {0.0}; // Relative to the first scope of the frame
+            double                            durationMs {0.0};
+            double                            cpuDurationMs {0.0}; // CPU time spent recording the scope's commands
+            std::optional<PipelineStatistics> statistics {}; // Top-level scopes only, queries of a type cannot nest
+        };
+
+        /**
+         * @brief Built-in GPU profiler. Every GpuScope (and NAMED_DEBUG_MARKER, so every framegraph pass) records a
+         * pair of GL_TIMESTAMP queries, optionally with pipeline statistics queries. Queries live in a ring of
+         * kNumFrames frames and are only read back once available, so results lag kNumFrames - 1 frames and never
+         * stall the pipeline.
+         *
+         */
+        class GpuProfiler
+        {
+        public:
+            static constexpr uint32_t kNumFrames = 4;
+
+            GpuProfiler()                   = default;
+            GpuProfiler(const GpuProfiler&) = delete;
+            GpuProfiler(GpuProfiler&&)      = delete;
+
+            GpuProfiler& operator=(const GpuProfiler&) = delete;
+            GpuProfiler& operator=(GpuProfiler&&)      = delete;
+
+            void init(bool enablePipelineStatistics = false);
+            void shutdown();
+
+            bool isEnabled() const { return m_Enabled; }
+
+            // Requires GL 4.6 (ARB_pipeline_statistics_query in core)
+            bool isPipelineStatisticsSupported() const;
+            void setPipelineStatisticsEnabled(bool enabled);
+
+            // Called by renderer::beginFrame / renderer::present
+            void beginFrame();
+            void endFrame();
+
+            int32_t beginScope(std::string_view name);
+            void    endScope(int32_t index);
+
+            uint64_t                           getResultsFrameIndex() const { return m_ResultsFrameIndex; }
+            const std::vector<GpuScopeResult>& getResults() const { return m_Results; }
+            uint64_t                           getNumDroppedFrames() const { return m_NumDroppedFrames; }
+
+            std::string exportJson() const;
+            bool        exportJson(const std::filesystem::path& filePath) const;
+
+        private:
+            static constexpr uint32_t kNumStatistics = 3;
+
+            struct Scope
+            {
+                std::string                        name;
+                uint32_t                           depth {0};
+                GLuint                             begin {GL_NONE};
+                GLuint                             end {GL_NONE};
+                std::array<GLuint, kNumStatistics> statistics {};
+                bool                               hasStatistics {false};
+                time::TimePoint                    cpuBegin {};
+                double                             cpuDurationMs {0.0};
+            };
+
+            struct QueryPool
+            {
+                std::vector<GLuint> queries;
+                uint32_t            numUsed {0};
+
+                GLuint acquire();
+            };
+
+            struct Frame
+            {
+                uint64_t                              index {0};
+                std::vector<Scope>                    scopes;
+                QueryPool                             timestamps;
+                std::array<QueryPool, kNumStatistics> statistics;
+                bool                                  pending {false};
+            };
+
+            void resolve(Frame& frame);
+
+        private:
+            bool     m_Enabled {false};
+            bool     m_PipelineStatistics {false};
+            bool     m_InFrame {false};
+            uint32_t m_Depth {0};
+            uint64_t m_FrameIndex {0};
+
+            std::array<Frame, kNumFrames> m_Frames;
+
+            std::vector<GpuScopeResult> m_Results;
+            uint64_t                    m_ResultsFrameIndex {0};
+            uint64_t                    m_NumDroppedFrames {0};
+        };
+
+        class Buffer
+        {
+            friend class RenderContext;
+            friend class TraceCapture;
+
+        public:
+            Buffer()              = default;
+            Buffer(const Buffer&) = delete;
+            Buffer(Buffer&&) noexcept;
+            virtual ~Buffer();
+
+            Buffer& operator=(const Buffer&) = delete;
+            Buffer& operator=(Buffer&&) noexcept;
+
+            explicit operator bool() const;
+
+            GLsizeiptr getSize() const;
+            bool       isMapped() const;
+
+        protected:
+            Buffer(GLuint id, GLsizeiptr size);
+
+            explicit operator GLuint() const;
+
+        protected:
+            GLuint     m_Id {GL_NONE};
+            GLsizeiptr m_Size {0};
+            void*      m_MappedMemory {nullptr};
+        };
+
+        enum class IndexType
+        {
+            eUnknown = 0,
+            eUInt8   = 1,
+            eUInt16  = 2,
+            eUInt32  = 4
+        };
+
+        class IndexBuffer final : public Buffer
+        {
+            friend class RenderContext;
+
+        public:
+            IndexBuffer() = default;
+
+            IndexType  getIndexType() const;
+            GLsizeiptr getCapacity() const;
+
+        private:
+            IndexBuffer(Buffer, IndexType);
+
+        private:
+            IndexType m_IndexType {IndexType::eUnknown};
+        };
+
+        class VertexBuffer final : public Buffer
+        {
+            friend class RenderContext;
 
         public:
             VertexBuffer() = default;
@@ -474,8 +1313,112 @@ namespace vgfw
             eBitangent,
         };
 
+        // Attribute type of a vertex struct member
+        template<typename T>
+        consteval VertexAttribute::Type getVertexAttributeType()
+        {
+            using enum VertexAttribute::Type;
+            if constexpr (std::is_same_v<T, float>)
+                return eFloat;
+            else if constexpr (std::is_same_v<T, glm::vec2>)
+                return eFloat2;
+            else if constexpr (std::is_same_v<T, glm::vec3>)
+                return eFloat3;
+            else if constexpr (std::is_same_v<T, glm::vec4>)
+                return eFloat4;
+            else if constexpr (std::is_same_v<T, int32_t>)
+                return eInt;
+            else if constexpr (std::is_same_v<T, glm::ivec4>)
+                return eInt4;
+            else if constexpr (std::is_same_v<T, std::array<uint8_t, 4>>)
+                return eUByte4_Norm;
+            else
+                static_assert(!sizeof(T), "Unsupported vertex attribute type");
+        }
+
+        struct VertexField
+        {
+            AttributeLocation location;
+            VertexAttribute   attribute;
+        };
+
+// Describes a member of a vertex struct, the type and the offset are deduced from the member
+#define VGFW_VERTEX_FIELD(Vertex, member, attributeLocation) \
+    vgfw::renderer::VertexField \
+    { \
+        .location = vgfw::renderer::AttributeLocation::attributeLocation, \
+        .attribute = { \
+            .vertType = vgfw::renderer::getVertexAttributeType<decltype(Vertex::member)>(), \
+            .offset   = static_cast<int32_t>(offsetof(Vertex, member)), \
+        }, \
+    }
+
+        // A vertex struct lists its attributes in a member function, offsetof needs the struct to be complete:
+        //   static constexpr auto getVertexFields() { return std::array {VGFW_VERTEX_FIELD(Vertex, position, ...)}; }
+        template<typename T>
+        concept VertexStruct = requires {
+            {
+                T::getVertexFields()
+            };
+        };
+
+        // FNV-1a, constexpr so that the formats of vertex structs get their hash at compile time
+        constexpr uint64_t kVertexLayoutHashSeed {0xcbf29ce484222325ull};
+
+        constexpr uint64_t hashVertexLayout(uint64_t hash, int32_t location, const VertexAttribute& attribute)
+        {
+            for (const auto value : {location, static_cast<int32_t>(attribute.vertType), attribute.offset})
+                hash = (hash ^ static_cast<uint32_t>(value)) * 0x100000001b3ull;
+            return hash;
+        }
+
+        // Ends a layout hash with the stride, hashed as an attribute at location -1
+        constexpr uint64_t hashVertexLayoutStride(uint64_t hash, uint32_t stride)
+        {
+            const VertexAttribute strideAttribute {
+                .vertType = VertexAttribute::Type::eFloat,
+                .offset   = static_cast<int32_t>(stride),
+            };
+            return hashVertexLayout(hash, -1, strideAttribute);
+        }
+
+        /**
+         * @brief Vertex layout of a vertex struct, evaluated at compile time.
+         *
+         * Fields are sorted by location, like the attributes of a VertexFormat, so that kHash matches the hash of an
+         * equal format made by VertexFormat::Builder.
+         */
+        template<VertexStruct V>
+        struct VertexLayout
+        {
+            static constexpr auto kFields = [] {
+                auto fields = V::getVertexFields();
+                std::sort(fields.begin(), fields.end(), [](const VertexField& a, const VertexField& b) {
+                    return a.location < b.location;
+                });
+                return fields;
+            }();
+            static constexpr uint32_t kStride = sizeof(V);
+
+            static constexpr uint64_t kHash = [] {
+                auto hash = kVertexLayoutHashSeed;
+                for (const auto& field : kFields)
+                    hash = hashVertexLayout(hash, static_cast<int32_t>(field.location), field.attribute);
+                return hashVertexLayoutStride(hash, kStride);
+            }();
+
+            static_assert(std::adjacent_find(kFields.cbegin(),
+                                             kFields.cend(),
+                                             [](const VertexField& a, const VertexField& b) {
+                                                 return a.location == b.location;
+                                             }) == kFields.cend(),
+                          "Duplicate vertex attribute location");
+        };
+
         class VertexFormat
         {
+            friend class RenderContext;
+
         public:
             VertexFormat()                        = delete;
             VertexFormat(const VertexFormat&)     = delete;
@@ -493,6 +1436,10 @@ namespace vgfw
 
             uint32_t getStride() const;
 
+            // Format of a vertex struct, built on first use and shared with equal formats of the Builder
+            template<VertexStruct V>
+            static const std::shared_ptr<VertexFormat>& get();
+
             class Builder final
             {
             public:
@@ -506,7 +1453,8 @@ namespace vgfw
 
                 Builder& setAttribute(AttributeLocation, const VertexAttribute&);
 
-                std::shared_ptr<VertexFormat> build();
+                // A zero stride packs the attributes tightly
+                std::shared_ptr<VertexFormat> build(uint32_t stride = 0);
                 std::shared_ptr<VertexFormat> buildDefault();
 
             private:
@@ -523,12 +1471,29 @@ namespace vgfw
             const std::size_t      m_Hash {0u};
             const VertexAttributes m_Attributes;
             const uint32_t         m_Stride {0};
+
+            // Cached by RenderContext::getVertexArray, valid for the context with the matching id
+            mutable GLuint   m_VertexArray {GL_NONE};
+            mutable uint32_t m_VertexArrayContextId {0};
         };
 
         int32_t getSize(VertexAttribute::Type type);
 
         using Builder = VertexFormat::Builder;
 
+        template<VertexStruct V>
+        const std::shared_ptr<VertexFormat>& VertexFormat::get()
+        {
+            static const auto vertexFormat = [] {
+                Builder builder;
+                for (const auto& field : VertexLayout<V>::kFields)
+                    builder.setAttribute(field.location, field.attribute);
+                return builder.build(VertexLayout<V>::kStride);
+            }();
+            assert(vertexFormat->getHash() == static_cast<std::size_t>(VertexLayout<V>::kHash));
+            return vertexFormat;
+        }
+
         // clang-format off
         struct Offset2D
         {
@@ -612,6 +1577,7 @@ namespace vgfw
         class Texture
         {
             friend class RenderContext;
+            friend class TraceCapture;
 
         public:
             Texture()               = default;
@@ -794,12 +1760,61 @@ namespace vgfw
             // clang-format on
         };
 
+        /**
+         * @brief Fixed-function state of a GraphicsPipeline packed into 128 bits.
+         *
+         * Depth and rasterizer state take the low 12 bits, followed by 27 bits per blend attachment. Enums are stored
+         * as small indices, disabled blend attachments as zero. The polygon offset values do not fit and are kept
+         * aside.
+         */
+        struct PipelineStateKey
+        {
+            struct Field
+            {
+                uint32_t offset, width;
+            };
+            static constexpr Field    kDepthTest {0, 4}; // enabled + compare op
+            static constexpr Field    kDepthWrite {4, 1};
+            static constexpr Field    kPolygonMode {5, 2};
+            static constexpr Field    kCullMode {7, 2};
+            static constexpr Field    kPolygonOffset {9, 1};
+            static constexpr Field    kDepthClamp {10, 1};
+            static constexpr Field    kScissorTest {11, 1};
+            static constexpr uint32_t kBlendOffset {12};
+            static constexpr uint32_t kBlendBits {27}; // enabled + 4 factors * 5 bits + 2 ops * 3 bits
+
+            static constexpr Field getBlendField(uint32_t attachment)
+            {
+                return {kBlendOffset + attachment * kBlendBits, kBlendBits};
+            }
+
+            using Bits = std::array<uint64_t, 2>;
+
+            Bits          bits {};
+            PolygonOffset polygonOffset {};
+
+            static PipelineStateKey make(const DepthStencilState&,
+                                         const RasterizerState&,
+                                         const std::array<BlendState, kMaxNumBlendStates>&);
+
+            // True if any bit of the field is set, used on the XOR of two keys
+            static bool intersects(const Bits&, Field);
+
+            // clang-format off
+            auto operator<=> (const PipelineStateKey&) const = default;
+            // clang-format on
+        };
+
         class GraphicsPipeline
         {
         public:
             friend class RenderContext;
+            friend class TraceCapture;
             GraphicsPipeline() = default;
 
+            // Equal state, program and VAO give equal ids, zero for pipelines not made by the Builder
+            uint32_t getId() const { return m_Id; }
+
             class Builder
             {
             public:
@@ -820,9 +1835,28 @@ namespace vgfw
                 DepthStencilState                          m_DepthStencilState {};
                 RasterizerState                            m_RasterizerState {};
                 std::array<BlendState, kMaxNumBlendStates> m_BlendStates {};
+
+                struct CacheKey
+                {
+                    PipelineStateKey state;
+                    GLuint           program;
+                    GLuint           vao;
+
+                    bool operator==(const CacheKey&) const = default;
+                };
+                struct CacheKeyHash
+                {
+                    std::size_t operator()(const CacheKey&) const noexcept;
+                };
+
+                using Cache = std::unordered_map<CacheKey, uint32_t, CacheKeyHash>;
+                inline static Cache s_Cache;
             };
 
         private:
+            uint32_t         m_Id {0};
+            PipelineStateKey m_StateKey {};
+
             Rect2D m_Viewport, m_Scissor;
 
             GLuint m_Program = GL_NONE;
@@ -863,6 +1897,27 @@ namespace vgfw
             std::optional<AttachmentInfo> depthAttachment {};
         };
 
+        // RenderingInfo for per-frame call sites, the attachment list allocates from the given resource (the frame
+        // arena by default) and must not outlive it. Copies allocate from the default resource.
+        struct FrameRenderingInfo
+        {
+            using allocator_type = std::pmr::polymorphic_allocator<>;
+
+            explicit FrameRenderingInfo(const allocator_type& allocator = &memory::getFrameArena()) :
+                colorAttachments(allocator)
+            {}
+            FrameRenderingInfo(const Rect2D&                         renderArea,
+                               std::initializer_list<AttachmentInfo> colors,
+                               std::optional<AttachmentInfo>         depth     = {},
+                               const allocator_type&                 allocator = &memory::getFrameArena()) :
+                area(renderArea), colorAttachments(colors, allocator), depthAttachment(std::move(depth))
+            {}
+
+            Rect2D                           area {};
+            std::pmr::vector<AttachmentInfo> colorAttachments;
+            std::optional<AttachmentInfo>    depthAttachment {};
+        };
+
         enum class PrimitiveTopology : GLenum
         {
             eUndefined = GL_NONE,
@@ -888,79 +1943,641 @@ namespace vgfw
             auto operator<=>(const GeometryInfo&) const = default;
         };
 
-        class RenderContext
+        enum class CommandType : uint8_t
+        {
+            eSetViewport = 0,
+            eSetScissor,
+
+            eBindGraphicsPipeline,
+            eBindImage,
+            eBindTexture,
+            eBindUniformBuffer,
+            eBindStorageBuffer,
+            eBindMeshPrimitiveMaterialBuffer,
+            eBindMeshPrimitiveTextures,
+
+            eSetUniform1f,
+            eSetUniform1i,
+            eSetUniform1ui,
+            eSetUniformVec2,
+            eSetUniformVec3,
+            eSetUniformVec4,
+            eSetUniformMat3,
+            eSetUniformMat4,
+
+            eDispatch,
+            eDraw,
+            eDrawMeshPrimitive,
+        };
+
+        /**
+         * @brief Records RenderContext commands into a compact linear byte stream.
+         *
+         * Recording never touches GL, so a command list can be filled on any thread (one thread per list) and
+         * replayed later on the GL thread with RenderContext::execute. Executing does not consume the commands: a
+         * static list can be recorded once and replayed every frame, like a bundle, until it is reset.
+         *
+         * Referenced resources (pipelines are copied) must stay alive until the list is executed.
+         */
+        class CommandList
         {
+            friend class RenderContext;
+
         public:
-            RenderContext();
-            ~RenderContext();
+            CommandList()                       = default;
+            CommandList(const CommandList&)     = delete;
+            CommandList(CommandList&&) noexcept = default;
+            ~CommandList()                      = default;
+
+            CommandList& operator=(const CommandList&)     = delete;
+            CommandList& operator=(CommandList&&) noexcept = default;
+
+            CommandList& setViewport(const Rect2D& rect);
+            CommandList& setScissor(const Rect2D& rect);
+
+            CommandList& bindGraphicsPipeline(const GraphicsPipeline& gp);
+            CommandList& bindImage(GLuint unit, const Texture&, GLint mipLevel, GLenum access);
+            CommandList& bindTexture(GLuint unit, const Texture&, std::optional<GLuint> samplerId = {});
+            CommandList& bindUniformBuffer(GLuint index, const UniformBuffer&);
+            CommandList& bindStorageBuffer(GLuint index, const StorageBuffer&);
+            CommandList& bindMeshPrimitiveMaterialBuffer(GLuint index, const resource::MeshPrimitive& meshPrimitive);
+            CommandList& bindMeshPrimitiveTextures(GLuint                         startUnit,
+                                                   const resource::MeshPrimitive& meshPrimitive,
+                                                   std::optional<GLuint>          samplerId = {});
+
+            CommandList& setUniform1f(std::string_view name, float);
+            CommandList& setUniform1i(std::string_view name, int32_t);
+            CommandList& setUniform1ui(std::string_view name, uint32_t);
+
+            CommandList& setUniformVec2(std::string_view name, const glm::vec2&);
+            CommandList& setUniformVec3(std::string_view name, const glm::vec3&);
+            CommandList& setUniformVec4(std::string_view name, const glm::vec4&);
+
+            CommandList& setUniformMat3(std::string_view name, const glm::mat3&);
+            CommandList& setUniformMat4(std::string_view name, const glm::mat4&);
+
+            CommandList& dispatch(GLuint computeProgram, const glm::uvec3& numGroups);
+
+            CommandList& drawFullScreenTriangle();
+            CommandList& drawCube();
+            CommandList& draw(OptionalReference<const VertexBuffer> vertexBuffer,
+                              OptionalReference<const IndexBuffer>  indexBuffer,
+                              const GeometryInfo&                   geometryInfo,
+                              uint32_t                              numInstances = 1);
+            CommandList& drawMeshPrimitive(const resource::MeshPrimitive& meshPrimitive);
+
+            // Drops all recorded commands but keeps the allocated storage for re-recording.
+            void reset();
+            void reserve(std::size_t numBytes);
+
+            bool        empty() const;
+            uint32_t    getNumCommands() const;
+            std::size_t getSize() const;
 
-            RenderContext& setViewport(const Rect2D& rect);
-            static Rect2D  getViewport();
+        private:
+            struct CommandHeader
+            {
+                CommandType type;
+                uint8_t     reserved {0};
+                uint16_t    nameLength {0};
+                uint32_t    payloadSize {0};
+            };
 
-            RenderContext& setScissor(const Rect2D& rect);
+            template<typename T>
+            CommandList& push(CommandType, const T& payload, std::string_view name = {});
 
-            static Buffer       createBuffer(GLsizeiptr size, const void* data = nullptr);
-            static VertexBuffer createVertexBuffer(GLsizei stride, int64_t capacity, const void* data = nullptr);
-            static IndexBuffer  createIndexBuffer(IndexType, int64_t capacity, const void* data = nullptr);
+        private:
+            std::vector<std::byte> m_Stream;
+            uint32_t               m_NumCommands {0};
+        };
 
-            GLuint getVertexArray(const VertexAttributes&);
+        struct FrameTimeSample
+        {
+            uint64_t frameIndex {0};
+            float    frameMs {0.0f};   // present to present
+            float    cpuMs {0.0f};     // beginFrame to present
+            float    gpuMs {-1.0f};    // GPU time from beginFrame to present, negative until resolved (a few frames)
+            float    presentMs {0.0f}; // Time spent inside present() (swap + frame pacing)
+        };
 
-            static GLuint createGraphicsProgram(const std::string&                vertSource,
-                                                const std::string&                fragSource,
-                                                const std::optional<std::string>& geomSource = std::nullopt);
+        struct FrameTimeSummary
+        {
+            float mean {0.0f};
+            float p50 {0.0f};
+            float p95 {0.0f};
+            float p99 {0.0f};
+            float max {0.0f};
+        };
 
-            static GLuint createComputeProgram(const std::string& compSource);
+        struct FrameStatsReport
+        {
+            uint32_t         numFrames {0};
+            FrameTimeSummary frame {};
+            FrameTimeSummary cpu {};
+            FrameTimeSummary gpu {};
+            FrameTimeSummary present {};
+            uint32_t         numStutters {0}; // Frames taking longer than stutterFactor x median frame time
+        };
 
-            static Texture
-            createTexture2D(Extent2D extent, PixelFormat, uint32_t numMipLevels = 1u, uint32_t numLayers = 0u);
-            static Texture createTexture3D(Extent2D, uint32_t depth, PixelFormat);
-            static Texture
-            createCubemap(uint32_t size, PixelFormat, uint32_t numMipLevels = 1u, uint32_t numLayers = 0u);
+        /**
+         * @brief Records CPU, GPU and present times of the last N frames (ring buffer) and summarizes them as
+         * percentiles. Fed by renderer::beginFrame / renderer::present.
+         *
+         */
+        class FrameStatsRecorder
+        {
+        public:
+            static constexpr uint32_t kNumGpuQueryFrames = 4;
 
-            RenderContext& generateMipmaps(Texture&);
+            FrameStatsRecorder()                          = default;
+            FrameStatsRecorder(const FrameStatsRecorder&) = delete;
+            FrameStatsRecorder(FrameStatsRecorder&&)      = delete;
 
-            RenderContext& setupSampler(Texture&, const SamplerInfo&);
-            static GLuint  createSampler(const SamplerInfo&);
+            FrameStatsRecorder& operator=(const FrameStatsRecorder&) = delete;
+            FrameStatsRecorder& operator=(FrameStatsRecorder&&)      = delete;
 
-            RenderContext& clear(Texture&);
-            // Upload Texture2D
-            RenderContext& upload(Texture&, GLint mipLevel, glm::uvec2 dimensions, const ImageData&);
-            // Upload Cubemap face
-            RenderContext& upload(Texture&, GLint mipLevel, GLint face, glm::uvec2 dimensions, const ImageData&);
-            RenderContext&
-            upload(Texture&, GLint mipLevel, const glm::uvec3& dimensions, GLint face, GLsizei layer, const ImageData&);
+            void init(uint32_t capacity = 1024);
+            void shutdown();
 
-            RenderContext& clear(Buffer&);
-            RenderContext& upload(Buffer&, GLintptr offset, GLsizeiptr size, const void* data);
-            static void*   map(Buffer&);
-            RenderContext& unmap(Buffer&);
+            void beginFrame();
+            void beginPresent();
+            void endPresent();
 
-            RenderContext& destroy(Buffer&);
-            RenderContext& destroy(Texture&);
-            RenderContext& destroy(GraphicsPipeline&);
+            // Duration of the last frame in seconds
+            float getDeltaTime() const { return m_DeltaTime; }
 
-            RenderContext& dispatch(GLuint computeProgram, const glm::uvec3& numGroups);
+            // Oldest first
+            std::vector<FrameTimeSample> getSamples() const;
+            FrameStatsReport             getReport() const;
 
-            GLuint         beginRendering(const RenderingInfo& info);
-            RenderContext& beginRendering(const Rect2D&            area,
-                                          std::optional<glm::vec4> clearColor   = {},
-                                          std::optional<float>     clearDepth   = {},
-                                          std::optional<int>       clearStencil = {});
-            RenderContext& endRendering(GLuint frameBufferID);
+            void setStutterFactor(float factor) { m_StutterFactor = factor; }
 
-            RenderContext& setUniform1f(const std::string& name, float);
-            RenderContext& setUniform1i(const std::string& name, int32_t);
-            RenderContext& setUniform1ui(const std::string& name, uint32_t);
+            std::string exportCsv() const;
+            std::string exportJson() const;
+            // Format picked from the extension (.csv or .json)
+            bool exportToFile(const std::filesystem::path& filePath) const;
+            void setExportOnExit(const std::filesystem::path& filePath) { m_ExitExportPath = filePath; }
 
-            RenderContext& setUniformVec2(const std::string& name, const glm::vec2&);
-            RenderContext& setUniformVec3(const std::string& name, const glm::vec3&);
-            RenderContext& setUniformVec4(const std::string& name, const glm::vec4&);
+        private:
+            void resolveGpuTimes();
 
-            RenderContext& setUniformMat3(const std::string& name, const glm::mat3&);
-            RenderContext& setUniformMat4(const std::string& name, const glm::mat4&);
+        private:
+            struct GpuQueries
+            {
+                GLuint   begin {GL_NONE};
+                GLuint   end {GL_NONE};
+                uint64_t frameIndex {0};
+                bool     pending {false};
+            };
 
-            RenderContext& bindGraphicsPipeline(const GraphicsPipeline& gp);
-            RenderContext& bindImage(GLuint unit, const Texture&, GLint mipLevel, GLenum access);
+            std::vector<FrameTimeSample> m_Samples;
+            uint32_t                     m_Capacity {0};
+            uint64_t                     m_FrameIndex {0};
+
+            std::array<GpuQueries, kNumGpuQueryFrames> m_GpuQueries {};
+
+            time::TimePoint m_FrameBegin {};
+            time::TimePoint m_PresentBegin {};
+            time::TimePoint m_LastPresentEnd {};
+            FrameTimeSample m_Current {};
+            float           m_DeltaTime {0.0f};
+            float           m_StutterFactor {2.0f};
+
+            std::filesystem::path m_ExitExportPath;
+        };
+
+        enum class GpuMemoryCategory : uint8_t
+        {
+            eOther = 0,
+            eGeometry,
+            eMaterialTextures,
+            eTransientTargets,
+            eUniforms,
+
+            eCount
+        };
+
+        inline constexpr auto kNumGpuMemoryCategories = static_cast<size_t>(GpuMemoryCategory::eCount);
+
+        // Bytes per texel as commonly stored by drivers (3-component 8/16-bit and 24-bit depth formats are padded)
+        inline constexpr uint32_t getBytesPerPixel(PixelFormat pixelFormat)
+        {
+            switch (pixelFormat)
+            {
+                case PixelFormat::eR8_UNorm:
+                    return 1;
+                case PixelFormat::eDepth16:
+                case PixelFormat::eR16F:
+                    return 2;
+                case PixelFormat::eR32I:
+                case PixelFormat::eRGB8_UNorm:
+                case PixelFormat::eRGBA8_UNorm:
+                case PixelFormat::eRGB8_SNorm:
+                case PixelFormat::eRGBA8_SNorm:
+                case PixelFormat::eRG16F:
+                case PixelFormat::eDepth24:
+                case PixelFormat::eDepth32F:
+                    return 4;
+                case PixelFormat::eRGB16F:
+                case PixelFormat::eRGBA16F:
+                    return 8;
+                case PixelFormat::eRGB32F:
+                    return 12;
+                case PixelFormat::eRGBA32F:
+                case PixelFormat::eRGBA32UI:
+                    return 16;
+                default:
+                    return 0;
+            }
+        }
+
+        inline constexpr uint64_t calcTextureMemorySize(PixelFormat pixelFormat,
+                                                        Extent2D    extent,
+                                                        uint32_t    depth,
+                                                        uint32_t    numFaces,
+                                                        uint32_t    numMipLevels,
+                                                        uint32_t    numLayers)
+        {
+            uint64_t size {0};
+            for (uint32_t level {0}; level < numMipLevels; ++level)
+            {
+                const uint64_t width  = std::max(extent.width >> level, 1u);
+                const uint64_t height = std::max(extent.height >> level, 1u);
+                const uint64_t slices = depth > 0 ? std::max(depth >> level, 1u) : 1u;
+                size += width * height * slices;
+            }
+            return size * getBytesPerPixel(pixelFormat) * std::max(numFaces, 1u) * std::max(numLayers, 1u);
+        }
+
+        static_assert(calcTextureMemorySize(PixelFormat::eRGBA8_UNorm, {4, 4}, 0, 1, 3, 0) == (16 + 4 + 1) * 4);
+
+        // Tags GPU allocations made by the calling thread while alive. A non-overriding scope only applies when no
+        // other scope is active (used internally for per-type defaults).
+        class GpuMemoryScope
+        {
+        public:
+            explicit GpuMemoryScope(GpuMemoryCategory category, bool override = true);
+            ~GpuMemoryScope();
+
+            GpuMemoryScope(const GpuMemoryScope&)            = delete;
+            GpuMemoryScope& operator=(const GpuMemoryScope&) = delete;
+
+        private:
+            std::optional<GpuMemoryCategory> m_Previous;
+        };
+
+        struct GpuMemoryStats
+        {
+            std::array<uint64_t, kNumGpuMemoryCategories> bytes {};
+            std::array<uint32_t, kNumGpuMemoryCategories> numAllocations {};
+
+            uint64_t totalBytes {0};
+            uint64_t peakBytes {0};
+        };
+
+        /**
+         * @brief Accounts the GPU memory of every buffer and texture created through RenderContext, by category.
+         * Sizes are computed from the creation parameters, not queried from the driver. GL thread only.
+         *
+         */
+        class GpuMemoryTracker
+        {
+        public:
+            void onBufferCreated(GLuint id, uint64_t size);
+            void onTextureCreated(GLuint id, uint64_t size);
+            void onBufferDestroyed(GLuint id);
+            void onTextureDestroyed(GLuint id);
+
+            // Warns once every time the category goes over its budget
+            void setBudget(GpuMemoryCategory category, std::optional<uint64_t> bytes);
+            void setTotalBudget(std::optional<uint64_t> bytes);
+
+            const GpuMemoryStats& getStats() const { return m_Stats; }
+
+            static const char* getCategoryName(GpuMemoryCategory category);
+
+        private:
+            struct Allocation
+            {
+                uint64_t          size {0};
+                GpuMemoryCategory category {GpuMemoryCategory::eOther};
+            };
+
+            void onAllocated(uint64_t key, uint64_t size);
+            void onFreed(uint64_t key);
+            void checkBudgets(GpuMemoryCategory category);
+
+        private:
+            std::unordered_map<uint64_t, Allocation> m_Allocations;
+            GpuMemoryStats                           m_Stats;
+
+            std::array<std::optional<uint64_t>, kNumGpuMemoryCategories> m_Budgets {};
+            std::optional<uint64_t>                                      m_TotalBudget {};
+            std::array<bool, kNumGpuMemoryCategories>                    m_OverBudget {};
+            bool                                                         m_OverTotalBudget {false};
+        };
+
+        // Per-frame counters of RenderContext, only collected with VGFW_ENABLE_RENDER_STATS (all zero otherwise)
+        struct RenderStats
+        {
+            uint32_t drawCalls {0};
+            uint32_t dispatches {0};
+            uint64_t instances {0};
+            uint64_t triangles {0};
+            uint64_t indices {0};
+
+            uint32_t pipelineBinds {0};
+            uint32_t programBinds {0};
+            uint32_t vaoBinds {0};
+            uint32_t textureBinds {0};
+            uint32_t bufferBinds {0};
+            uint32_t redundantBindsSkipped {0};
+
+            uint64_t bufferUploadBytes {0};
+            uint64_t textureUploadBytes {0};
+
+            uint32_t framebufferCreations {0};
+        };
+
+        /**
+         * @brief 32-bit generational handle into a SlotMap.
+         *
+         * The low 20 bits index a slot, the high 12 bits hold the slot's generation when the value was inserted.
+         * Generations start at 1, so a zero handle is always null.
+         */
+        template<typename T>
+        class Handle
+        {
+        public:
+            static constexpr uint32_t kIndexBits     = 20;
+            static constexpr uint32_t kMaxIndex      = (1u << kIndexBits) - 1;
+            static constexpr uint32_t kMaxGeneration = (1u << (32 - kIndexBits)) - 1;
+
+            Handle() = default;
+            Handle(uint32_t index, uint32_t generation) : m_Value {(generation << kIndexBits) | index} {}
+
+            uint32_t getIndex() const { return m_Value & kMaxIndex; }
+            uint32_t getGeneration() const { return m_Value >> kIndexBits; }
+            uint32_t getValue() const { return m_Value; }
+
+            explicit operator bool() const { return m_Value != 0; }
+
+            // clang-format off
+            auto operator<=> (const Handle&) const = default;
+            // clang-format on
+
+        private:
+            uint32_t m_Value {0};
+        };
+
+        /**
+         * @brief Generational slot map with stable storage.
+         *
+         * Values live in fixed-size pages that never move, so references stay valid until the value is removed.
+         * Slot metadata is kept in one dense array and freed slots are reused through a free list. Removing a value
+         * bumps the generation of its slot, which turns every outstanding handle to it stale: get returns nullptr and
+         * operator[] asserts in debug builds.
+         */
+        template<typename T>
+        class SlotMap
+        {
+        public:
+            static constexpr uint32_t kPageSize = 256;
+
+            Handle<T> insert(T&& value)
+            {
+                auto index = m_FreeHead;
+                if (index != kNoSlot)
+                {
+                    m_FreeHead = m_Slots[index].nextFree;
+                }
+                else
+                {
+                    index = static_cast<uint32_t>(m_Slots.size());
+                    assert(index <= Handle<T>::kMaxIndex);
+                    if (index % kPageSize == 0)
+                        m_Pages.push_back(std::make_unique<Page>());
+                    m_Slots.emplace_back();
+                }
+
+                auto& slot = m_Slots[index];
+                slot.alive = true;
+                at(index)  = std::move(value);
+                ++m_Size;
+                return {index, slot.generation};
+            }
+
+            // Moves the value out and invalidates every handle to it
+            T remove(Handle<T> handle)
+            {
+                assert(contains(handle));
+                const auto index = handle.getIndex();
+                auto&      slot  = m_Slots[index];
+                slot.alive       = false;
+                slot.generation  = slot.generation == Handle<T>::kMaxGeneration ? 1 : slot.generation + 1;
+                slot.nextFree    = std::exchange(m_FreeHead, index);
+                --m_Size;
+                return std::exchange(at(index), T {});
+            }
+
+            bool contains(Handle<T> handle) const
+            {
+                const auto index = handle.getIndex();
+                return handle && index < m_Slots.size() && m_Slots[index].alive &&
+                       m_Slots[index].generation == handle.getGeneration();
+            }
+
+            T*       get(Handle<T> handle) { return contains(handle) ? &at(handle.getIndex()) : nullptr; }
+            const T* get(Handle<T> handle) const { return contains(handle) ? &at(handle.getIndex()) : nullptr; }
+
+            T& operator[](Handle<T> handle)
+            {
+                assert(contains(handle));
+                return at(handle.getIndex());
+            }
+            const T& operator[](Handle<T> handle) const
+            {
+                assert(contains(handle));
+                return at(handle.getIndex());
+            }
+
+            uint32_t size() const { return m_Size; }
+            bool     empty() const { return m_Size == 0; }
+
+            // Visits the live values in slot order: f(Handle<T>, T&)
+            template<typename F>
+            void forEach(F&& f)
+            {
+                for (uint32_t i = 0; i < m_Slots.size(); ++i)
+                {
+                    if (m_Slots[i].alive)
+                        f(Handle<T> {i, m_Slots[i].generation}, at(i));
+                }
+            }
+            template<typename F>
+            void forEach(F&& f) const
+            {
+                for (uint32_t i = 0; i < m_Slots.size(); ++i)
+                {
+                    if (m_Slots[i].alive)
+                        f(Handle<T> {i, m_Slots[i].generation}, at(i));
+                }
+            }
+
+        private:
+            static constexpr uint32_t kNoSlot = ~0u;
+
+            struct Slot
+            {
+                uint32_t generation {1};
+                uint32_t nextFree {kNoSlot};
+                bool     alive {false};
+            };
+            using Page = std::array<T, kPageSize>;
+
+            T&       at(uint32_t index) { return (*m_Pages[index / kPageSize])[index % kPageSize]; }
+            const T& at(uint32_t index) const { return (*m_Pages[index / kPageSize])[index % kPageSize]; }
+
+        private:
+            std::vector<Slot>                  m_Slots;
+            std::vector<std::unique_ptr<Page>> m_Pages;
+            uint32_t                           m_FreeHead {kNoSlot};
+            uint32_t                           m_Size {0};
+        };
+
+        // Sampler object owned by the RenderContext registry
+        struct Sampler
+        {
+            GLuint id {GL_NONE};
+        };
+
+        using BufferHandle       = Handle<Buffer>;
+        using VertexBufferHandle = Handle<VertexBuffer>;
+        using IndexBufferHandle  = Handle<IndexBuffer>;
+        using GpuTextureHandle   = Handle<Texture>; // io::TextureHandle is the asynchronously loaded asset
+
+        class RenderContext
+        {
+        public:
+            RenderContext();
+            ~RenderContext();
+
+            // Counters of the last completed frame
+            const RenderStats& getFrameStats() const { return m_LastFrameStats; }
+            // Number of frames completed by collectGarbage
+            uint64_t getFrameIndex() const { return m_FrameIndex; }
+            // Closes the current frame's counters, called by renderer::present
+            void flushFrameStats();
+
+            RenderContext& setViewport(const Rect2D& rect);
+            static Rect2D  getViewport();
+
+            RenderContext& setScissor(const Rect2D& rect);
+
+            static Buffer       createBuffer(GLsizeiptr size, const void* data = nullptr);
+            static VertexBuffer createVertexBuffer(GLsizei stride, int64_t capacity, const void* data = nullptr);
+            static IndexBuffer  createIndexBuffer(IndexType, int64_t capacity, const void* data = nullptr);
+
+            GLuint getVertexArray(const VertexAttributes&);
+            // Returns the VAO cached on the format, only the first call per format does a lookup
+            GLuint getVertexArray(const VertexFormat&);
+
+            static GLuint createGraphicsProgram(const std::string&                vertSource,
+                                                const std::string&                fragSource,
+                                                const std::optional<std::string>& geomSource = std::nullopt);
+
+            static GLuint createComputeProgram(const std::string& compSource);
+
+            static Texture
+            createTexture2D(Extent2D extent, PixelFormat, uint32_t numMipLevels = 1u, uint32_t numLayers = 0u);
+            static Texture createTexture3D(Extent2D, uint32_t depth, PixelFormat);
+            static Texture
+            createCubemap(uint32_t size, PixelFormat, uint32_t numMipLevels = 1u, uint32_t numLayers = 0u);
+
+            RenderContext& generateMipmaps(Texture&);
+
+            RenderContext& setupSampler(Texture&, const SamplerInfo&);
+            static GLuint  createSampler(const SamplerInfo&);
+
+            RenderContext& clear(Texture&);
+            // Upload Texture2D
+            RenderContext& upload(Texture&, GLint mipLevel, glm::uvec2 dimensions, const ImageData&);
+            // Upload Cubemap face
+            RenderContext& upload(Texture&, GLint mipLevel, GLint face, glm::uvec2 dimensions, const ImageData&);
+            RenderContext&
+            upload(Texture&, GLint mipLevel, const glm::uvec3& dimensions, GLint face, GLsizei layer, const ImageData&);
+            // Read back a whole mip level, blocks until the GPU is done with the texture
+            static void download(const Texture&, GLint mipLevel, GLenum format, GLenum dataType, GLsizei size, void*);
+
+            RenderContext& clear(Buffer&);
+            RenderContext& upload(Buffer&, GLintptr offset, GLsizeiptr size, const void* data);
+            static void*   map(Buffer&);
+            RenderContext& unmap(Buffer&);
+
+            RenderContext& destroy(Buffer&);
+            RenderContext& destroy(Texture&);
+            RenderContext& destroy(GraphicsPipeline&);
+            RenderContext& destroy(Sampler&);
+
+            // Registry of resources owned by the context, referenced by generational handles
+            template<typename T>
+            Handle<T> add(T&& resource)
+            {
+                return getRegistry<T>().insert(std::move(resource));
+            }
+
+            // Null handles resolve to nullptr, stale ones too (and assert in debug builds)
+            template<typename T>
+            T* get(Handle<T> handle)
+            {
+                auto* resource = getRegistry<T>().get(handle);
+                assert(resource || !handle);
+                return resource;
+            }
+
+            // Invalidates the handle right away, the GL objects are destroyed once no frame in flight can use them
+            template<typename T>
+            void release(Handle<T> handle)
+            {
+                if (getRegistry<T>().contains(handle))
+                    m_PendingReleases.push_back(
+                        {m_FrameIndex, RegisteredResource {std::in_place_type<T>, getRegistry<T>().remove(handle)}});
+            }
+
+            template<typename T>
+            const SlotMap<T>& getResources() const
+            {
+                return std::get<SlotMap<T>>(m_Registry);
+            }
+
+            // Destroys the released resources older than the frames in flight, called by renderer::present
+            void collectGarbage(uint32_t numFramesInFlight);
+            // Destroys every registry resource right away, called by renderer::shutdown
+            void destroyResources();
+
+            RenderContext& dispatch(GLuint computeProgram, const glm::uvec3& numGroups);
+
+            GLuint         beginRendering(const RenderingInfo& info);
+            GLuint         beginRendering(const FrameRenderingInfo& info);
+            RenderContext& beginRendering(const Rect2D&            area,
+                                          std::optional<glm::vec4> clearColor   = {},
+                                          std::optional<float>     clearDepth   = {},
+                                          std::optional<int>       clearStencil = {});
+            RenderContext& endRendering(GLuint frameBufferID);
+
+            RenderContext& setUniform1f(const std::string& name, float);
+            RenderContext& setUniform1i(const std::string& name, int32_t);
+            RenderContext& setUniform1ui(const std::string& name, uint32_t);
+
+            RenderContext& setUniformVec2(const std::string& name, const glm::vec2&);
+            RenderContext& setUniformVec3(const std::string& name, const glm::vec3&);
+            RenderContext& setUniformVec4(const std::string& name, const glm::vec4&);
+
+            RenderContext& setUniformMat3(const std::string& name, const glm::mat3&);
+            RenderContext& setUniformMat4(const std::string& name, const glm::mat4&);
+
+            RenderContext& bindGraphicsPipeline(const GraphicsPipeline& gp);
+            RenderContext& bindImage(GLuint unit, const Texture&, GLint mipLevel, GLenum access);
             RenderContext& bindTexture(GLuint unit, const Texture&, std::optional<GLuint> samplerId = {});
             RenderContext& bindUniformBuffer(GLuint index, const UniformBuffer&);
             RenderContext& bindStorageBuffer(GLuint index, const StorageBuffer&);
@@ -977,6 +2594,9 @@ namespace vgfw
                                 uint32_t                              numInstances = 1);
             RenderContext& drawMeshPrimitive(const resource::MeshPrimitive& meshPrimitive);
 
+            // Replays a recorded command list, must be called on the GL thread.
+            RenderContext& execute(const CommandList& commandList);
+
             struct ResourceDeleter
             {
                 void operator()(auto* ptr)
@@ -989,6 +2609,10 @@ namespace vgfw
             };
 
         private:
+            GLuint beginRendering(const Rect2D&                        area,
+                                  std::span<const AttachmentInfo>      colorAttachments,
+                                  const std::optional<AttachmentInfo>& depthAttachment);
+
             static GLuint createVertexArray(const VertexAttributes&);
 
             static Texture createImmutableTexture(Extent2D,
@@ -1020,12 +2644,257 @@ namespace vgfw
 
             void setBlendState(GLuint index, const BlendState&);
 
+            template<typename T>
+            SlotMap<T>& getRegistry()
+            {
+                return std::get<SlotMap<T>>(m_Registry);
+            }
+
         private:
             bool             m_RenderingStarted = false;
             GraphicsPipeline m_CurrentPipeline;
 
+            // Last pipeline bound through bindGraphicsPipeline, reset when a state is changed outside of it
+            uint32_t                        m_BoundPipelineId {0};
+            std::optional<PipelineStateKey> m_BoundStateKey;
+
+            RenderStats m_Stats;
+            RenderStats m_LastFrameStats;
+
             GLuint                                  m_DummyVAO {GL_NONE};
             std::unordered_map<std::size_t, GLuint> m_VertexArrays;
+
+            // Tells the VAOs cached on vertex formats apart from the ones of a previous context
+            inline static std::atomic<uint32_t> s_NextId {1};
+            const uint32_t                      m_Id {s_NextId++};
+
+            using RegisteredResource =
+                std::variant<Buffer, VertexBuffer, IndexBuffer, Texture, GraphicsPipeline, Sampler>;
+
+            struct PendingRelease
+            {
+                uint64_t           frameIndex;
+                RegisteredResource resource;
+            };
+
+            std::tuple<SlotMap<Buffer>,
+                       SlotMap<VertexBuffer>,
+                       SlotMap<IndexBuffer>,
+                       SlotMap<Texture>,
+                       SlotMap<GraphicsPipeline>,
+                       SlotMap<Sampler>>
+                                        m_Registry;
+            std::vector<PendingRelease> m_PendingReleases;
+            uint64_t                    m_FrameIndex {0};
+        };
+
+        enum class TraceRecordType : uint8_t
+        {
+            // Resource snapshots, created by the player when the trace is loaded
+            eBuffer = 0,
+            eTexture,
+            eProgram,
+            eSampler,
+            eVertexArray,
+
+            // Commands, replayed in order
+            eEndFrame,
+            eSetViewport,
+            eSetScissor,
+            eBindGraphicsPipeline,
+            eBindImage,
+            eBindTexture,
+            eBindUniformBuffer,
+            eBindStorageBuffer,
+            eSetUniform,
+            eDispatch,
+            eDraw,
+            eBeginRendering,
+            eBeginDefaultRendering,
+            eEndRendering,
+            eUploadBuffer,
+            eUploadTexture,
+            eClearBuffer,
+            eClearTexture,
+            eGenerateMipmaps,
+            eSetupSampler,
+        };
+
+        enum class TraceBufferKind : uint8_t
+        {
+            eBuffer = 0,
+            eVertexBuffer,
+            eIndexBuffer,
+        };
+
+        /**
+         * @brief Serializes every RenderContext call of N frames into a trace file, together with a snapshot of each
+         * buffer, texture, program, sampler and vertex layout the calls reference. TracePlayer (tools/vgfw-replay)
+         * replays the trace without the application or its assets.
+         *
+         * Resources are snapshotted (read back from GL) on first reference during the capture, so capturing stalls
+         * and the captured frames are not representative. Requires VGFW_ENABLE_TRACE_CAPTURE: shader sources, sampler
+         * infos and vertex layouts are registered at creation, before a capture may start. Calls that bypass
+         * RenderContext (ImGui, raw GL) are not captured.
+         */
+        class TraceCapture
+        {
+        public:
+            static constexpr uint32_t kMagic   = 0x52544756; // "VGTR"
+            static constexpr uint32_t kVersion = 1;
+
+            TraceCapture()                    = default;
+            TraceCapture(const TraceCapture&) = delete;
+            TraceCapture(TraceCapture&&)      = delete;
+
+            TraceCapture& operator=(const TraceCapture&) = delete;
+            TraceCapture& operator=(TraceCapture&&)      = delete;
+
+            // Captures the numFrames frames following the next renderer::present and then writes the trace file
+            bool capture(const std::filesystem::path& filePath, uint32_t numFrames);
+            bool isCapturing() const { return m_Active; }
+
+            // Called by renderer::present
+            void onPresent();
+
+            void onCreateGraphicsProgram(GLuint                            program,
+                                         const std::string&                vertSource,
+                                         const std::string&                fragSource,
+                                         const std::optional<std::string>& geomSource);
+            void onCreateComputeProgram(GLuint program, const std::string& compSource);
+            void onCreateSampler(GLuint sampler, const SamplerInfo&);
+            void onCreateVertexArray(GLuint vao, const VertexAttributes&);
+            void onDestroyProgram(GLuint program);
+            void onDestroy(const Buffer&);
+            void onDestroy(const Texture&);
+
+            void onSetViewport(const Rect2D&);
+            void onSetScissor(const Rect2D&);
+            void onBindGraphicsPipeline(const GraphicsPipeline&);
+            void onBindImage(GLuint unit, const Texture&, GLint mipLevel, GLenum access);
+            void onBindTexture(GLuint unit, const Texture&, std::optional<GLuint> samplerId);
+            void onBindBuffer(TraceRecordType, GLuint index, const Buffer&);
+            void onSetUniform(CommandType, const std::string& name, const void* value, uint32_t size);
+            void onDispatch(GLuint computeProgram, const glm::uvec3& numGroups);
+            void onDraw(const VertexBuffer*, const IndexBuffer*, const GeometryInfo&, uint32_t numInstances);
+            void onBeginRendering(const Rect2D&                        area,
+                                  std::span<const AttachmentInfo>      colorAttachments,
+                                  const std::optional<AttachmentInfo>& depthAttachment);
+            void onBeginRendering(const Rect2D&            area,
+                                  std::optional<glm::vec4> clearColor,
+                                  std::optional<float>     clearDepth,
+                                  std::optional<int>       clearStencil);
+            void onEndRendering();
+
+            void onUpload(const Buffer&, GLintptr offset, GLsizeiptr size, const void* data);
+            void onUpload(const Texture&,
+                          GLint             mipLevel,
+                          const glm::uvec3& dimensions,
+                          GLint             face,
+                          GLsizei           layer,
+                          const ImageData&);
+            void onUnmap(const Buffer&);
+            void onClear(const Buffer&);
+            void onClear(const Texture&);
+            void onGenerateMipmaps(const Texture&);
+            void onSetupSampler(const Texture&, const SamplerInfo&);
+
+        private:
+            // @return Trace handle of the resource (0 for none), snapshotting it on first reference
+            uint32_t refBuffer(const Buffer&,
+                               TraceBufferKind kind              = TraceBufferKind::eBuffer,
+                               uint32_t        strideOrIndexType = 0);
+            uint32_t refTexture(const Texture&);
+            uint32_t refProgram(GLuint program);
+            uint32_t refSampler(GLuint sampler);
+            uint32_t refVertexArray(GLuint vao);
+
+            std::size_t beginRecord(TraceRecordType);
+            void        endRecord(std::size_t recordOffset);
+
+            template<typename T>
+            void write(const T& v);
+            void writeBytes(const void* data, std::size_t size);
+            void writeString(std::string_view str);
+
+            void finish();
+
+        private:
+            using ShaderSources = std::vector<std::pair<GLenum, std::string>>;
+
+            std::unordered_map<GLuint, ShaderSources>    m_ProgramSources;
+            std::unordered_map<GLuint, SamplerInfo>      m_SamplerInfos;
+            std::unordered_map<GLuint, VertexAttributes> m_VertexLayouts;
+
+            std::filesystem::path m_FilePath;
+            uint32_t              m_NumPendingFrames {0};
+            uint32_t              m_NumFrames {0};
+            bool                  m_Active {false};
+            Extent2D              m_Extent {};
+
+            // GL name to trace handle, per capture
+            std::unordered_map<GLuint, uint32_t> m_Buffers;
+            std::unordered_map<GLuint, uint32_t> m_Textures;
+            std::unordered_map<GLuint, uint32_t> m_Programs;
+            std::unordered_map<GLuint, uint32_t> m_Samplers;
+            std::unordered_map<GLuint, uint32_t> m_VertexArrays;
+            uint32_t                             m_NextHandle {1};
+
+            std::vector<std::byte> m_Stream;
+        };
+
+        /**
+         * @brief Replays a trace written by TraceCapture through a RenderContext.
+         *
+         * All resource snapshots are created up front by createResources and live until destroyResources, so frames
+         * can be replayed repeatedly (in any order) for benchmarking. Destroy records are ignored.
+         */
+        class TracePlayer
+        {
+        public:
+            TracePlayer()                   = default;
+            TracePlayer(const TracePlayer&) = delete;
+            TracePlayer(TracePlayer&&)      = delete;
+            ~TracePlayer();
+
+            TracePlayer& operator=(const TracePlayer&) = delete;
+            TracePlayer& operator=(TracePlayer&&)      = delete;
+
+            // Reads and indexes the trace, does not touch GL (the extent is known before creating a window)
+            bool load(const std::filesystem::path& filePath);
+
+            // Must be called on the GL thread, destroyResources before the renderer shuts down
+            void createResources(RenderContext&);
+            void destroyResources();
+
+            uint32_t getNumFrames() const { return static_cast<uint32_t>(m_Frames.size()); }
+            Extent2D getExtent() const { return m_Extent; }
+
+            // Must be called on the GL thread, between renderer::beginFrame and renderer::present
+            void replayFrame(uint32_t frameIndex);
+
+        private:
+            void createResource(TraceRecordType, const std::byte* payload, std::size_t size);
+
+            Buffer& getBuffer(uint32_t handle);
+
+        private:
+            RenderContext* m_RenderContext {nullptr};
+
+            std::vector<std::byte>                           m_Data;
+            std::vector<std::size_t>                         m_ResourceRecords; // Offsets into m_Data
+            std::vector<std::pair<std::size_t, std::size_t>> m_Frames;          // [begin, end) offsets into m_Data
+            Extent2D                                         m_Extent {};
+
+            std::unordered_map<uint32_t, Buffer>       m_Buffers;
+            std::unordered_map<uint32_t, VertexBuffer> m_VertexBuffers;
+            std::unordered_map<uint32_t, IndexBuffer>  m_IndexBuffers;
+            std::unordered_map<uint32_t, Texture>      m_Textures;
+            std::unordered_map<uint32_t, GLuint>       m_Programs;
+            std::unordered_map<uint32_t, GLuint>       m_Samplers;
+            std::unordered_map<uint32_t, GLuint>       m_VertexArrays;
+
+            GLuint m_Framebuffer {GL_NONE};
         };
 
         // @return {data type, number of components, normalize}
@@ -1033,6 +2902,8 @@ namespace vgfw
         GLenum                               selectTextureMinFilter(TexelFilter minFilter, MipmapMode mipmapMode);
         GLenum                               getIndexDataType(GLsizei stride);
         GLenum                               getPolygonOffsetCap(PolygonMode polygonMode);
+        uint32_t                             getImageDataPixelSize(const ImageData& imageData);
+        uint64_t                             countTriangles(PrimitiveTopology topology, uint32_t numElements);
 
         namespace framegraph
         {
@@ -1151,12 +3022,21 @@ namespace vgfw
 
         static bool                           g_RendererInit = false;
         static GraphicsContext                g_GraphicsContext;
+        static FramePacer                     g_FramePacer;
+        static LatencyTracker                 g_LatencyTracker;
+        static GpuProfiler                    g_GpuProfiler;
+        static GpuMemoryTracker               g_GpuMemoryTracker;
+        static FrameStatsRecorder             g_FrameStatsRecorder;
+        static TraceCapture                   g_TraceCapture;
         static std::shared_ptr<RenderContext> g_RenderContext = nullptr;
 
         struct RendererInitInfo
         {
             std::shared_ptr<window::Window> window {nullptr};
             bool                            enableImGuiDocking {false};
+            FramePacingInfo                 framePacing {};
+            bool                            trackLatency {false};
+            bool                            enableGpuProfiler {false};
         };
 
         void init(const RendererInitInfo& initInfo);
@@ -1166,8 +3046,14 @@ namespace vgfw
         void shutdown();
         bool isLoaded();
 
-        GraphicsContext& getGraphicsContext();
-        RenderContext&   getRenderContext();
+        GraphicsContext&    getGraphicsContext();
+        RenderContext&      getRenderContext();
+        FramePacer&         getFramePacer();
+        LatencyTracker&     getLatencyTracker();
+        GpuProfiler&        getGpuProfiler();
+        GpuMemoryTracker&   getGpuMemoryTracker();
+        FrameStatsRecorder& getFrameStatsRecorder();
+        TraceCapture&       getTraceCapture();
     } // namespace renderer
 
     namespace resource
@@ -1184,36 +3070,53 @@ namespace vgfw
 
         using PrimitiveMaterial = Material;
 
+        // CPU-side vertex data, allocated from the owner model's arena when created through Model::addMeshPrimitive
         struct MeshRecord
         {
-            std::vector<glm::vec3> positions;
-            std::vector<glm::vec3> normals;
-            std::vector<glm::vec2> texcoords;
-            std::vector<glm::vec4> tangents;
+            using allocator_type = std::pmr::polymorphic_allocator<>;
+
+            std::pmr::vector<glm::vec3> positions;
+            std::pmr::vector<glm::vec3> normals;
+            std::pmr::vector<glm::vec2> texcoords;
+            std::pmr::vector<glm::vec4> tangents;
+
+            MeshRecord() = default;
+            explicit MeshRecord(const allocator_type& allocator) :
+                positions(allocator), normals(allocator), texcoords(allocator), tangents(allocator)
+            {}
         };
 
         struct MeshPrimitive
         {
-            std::string name;
+            using allocator_type = std::pmr::polymorphic_allocator<>;
+
+            MeshPrimitive() = default;
+            // Moved primitives keep their allocator and must not outlive the model that created them
+            explicit MeshPrimitive(const allocator_type& allocator) :
+                name(allocator), record(allocator), indices(allocator), vertices(allocator), textureIndices(allocator)
+            {}
+
+            std::pmr::string name;
 
             uint32_t indexCount {0};
             uint32_t vertexCount {0};
 
             MeshRecord record {};
 
-            std::vector<uint32_t> indices;
-            std::vector<float>    vertices;
+            std::pmr::vector<uint32_t> indices;
+            std::pmr::vector<float>    vertices;
 
             int materialIndex {-1};
 
             std::shared_ptr<renderer::VertexFormat> vertexFormat {nullptr};
 
-            std::shared_ptr<renderer::IndexBuffer>  indexBuffer {nullptr};
-            std::shared_ptr<renderer::VertexBuffer> vertexBuffer {nullptr};
+            // Owned by the RenderContext registry
+            renderer::IndexBufferHandle  indexBuffer {};
+            renderer::VertexBufferHandle vertexBuffer {};
 
-            PrimitiveMaterial                 material {};
-            std::shared_ptr<renderer::Buffer> materialBuffer {nullptr};
-            std::vector<uint32_t>             textureIndices;
+            PrimitiveMaterial          material {};
+            renderer::BufferHandle     materialBuffer {};
+            std::pmr::vector<uint32_t> textureIndices;
 
             math::AABB aabb {};
             glm::mat4  modelMatrix {1.0};
@@ -1224,23 +3127,48 @@ namespace vgfw
             void build(renderer::VertexFormat::Builder& vertexFormatBuilder,
                        const glm::vec3&                 scale,
                        renderer::RenderContext&         rc);
+            void release(renderer::RenderContext& rc);
 
         private:
             friend class renderer::RenderContext;
             void draw(renderer::RenderContext& rc) const;
         };
 
+        /**
+         * @brief Imported model. The CPU data of its mesh primitives (names, records, indices, vertices) is
+         * allocated from a monotonic arena owned by the model, so import allocates in large chunks and
+         * destroying the model frees all of it at once. The GPU buffers of its primitives are released to the
+         * RenderContext that built them when the model is destroyed or reassigned.
+         */
         struct Model
         {
+            Model()                 = default;
+            Model(Model&&) noexcept = default;
+            ~Model();
+
+            Model& operator=(Model&& other) noexcept;
+
             std::vector<MeshPrimitive> meshPrimitives;
 
-            std::vector<vgfw::renderer::Texture*> textures;
-            std::vector<Material>                 materials;
+            std::vector<renderer::GpuTextureHandle> textures; // Owned by the texture cache (io::loadTexture)
+            std::vector<Material>                   materials;
 
             math::AABB aabb;
 
-        private:
-            friend class renderer::RenderContext;
+            // Appends a primitive whose containers allocate from the model's arena
+            MeshPrimitive& addMeshPrimitive();
+
+            std::pmr::memory_resource* getMemoryResource();
+
+            // Releases the mesh buffers, textures stay in the texture cache
+            void release(renderer::RenderContext& rc);
+
+        private:
+            std::unique_ptr<std::pmr::monotonic_buffer_resource> m_Arena;
+            renderer::RenderContext*                             m_RenderContext {nullptr}; // Set by build
+
+            friend struct MeshPrimitive;
+            friend class renderer::RenderContext;
             void bindMeshPrimitiveTextures(uint32_t                 primitiveIndex,
                                            uint32_t                 startUnit,
                                            renderer::RenderContext& rc,
@@ -1248,24 +3176,366 @@ namespace vgfw
         };
     } // namespace resource
 
+    namespace scene
+    {
+        // Slot of a scene node, holds the node's current position in the sorted arrays
+        struct Node
+        {
+            uint32_t index {0};
+        };
+
+        using NodeHandle = renderer::Handle<Node>;
+
+        struct Transform
+        {
+            glm::vec3 translation {0.0f};
+            glm::quat rotation {1.0f, 0.0f, 0.0f, 0.0f};
+            glm::vec3 scale {1.0f};
+
+            glm::mat4 toMatrix() const;
+        };
+
+        /**
+         * @brief Transform hierarchy stored as structure of arrays (local TRS, world matrix, world AABB, dirty flag).
+         *
+         * Nodes are sorted by depth, parents before children, so every level is a contiguous range that only depends
+         * on the level above. update() recomputes the dirty nodes and their descendants one level at a time, each
+         * level split over the job system, and skips the levels where nothing changed.
+         *
+         * Nodes with a mesh primitive are draws. Their world matrices are packed in draw order into a storage buffer
+         * per frame in flight, draw i reads transforms[i]. The buffers are released to the RenderContext that created
+         * them when the scene is destroyed.
+         */
+        class Scene
+        {
+        public:
+            static constexpr uint32_t kNumTransformBuffers = 4;
+            static constexpr uint32_t kUpdateGrainSize     = 1024;
+
+            Scene()                 = default;
+            Scene(const Scene&)     = delete;
+            Scene(Scene&&) noexcept = default;
+            ~Scene()                = default;
+
+            Scene& operator=(const Scene&)     = delete;
+            Scene& operator=(Scene&&) noexcept = default;
+
+            // The world AABB of a node is the AABB of its mesh primitive (a point without one) in world space
+            NodeHandle createNode(NodeHandle                     parent        = {},
+                                  const Transform&               local         = {},
+                                  const resource::MeshPrimitive* meshPrimitive = nullptr);
+            // Creates a node for the model under parent and a child draw for every mesh primitive, the model must
+            // outlive the nodes
+            NodeHandle addModel(const resource::Model& model, NodeHandle parent = {}, const Transform& local = {});
+            // Destroys the node and all of its descendants
+            void destroyNode(NodeHandle node);
+
+            bool     contains(NodeHandle node) const;
+            uint32_t getNumNodes() const;
+            uint32_t getNumLevels() const;
+
+            NodeHandle getParent(NodeHandle node) const;
+
+            void      setLocalTransform(NodeHandle node, const Transform& local);
+            Transform getLocalTransform(NodeHandle node) const;
+
+            // Valid after update
+            const glm::mat4&  getWorldMatrix(NodeHandle node) const;
+            const math::AABB& getWorldAABB(NodeHandle node) const;
+
+            // Sorts new nodes into their level and propagates the dirty transforms, returns the number of nodes updated
+            uint32_t update();
+
+            // The mesh primitive of every draw in transform buffer order, valid after update
+            const std::vector<const resource::MeshPrimitive*>& getDraws() const { return m_DrawMeshes; }
+            // ~0u for nodes without a mesh primitive, valid after update
+            uint32_t getDrawIndex(NodeHandle node) const;
+
+            // Uploads the draw transforms into this frame's storage buffer (skipped when unchanged) and returns it
+            const renderer::StorageBuffer& uploadTransforms(renderer::RenderContext& rc);
+            // Releases the transform buffers before the scene is destroyed, which releases them otherwise
+            void release(renderer::RenderContext& rc);
+
+        private:
+            static constexpr uint32_t kNoParent = ~0u;
+            static constexpr uint32_t kNoDraw   = ~0u;
+
+            uint32_t getIndex(NodeHandle node) const;
+            uint32_t updateNode(uint32_t index);
+
+            // Moves the nodes into the given order of old indices, nodes missing from it are dropped
+            void reorder(const std::vector<uint32_t>& order);
+            // Old indices of the nodes not removed, grouped by level
+            std::vector<uint32_t> sortByLevel(const std::vector<uint8_t>& removed) const;
+
+            struct TransformBuffer
+            {
+                renderer::BufferHandle buffer {};
+                uint64_t               version {0};
+            };
+
+            // Per-frame transform buffers, owned so that moved-from and destroyed scenes release them exactly once
+            struct TransformBufferRing
+            {
+                TransformBufferRing() = default;
+                TransformBufferRing(TransformBufferRing&& other) noexcept { *this = std::move(other); }
+                ~TransformBufferRing() { release(); }
+
+                TransformBufferRing& operator=(TransformBufferRing&& other) noexcept;
+
+                void release();
+
+                renderer::RenderContext*                          renderContext {nullptr}; // Set by the first upload
+                std::array<TransformBuffer, kNumTransformBuffers> buffers {};
+            };
+
+        private:
+            renderer::SlotMap<Node> m_Nodes;
+
+            std::vector<NodeHandle> m_Handles;
+            std::vector<uint32_t>   m_Parents;
+            std::vector<uint32_t>   m_Levels;
+            std::vector<glm::vec3>  m_Translations;
+            std::vector<glm::quat>  m_Rotations;
+            std::vector<glm::vec3>  m_Scales;
+            std::vector<math::AABB> m_LocalAABBs;
+            std::vector<glm::mat4>  m_WorldMatrices;
+            std::vector<math::AABB> m_WorldAABBs;
+            std::vector<uint8_t>    m_Dirty;
+            std::vector<uint32_t>   m_UpdateStamps; // Last update that recomputed the node
+            std::vector<uint32_t>   m_DrawIndices;
+
+            std::vector<uint32_t> m_LevelOffsets {0}; // Level i is [m_LevelOffsets[i], m_LevelOffsets[i + 1])
+            std::vector<uint32_t> m_NumDirtyPerLevel;
+            bool                  m_TopologyChanged {false};
+            uint32_t              m_UpdateCount {0};
+
+            std::vector<const resource::MeshPrimitive*> m_DrawMeshes;
+            std::vector<glm::mat4>                      m_DrawTransforms;
+            uint64_t                                    m_TransformsVersion {1};
+
+            TransformBufferRing m_TransformBuffers;
+        };
+    } // namespace scene
+
     namespace io
     {
-        static std::unordered_map<size_t, renderer::Texture*> g_TextureCache;
+        static std::unordered_map<size_t, renderer::GpuTextureHandle> g_TextureCache;
 
         renderer::Texture*
         loadTexture(const std::filesystem::path& texturePath, renderer::RenderContext& rc, bool flip = true);
 
-        void releaseTexture(const std::filesystem::path& texturePath,
-                            renderer::Texture&           texture,
-                            renderer::RenderContext&     rc);
+        // Releases the cached texture, the GPU object is destroyed once no frame in flight can reference it
+        void releaseTexture(const std::filesystem::path& texturePath, renderer::RenderContext& rc);
 
         bool loadModel(const std::filesystem::path& modelPath,
                        resource::Model&             model,
                        renderer::RenderContext&     rc,
                        const glm::vec3&             scale = glm::vec3(1.0f));
+
+        enum class LoadStage : uint8_t
+        {
+            eFileRead = 0,
+            eParse,
+            eImageDecode,
+            eMeshProcessing,
+            eBufferUpload,
+            eTextureUpload,
+            eMipGeneration,
+
+            eCount
+        };
+
+        inline constexpr auto kNumLoadStages = static_cast<size_t>(LoadStage::eCount);
+
+        const char* toString(LoadStage stage);
+
+        struct LoadStageStats
+        {
+            double   ms {0.0};
+            uint64_t bytes {0};
+            uint32_t count {0}; // How many times the stage ran
+        };
+
+        using LoadStageArray = std::array<LoadStageStats, kNumLoadStages>;
+
+        struct TextureLoadReport
+        {
+            std::filesystem::path path;
+            uint32_t              width {0};
+            uint32_t              height {0};
+            LoadStageArray        stages {};
+        };
+
+        /**
+         * @brief Load-time breakdown of one asset, recorded by loadTexture, loadModel and their async variants.
+         *
+         * Stage times are wall times, summed over every run of the stage. Images are decoded in parallel, so the
+         * stages may add up to more than totalMs. GL stages only cover the driver calls, not the transfer itself.
+         * Bytes are the input of file read and parse, and the output of the other stages.
+         */
+        struct LoadReport
+        {
+            std::filesystem::path path;
+            double                totalMs {0.0};
+            LoadStageArray        stages {}; // Including the textures below
+
+            std::vector<TextureLoadReport> textures;
+
+            uint32_t numMeshPrimitives {0};
+            uint64_t numVertices {0};
+            uint64_t numIndices {0};
+
+            std::string exportJson() const;
+        };
+
+        // Reports of the assets loaded since the last clear, oldest first. Models streamed with loadModelAsync
+        // report their textures separately. GL thread only.
+        const std::vector<LoadReport>& getLoadReports();
+        // Latest report of the asset, nullptr if it was not loaded since the last clear
+        const LoadReport* findLoadReport(const std::filesystem::path& assetPath);
+        void              clearLoadReports();
+
+        std::string exportLoadReportsJson();
+        bool        exportLoadReports(const std::filesystem::path& filePath);
+
+        // Fire-and-forget coroutine, starts eagerly and frees its frame when it completes.
+        struct Task
+        {
+            struct promise_type
+            {
+                Task               get_return_object() noexcept { return {}; }
+                std::suspend_never initial_suspend() noexcept { return {}; }
+                std::suspend_never final_suspend() noexcept { return {}; }
+                void               return_void() noexcept {}
+                void               unhandled_exception() { std::terminate(); }
+            };
+        };
+
+        /**
+         * @brief Handle to an asset that is streamed in asynchronously.
+         *
+         * The handle is usable right away: get() returns the placeholder until the asset becomes resident.
+         * Awaiting the handle (co_await handle) suspends the coroutine until the asset is resident.
+         */
+        template<typename T>
+        class AssetHandle
+        {
+        public:
+            AssetHandle() = default;
+            explicit AssetHandle(T* placeholder) : m_State {std::make_shared<State>()}
+            {
+                m_State->placeholder = placeholder;
+            }
+
+            explicit operator bool() const { return m_State != nullptr; }
+
+            bool isResident() const { return m_State && m_State->resident.load(std::memory_order_acquire); }
+
+            T* get() const
+            {
+                if (!m_State)
+                    return nullptr;
+                return isResident() ? m_State->asset : m_State->placeholder;
+            }
+
+            T* operator->() const { return get(); }
+
+            // Marks the asset resident and resumes every coroutine waiting on it. GL thread only.
+            void resolve(T* asset) const
+            {
+                std::vector<std::coroutine_handle<>> waiters;
+                {
+                    std::lock_guard lock {m_State->mutex};
+                    m_State->asset = asset;
+                    m_State->resident.store(true, std::memory_order_release);
+                    waiters.swap(m_State->waiters);
+                }
+                for (auto waiter : waiters)
+                    waiter.resume();
+            }
+
+            // Handle owns the asset (used by models, textures are owned by the texture cache)
+            T* own(std::unique_ptr<T> asset) const
+            {
+                m_State->owned = std::move(asset);
+                return m_State->owned.get();
+            }
+
+            bool await_ready() const noexcept { return !m_State || isResident(); }
+            bool await_suspend(std::coroutine_handle<> handle) const
+            {
+                std::lock_guard lock {m_State->mutex};
+                if (m_State->resident.load(std::memory_order_acquire))
+                    return false;
+                m_State->waiters.push_back(handle);
+                return true;
+            }
+            AssetHandle await_resume() const noexcept { return *this; }
+
+        private:
+            struct State
+            {
+                T*                                   placeholder {nullptr};
+                T*                                   asset {nullptr};
+                std::unique_ptr<T>                   owned;
+                std::atomic<bool>                    resident {false};
+                std::mutex                           mutex;
+                std::vector<std::coroutine_handle<>> waiters;
+            };
+
+            std::shared_ptr<State> m_State;
+        };
+
+        using TextureHandle = AssetHandle<renderer::Texture>;
+        using ModelHandle   = AssetHandle<resource::Model>;
+
+        // Starts streaming a texture: decoding runs on the job system, the GL upload is scheduled within the per-frame
+        // upload budget. Until then the handle points to the placeholder (a 1x1 white texture by default).
+        TextureHandle loadTextureAsync(const std::filesystem::path& texturePath,
+                                       renderer::RenderContext&     rc,
+                                       bool                         flip        = true,
+                                       renderer::Texture*           placeholder = nullptr);
+
+        // Starts streaming a model. Until it is resident the handle points to an empty model.
+        ModelHandle loadModelAsync(const std::filesystem::path& modelPath,
+                                   renderer::RenderContext&     rc,
+                                   const glm::vec3&             scale = glm::vec3(1.0f));
+
+        void           setUploadBudget(time::Duration budget);
+        time::Duration getUploadBudget();
+        uint32_t       getNumPendingUploads();
+
+        // Resumes queued upload continuations until the budget is spent (at least one per call). Called by
+        // renderer::beginFrame.
+        void processUploads();
+
+        void enqueueUpload(std::coroutine_handle<> handle);
+
+        // co_await resumeOnWorker(): continue the coroutine on the job system (inline if there are no workers)
+        struct WorkerAwaiter
+        {
+            bool await_ready() const { return jobs::getNumThreads() <= 1; }
+            void await_suspend(std::coroutine_handle<> handle) const
+            {
+                jobs::run([handle] { handle.resume(); });
+            }
+            void await_resume() const noexcept {}
+        };
+
+        // co_await resumeOnUploadQueue(): continue the coroutine on the GL thread, within the per-frame upload budget
+        struct UploadAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) const { enqueueUpload(handle); }
+            void await_resume() const noexcept {}
+        };
+
+        inline WorkerAwaiter resumeOnWorker() { return {}; }
+        inline UploadAwaiter resumeOnUploadQueue() { return {}; }
     } // namespace io
 
-    bool init();
+    bool init(const log::LogInitInfo& logInitInfo = {});
     void shutdown();
 } // namespace vgfw
 
@@ -1331,1690 +3601,6501 @@ namespace vgfw
 
         std::string readFileAllText(const std::filesystem::path& filePath)
         {
-            std::ifstream fileStream(filePath);
+            const auto file = vfs::readFile(filePath);
 
-            if (!fileStream.is_open())
+            if (!file)
             {
                 throw std::runtime_error("Could not open file: " + filePath.string());
             }
 
-            std::stringstream buffer;
-            buffer << fileStream.rdbuf();
-
-            return buffer.str();
+            return std::string(file->text());
         }
-    } // namespace utils
-
-    namespace math
-    {
-        glm::vec3 AABB::getExtent() const { return max - min; }
-        glm::vec3 AABB::getCenter() const { return (max + min) * 0.5f; }
-        float     AABB::getRadius() const { return glm::length(getExtent() * 0.5f); }
 
-        void AABB::merge(const AABB& other)
+        std::vector<uint8_t> readFileAllBytes(const std::filesystem::path& filePath)
         {
-            min.x = std::min(min.x, other.min.x);
-            min.y = std::min(min.y, other.min.y);
-            min.z = std::min(min.z, other.min.z);
+            auto file = vfs::readFile(filePath);
 
-            max.x = std::max(max.x, other.max.x);
-            max.y = std::max(max.y, other.max.y);
-            max.z = std::max(max.z, other.max.z);
+            if (!file)
+            {
+                VGFW_ERROR("Could not open file: {0}", filePath.generic_string());
+                return {};
+            }
+
+            return std::move(*file).toBytes();
         }
 
-        // https://dev.theomader.com/transform-bounding-boxes/
-        AABB AABB::transform(const glm::mat4& m) const
+        bool writeFileAllText(const std::filesystem::path& filePath, std::string_view text)
         {
-            const auto xa = m[0] * min.x;
-            const auto xb = m[0] * max.x;
+            std::ofstream fileStream(filePath, std::ios::binary);
 
-            const auto ya = m[1] * min.y;
-            const auto yb = m[1] * max.y;
+            if (!fileStream.is_open())
+            {
+                VGFW_ERROR("Could not open file for writing: {0}", filePath.generic_string());
+                return false;
+            }
 
-            const auto za = m[2] * min.z;
-            const auto zb = m[2] * max.z;
+            fileStream.write(text.data(), static_cast<std::streamsize>(text.size()));
+            return fileStream.good();
+        }
 
-            return {
-                .min = {glm::min(xa, xb) + glm::min(ya, yb) + glm::min(za, zb) + m[3]},
-                .max = {glm::max(xa, xb) + glm::max(ya, yb) + glm::max(za, zb) + m[3]},
-            };
+        std::string escapeJson(std::string_view str)
+        {
+            std::string result;
+            result.reserve(str.size());
+            for (const auto c : str)
+            {
+                switch (c)
+                {
+                    case '"':
+                        result += "\\\"";
+                        break;
+                    case '\\':
+                        result += "\\\\";
+                        break;
+                    case '\n':
+                        result += "\\n";
+                        break;
+                    case '\t':
+                        result += "\\t";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                            result += fmt::format("\\u{0:04x}", static_cast<int>(c));
+                        else
+                            result += c;
+                }
+            }
+            return result;
         }
-    } // namespace math
+    } // namespace utils
 
-    namespace log
+    namespace vfs
     {
-        void init()
+        static_assert((kPackAlignment & (kPackAlignment - 1)) == 0, "Pack alignment must be a power of two");
+
+        struct MountedPack
         {
-            std::vector<spdlog::sink_ptr> logSinks;
+            std::filesystem::path                          packPath;
+            std::filesystem::path                          mountPoint;
+            std::shared_ptr<MappedFile>                    file;
+            const PackEntry*                               entries {nullptr};
+            const char*                                    paths {nullptr};
+            std::unordered_map<std::string_view, uint32_t> lookup; // Entry path -> index, views into the mapping
 
-            logSinks.emplace_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
-            logSinks.emplace_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>("VGFW.log", true));
+            std::string_view getEntryPath(const PackEntry& entry) const
+            {
+                return {paths + entry.pathOffset, entry.pathLength};
+            }
+        };
 
-            logSinks[0]->set_pattern("%^[%T] %n: %v%$");
-            logSinks[1]->set_pattern("[%T] [%l] %n: %v");
+        static std::mutex                                g_MountMutex;
+        static std::vector<std::shared_ptr<MountedPack>> g_MountedPacks; // In mount order
 
-            g_Logger = std::make_shared<spdlog::logger>("VGFW", begin(logSinks), end(logSinks));
-            spdlog::register_logger(g_Logger);
-            g_Logger->set_level(spdlog::level::trace);
-            g_Logger->flush_on(spdlog::level::trace);
+        MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
 
-            VGFW_INFO("[Logger] Initialized");
-        }
+        MappedFile::~MappedFile() { close(); }
 
-        void shutdown()
+        MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
         {
-            VGFW_INFO("[Logger] Shutdown...");
-            spdlog::shutdown();
+            if (this != &other)
+            {
+                close();
+                std::swap(m_Data, other.m_Data);
+                std::swap(m_Size, other.m_Size);
+            }
+            return *this;
         }
-    } // namespace log
 
-    namespace window
-    {
-        bool GLFWWindow::init(const WindowInitInfo& initInfo)
+        bool MappedFile::open(const std::filesystem::path& filePath)
         {
-            if (!glfwInit())
+            close();
+
+#if VGFW_PLATFORM_LINUX
+            const int fd = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return false;
+
+            struct stat fileStat {};
+            if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
             {
-                VGFW_ERROR("Failed to initialize GLFW");
+                ::close(fd);
                 return false;
             }
 
-            glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
-            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, VGFW_RENDER_API_OPENGL_MIN_MAJOR);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, VGFW_RENDER_API_OPENGL_MIN_MINOR);
-
-            glfwWindowHint(GLFW_SAMPLES, static_cast<int>(initInfo.aaSample));
-            glfwWindowHint(GLFW_RESIZABLE, initInfo.isResizable);
-
-            GLFWmonitor*       primaryMonitor = glfwGetPrimaryMonitor();
-            const GLFWvidmode* mode           = glfwGetVideoMode(primaryMonitor);
+            void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd); // The mapping keeps its own reference to the file
+            if (data == MAP_FAILED)
+                return false;
 
-            GLFWmonitor* requestMonitor = nullptr;
-            int          requestWidth   = initInfo.width;
-            int          requestHeight  = initInfo.height;
+            // Entries are read in whatever order the loaders ask for them, read-ahead is requested per entry instead
+            madvise(data, static_cast<size_t>(fileStat.st_size), MADV_RANDOM);
 
-            if (initInfo.isFullScreen)
-            {
-                requestMonitor = primaryMonitor;
-                requestWidth   = mode->width;
-                requestHeight  = mode->height;
-            }
+            m_Data = static_cast<const uint8_t*>(data);
+            m_Size = static_cast<uint64_t>(fileStat.st_size);
+#elif VGFW_PLATFORM_WINDOWS
+            HANDLE file = CreateFileW(filePath.c_str(),
+                                      GENERIC_READ,
+                                      FILE_SHARE_READ,
+                                      nullptr,
+                                      OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS,
+                                      nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                return false;
 
-            m_Window = glfwCreateWindow(requestWidth, requestHeight, initInfo.title.c_str(), requestMonitor, nullptr);
-            if (!m_Window)
-            {
-                VGFW_ERROR("Failed to create GLFW window");
-                glfwTerminate();
+            LARGE_INTEGER fileSize {};
+            HANDLE        mapping = nullptr;
+            if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+                mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            CloseHandle(file); // The mapping keeps its own reference to the file
+            if (!mapping)
                 return false;
-            }
 
-            m_Data.title          = initInfo.title;
-            m_Data.width          = initInfo.width;
-            m_Data.height         = initInfo.height;
-            m_Data.platformWindow = this;
+            const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping); // The view keeps the mapping alive
+            if (!data)
+                return false;
 
-            return true;
+            m_Data = static_cast<const uint8_t*>(data);
+            m_Size = static_cast<uint64_t>(fileSize.QuadPart);
+#endif
+            return m_Data != nullptr;
         }
 
-        void GLFWWindow::shutdown()
+        void MappedFile::close()
         {
-            if (m_Window)
-            {
-                glfwDestroyWindow(m_Window);
-                m_Window = nullptr;
-            }
+            if (!m_Data)
+                return;
 
-            glfwTerminate();
+#if VGFW_PLATFORM_LINUX
+            munmap(const_cast<uint8_t*>(m_Data), m_Size);
+#elif VGFW_PLATFORM_WINDOWS
+            UnmapViewOfFile(m_Data);
+#endif
+            m_Data = nullptr;
+            m_Size = 0;
         }
 
-        void GLFWWindow::onTick()
+        void MappedFile::prefetch(uint64_t offset, uint64_t size) const
         {
-            VGFW_PROFILE_FUNCTION
-            glfwPollEvents();
-        }
+            if (!m_Data || offset >= m_Size || size == 0)
+                return;
+            size = std::min(size, m_Size - offset);
 
-        bool GLFWWindow::shouldClose() const { return m_Window && glfwWindowShouldClose(m_Window); }
+#if VGFW_PLATFORM_LINUX
+            static const auto pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+            const auto        begin    = offset & ~(pageSize - 1); // madvise needs a page-aligned address
+            madvise(const_cast<uint8_t*>(m_Data) + begin, static_cast<size_t>(size + offset - begin), MADV_WILLNEED);
+#elif VGFW_PLATFORM_WINDOWS
+            WIN32_MEMORY_RANGE_ENTRY range {const_cast<uint8_t*>(m_Data) + offset, static_cast<SIZE_T>(size)};
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#endif
+        }
 
-        bool GLFWWindow::isMinimized() const
+        std::vector<uint8_t> FileData::toBytes() &&
         {
-            if (m_Window)
-            {
-                int width, height;
-                glfwGetWindowSize(m_Window, &width, &height);
-                return width == 0 || height == 0;
-            }
-
-            return false;
+            if (!m_Mapping)
+                return std::move(m_Storage);
+            return {m_View, m_View + m_ViewSize};
         }
 
-        void GLFWWindow::makeCurrentContext()
+        std::optional<std::vector<uint8_t>> readNativeFile(const std::filesystem::path& filePath)
         {
-            if (m_Window)
+            std::ifstream fileStream(filePath, std::ios::binary | std::ios::ate);
+
+            if (!fileStream.is_open())
+                return std::nullopt;
+
+            std::vector<uint8_t> bytes(static_cast<size_t>(fileStream.tellg()));
+            fileStream.seekg(0);
+            fileStream.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+            return bytes;
+        }
+
+        // Pack entries are keyed by normalized generic paths relative to the mount point, newer mounts win
+        std::pair<std::shared_ptr<const MountedPack>, const PackEntry*> findEntry(const std::filesystem::path& filePath)
+        {
+            std::lock_guard lock {g_MountMutex};
+            if (g_MountedPacks.empty())
+                return {};
+
+            std::error_code ec;
+            const auto      absolutePath = std::filesystem::absolute(filePath, ec).lexically_normal();
+            if (ec)
+                return {};
+
+            for (auto it = g_MountedPacks.crbegin(); it != g_MountedPacks.crend(); ++it)
             {
-                glfwMakeContextCurrent(m_Window);
+                const auto& pack         = *it;
+                const auto  relativePath = absolutePath.lexically_relative(pack->mountPoint).generic_string();
+                if (relativePath.empty() || relativePath.starts_with(".."))
+                    continue;
+
+                if (const auto entry = pack->lookup.find(relativePath); entry != pack->lookup.cend())
+                    return {pack, &pack->entries[entry->second]};
             }
+            return {};
         }
 
-        void GLFWWindow::swapBuffers()
+        std::optional<FileData> readEntry(const MountedPack& pack, const PackEntry& entry)
         {
-            if (m_Window)
+            pack.file->prefetch(entry.offset, entry.storedSize);
+            const auto* stored = pack.file->data() + entry.offset;
+
+            switch (entry.compression)
             {
-                glfwSwapBuffers(m_Window);
+                case PackCompression::eNone:
+                    return FileData {pack.file, stored, static_cast<size_t>(entry.size)};
+
+                case PackCompression::eLZ4: {
+#ifdef VGFW_ENABLE_LZ4
+                    std::vector<uint8_t> bytes(static_cast<size_t>(entry.size));
+                    const int            decompressedSize = LZ4_decompress_safe(reinterpret_cast<const char*>(stored),
+                                                                     reinterpret_cast<char*>(bytes.data()),
+                                                                     static_cast<int>(entry.storedSize),
+                                                                     static_cast<int>(entry.size));
+                    if (decompressedSize < 0 || static_cast<uint64_t>(decompressedSize) != entry.size)
+                    {
+                        VGFW_ERROR("[VFS] Corrupt LZ4 entry {0} in {1}",
+                                   pack.getEntryPath(entry),
+                                   pack.packPath.generic_string());
+                        return std::nullopt;
+                    }
+                    return FileData {std::move(bytes)};
+#else
+                    VGFW_ERROR("[VFS] Entry {0} in {1} is LZ4 compressed, but VGFW_ENABLE_LZ4 is not defined",
+                               pack.getEntryPath(entry),
+                               pack.packPath.generic_string());
+                    return std::nullopt;
+#endif
+                }
             }
 
-            VGFW_PROFILE_GL_COLLECT
+            VGFW_ERROR("[VFS] Entry {0} in {1} has an unknown compression",
+                       pack.getEntryPath(entry),
+                       pack.packPath.generic_string());
+            return std::nullopt;
         }
 
-        void GLFWWindow::setHideCursor(bool hide)
+        bool mount(const std::filesystem::path& packPath, const std::filesystem::path& mountPoint)
         {
-            if (m_Window)
+            auto pack  = std::make_shared<MountedPack>();
+            pack->file = std::make_shared<MappedFile>();
+
+            if (!pack->file->open(packPath))
             {
-                glfwSetInputMode(m_Window, GLFW_CURSOR, hide ? GLFW_CURSOR_HIDDEN : GLFW_CURSOR_NORMAL);
+                VGFW_ERROR("[VFS] Could not open pack: {0}", packPath.generic_string());
+                return false;
             }
-        }
 
-        std::shared_ptr<Window> create(const WindowInitInfo& windowInitInfo, WindowType type)
-        {
-            std::shared_ptr<Window> window = nullptr;
+            pack->packPath   = std::filesystem::absolute(packPath).lexically_normal();
+            pack->mountPoint = (mountPoint.empty() ? std::filesystem::current_path() :
+                                                     std::filesystem::absolute(mountPoint))
+                                   .lexically_normal();
 
-            switch (type)
+            const auto* data     = pack->file->data();
+            const auto  size     = pack->file->size();
+            const auto  inBounds = [size](uint64_t offset, uint64_t length) {
+                return offset <= size && length <= size - offset;
+            };
+
+            PackHeader header {};
+            if (size >= sizeof(PackHeader))
+                std::memcpy(&header, data, sizeof(PackHeader));
+
+            if (size < sizeof(PackHeader) || header.magic != kPackMagic || header.version != kPackVersion ||
+                header.indexOffset % alignof(PackEntry) != 0 ||
+                !inBounds(header.indexOffset, uint64_t {header.numEntries} * sizeof(PackEntry)) ||
+                !inBounds(header.pathsOffset, header.pathsSize))
             {
-                case WindowType::eGLFW:
-                    window = std::make_shared<GLFWWindow>();
-                    break;
+                VGFW_ERROR("[VFS] Invalid pack: {0}", packPath.generic_string());
+                return false;
             }
 
-            if (!window || !window->init(windowInitInfo))
+            // The index and paths are read right away, the blobs on demand
+            pack->file->prefetch(header.indexOffset, size - header.indexOffset);
+            pack->entries = reinterpret_cast<const PackEntry*>(data + header.indexOffset);
+            pack->paths   = reinterpret_cast<const char*>(data + header.pathsOffset);
+
+            pack->lookup.reserve(header.numEntries);
+            for (uint32_t i = 0; i < header.numEntries; ++i)
             {
-                throw std::runtime_error("Failed to initialize window!");
+                const auto& entry = pack->entries[i];
+                const bool  valid = uint64_t {entry.pathOffset} + entry.pathLength <= header.pathsSize &&
+                                   inBounds(entry.offset, entry.storedSize) &&
+                                   (entry.compression != PackCompression::eNone || entry.storedSize == entry.size) &&
+                                   entry.size <= static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
+                if (!valid)
+                {
+                    VGFW_ERROR("[VFS] Invalid entry #{0} in pack: {1}", i, packPath.generic_string());
+                    return false;
+                }
+                pack->lookup.emplace(pack->getEntryPath(entry), i);
             }
 
-            return window;
+            VGFW_INFO("[VFS] Mounted {0} ({1} entries) at {2}",
+                      packPath.generic_string(),
+                      header.numEntries,
+                      pack->mountPoint.generic_string());
+
+            std::lock_guard lock {g_MountMutex};
+            g_MountedPacks.push_back(std::move(pack));
+            return true;
         }
-    } // namespace window
 
-    namespace renderer
-    {
-        DebugMarker::DebugMarker(std::string_view name)
+        bool unmount(const std::filesystem::path& packPath)
         {
-            glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name.data());
+            std::error_code ec;
+            const auto      absolutePath = std::filesystem::absolute(packPath, ec).lexically_normal();
+            if (ec)
+                return false;
+
+            // Files read from the pack stay valid, they hold a reference to its mapping
+            std::lock_guard lock {g_MountMutex};
+            for (auto it = g_MountedPacks.end(); it != g_MountedPacks.begin();)
+            {
+                --it;
+                if ((*it)->packPath == absolutePath)
+                {
+                    g_MountedPacks.erase(it);
+                    return true;
+                }
+            }
+            return false;
         }
-        DebugMarker::~DebugMarker() { glPopDebugGroup(); }
 
-        void GraphicsContext::init(const std::shared_ptr<window::Window>& window)
+        void unmountAll()
         {
-            m_Window = window;
+            std::lock_guard lock {g_MountMutex};
+            g_MountedPacks.clear();
+        }
 
-            window->makeCurrentContext();
-            setVSync(false);
+        bool exists(const std::filesystem::path& filePath)
+        {
+            if (findEntry(filePath).first)
+                return true;
 
-            int version = loadGl();
+            std::error_code ec;
+            return std::filesystem::is_regular_file(filePath, ec);
+        }
 
-            assert(version);
-            if (version)
-            {
-                int minMajor = getMinMajor();
-                int minMinor = getMinMinor();
-                VGFW_INFO("[GraphicsContext] Loaded OpenGL {0}.{1}", GLVersion.major, GLVersion.minor);
+        std::optional<uint64_t> getFileSize(const std::filesystem::path& filePath)
+        {
+            if (const auto [pack, entry] = findEntry(filePath); pack)
+                return entry->size;
 
-                std::stringstream ss;
-                ss << "    Vendor:       " << glGetString(GL_VENDOR) << std::endl;
-                ss << "    Version:      " << glGetString(GL_VERSION) << std::endl;
-                ss << "    Renderer:     " << glGetString(GL_RENDERER) << std::endl;
-                ss << "    GLSL Version: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << std::endl;
+            std::error_code ec;
+            const auto      size = std::filesystem::file_size(filePath, ec);
+            if (ec)
+                return std::nullopt;
+            return size;
+        }
 
-                VGFW_INFO("[GraphicsContext] OpenGL Context Info:\n {0}", ss.str());
+        std::optional<FileData> readFile(const std::filesystem::path& filePath)
+        {
+            if (const auto [pack, entry] = findEntry(filePath); pack)
+                return readEntry(*pack, *entry);
 
-                assert(GLVersion.major > minMajor || (GLVersion.major == minMajor && GLVersion.minor >= minMinor));
+            auto bytes = readNativeFile(filePath);
+            if (!bytes)
+                return std::nullopt;
+            return FileData {std::move(*bytes)};
+        }
+
+        bool writePack(const std::filesystem::path&   packPath,
+                       const std::vector<PackSource>& sources,
+                       float                          minCompressionRatio)
+        {
+            std::ofstream packStream(packPath, std::ios::binary);
+            if (!packStream.is_open())
+            {
+                VGFW_ERROR("[VFS] Could not open pack for writing: {0}", packPath.generic_string());
+                return false;
             }
 
-            m_SupportDSA = GLAD_GL_VERSION_4_5 || GLAD_GL_VERSION_4_6;
+            PackHeader             header {};
+            std::vector<PackEntry> entries;
+            std::string            paths;
+            uint64_t               offset = sizeof(PackHeader);
 
-            VGFW_PROFILE_GL_INIT_CONTEXT
-        }
+            header.numEntries = static_cast<uint32_t>(sources.size());
+            entries.reserve(sources.size());
 
-        void GraphicsContext::shutdown() { m_Window->shutdown(); }
+            const auto write = [&](const void* data, uint64_t size) {
+                packStream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+                offset += size;
+            };
+            const auto align = [&] {
+                static constexpr std::array<char, kPackAlignment> kZeros {};
+                write(kZeros.data(), ((offset + kPackAlignment - 1) & ~(kPackAlignment - 1)) - offset);
+            };
 
-        void GraphicsContext::swapBuffers() { m_Window->swapBuffers(); }
+            // Patched once the offsets are known
+            packStream.write(reinterpret_cast<const char*>(&header), sizeof(PackHeader));
 
-        void GraphicsContext::setVSync(bool vsyncEnabled) { glfwSwapInterval(vsyncEnabled); }
+            for (const auto& source : sources)
+            {
+                auto bytes = readNativeFile(source.filePath);
+                if (!bytes)
+                {
+                    VGFW_ERROR("[VFS] Could not open file: {0}", source.filePath.generic_string());
+                    return false;
+                }
 
-        int GraphicsContext::loadGl() { return gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)); }
+                const auto entryPath = std::filesystem::path(source.packPath).lexically_normal().generic_string();
 
-        int GraphicsContext::getMinMajor() { return VGFW_RENDER_API_OPENGL_MIN_MAJOR; }
+                PackEntry entry {};
+                entry.size       = bytes->size();
+                entry.pathOffset = static_cast<uint32_t>(paths.size());
+                entry.pathLength = static_cast<uint32_t>(entryPath.size());
+                paths += entryPath;
 
-        int GraphicsContext::getMinMinor() { return VGFW_RENDER_API_OPENGL_MIN_MINOR; }
+                if (entry.size > static_cast<uint64_t>(std::numeric_limits<int32_t>::max()))
+                {
+                    VGFW_ERROR("[VFS] File too large for a pack entry: {0}", source.filePath.generic_string());
+                    return false;
+                }
 
-        Buffer::Buffer(Buffer&& other) noexcept :
-            m_Id(other.m_Id), m_Size(other.m_Size), m_MappedMemory(other.m_MappedMemory)
+                std::vector<uint8_t> compressed;
+                if (source.compress && !bytes->empty())
+                {
+#ifdef VGFW_ENABLE_LZ4
+                    compressed.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(bytes->size()))));
+                    const int compressedSize = LZ4_compress_HC(reinterpret_cast<const char*>(bytes->data()),
+                                                               reinterpret_cast<char*>(compressed.data()),
+                                                               static_cast<int>(bytes->size()),
+                                                               static_cast<int>(compressed.size()),
+                                                               LZ4HC_CLEVEL_DEFAULT);
+                    if (compressedSize > 0 && compressedSize < bytes->size() * minCompressionRatio)
+                    {
+                        compressed.resize(static_cast<size_t>(compressedSize));
+                        entry.compression = PackCompression::eLZ4;
+                    }
+#else
+                    (void)minCompressionRatio;
+                    VGFW_WARN("[VFS] VGFW_ENABLE_LZ4 is not defined, storing {0} uncompressed", entryPath);
+#endif
+                }
+
+                const auto& stored = entry.compression == PackCompression::eLZ4 ? compressed : *bytes;
+
+                align();
+                entry.offset     = offset;
+                entry.storedSize = stored.size();
+                write(stored.data(), stored.size());
+                entries.push_back(entry);
+            }
+
+            align();
+            header.indexOffset = offset;
+            write(entries.data(), entries.size() * sizeof(PackEntry));
+            header.pathsOffset = offset;
+            header.pathsSize   = paths.size();
+            write(paths.data(), paths.size());
+
+            packStream.seekp(0);
+            packStream.write(reinterpret_cast<const char*>(&header), sizeof(PackHeader));
+
+            if (!packStream.good())
+            {
+                VGFW_ERROR("[VFS] Failed to write pack: {0}", packPath.generic_string());
+                return false;
+            }
+            return true;
+        }
+    } // namespace vfs
+
+    namespace math
+    {
+        glm::vec3 AABB::getExtent() const { return max - min; }
+        glm::vec3 AABB::getCenter() const { return (max + min) * 0.5f; }
+        float     AABB::getRadius() const { return glm::length(getExtent() * 0.5f); }
+
+        void AABB::merge(const AABB& other)
         {
-            memset(reinterpret_cast<void*>(&other), 0, sizeof(Buffer));
+            min.x = std::min(min.x, other.min.x);
+            min.y = std::min(min.y, other.min.y);
+            min.z = std::min(min.z, other.min.z);
+
+            max.x = std::max(max.x, other.max.x);
+            max.y = std::max(max.y, other.max.y);
+            max.z = std::max(max.z, other.max.z);
         }
 
-        Buffer::~Buffer()
+        // https://dev.theomader.com/transform-bounding-boxes/
+        AABB AABB::transform(const glm::mat4& m) const
         {
-            if (m_Id != GL_NONE)
-                VGFW_ERROR("Buffer leak: {0}", m_Id);
+            const auto xa = m[0] * min.x;
+            const auto xb = m[0] * max.x;
+
+            const auto ya = m[1] * min.y;
+            const auto yb = m[1] * max.y;
+
+            const auto za = m[2] * min.z;
+            const auto zb = m[2] * max.z;
+
+            return {
+                .min = {glm::min(xa, xb) + glm::min(ya, yb) + glm::min(za, zb) + m[3]},
+                .max = {glm::max(xa, xb) + glm::max(ya, yb) + glm::max(za, zb) + m[3]},
+            };
         }
+    } // namespace math
 
-        Buffer& Buffer::operator=(Buffer&& rhs) noexcept
+    namespace log
+    {
+        std::shared_ptr<spdlog::logger> g_Logger = nullptr;
+
+        void init(const LogInitInfo& initInfo)
         {
-            if (this != &rhs)
+            std::vector<spdlog::sink_ptr> logSinks;
+
+            logSinks.emplace_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+            logSinks.emplace_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>("VGFW.log", true));
+
+            logSinks[0]->set_pattern("%^[%T] %n: %v%$");
+            logSinks[1]->set_pattern("[%T] [%l] %n: %v");
+
+            if (initInfo.async)
             {
-                memcpy(reinterpret_cast<void*>(this), reinterpret_cast<void*>(&rhs), sizeof(Buffer));
-                memset(reinterpret_cast<void*>(&rhs), 0, sizeof(Buffer));
+                spdlog::init_thread_pool(initInfo.queueSize, 1);
+                g_Logger = std::make_shared<spdlog::async_logger>("VGFW",
+                                                                  begin(logSinks),
+                                                                  end(logSinks),
+                                                                  spdlog::thread_pool(),
+                                                                  initInfo.dropOldestOnOverflow ?
+                                                                      spdlog::async_overflow_policy::overrun_oldest :
+                                                                      spdlog::async_overflow_policy::block);
             }
-            return *this;
+            else
+            {
+                g_Logger = std::make_shared<spdlog::logger>("VGFW", begin(logSinks), end(logSinks));
+            }
+            spdlog::register_logger(g_Logger);
+            g_Logger->set_level(static_cast<spdlog::level::level_enum>(VGFW_ACTIVE_LOG_LEVEL));
+            g_Logger->flush_on(spdlog::level::err);
+            spdlog::flush_every(initInfo.flushInterval);
+
+            VGFW_INFO("[Logger] Initialized");
         }
 
-        Buffer::operator bool() const { return m_Id != GL_NONE; }
+        void shutdown()
+        {
+            VGFW_INFO("[Logger] Shutdown...");
+            spdlog::shutdown();
+        }
+    } // namespace log
 
-        GLsizeiptr Buffer::getSize() const { return m_Size; }
-        bool       Buffer::isMapped() const { return m_MappedMemory != nullptr; }
+    namespace profiler
+    {
+        struct ThreadBuffer
+        {
+            static constexpr uint32_t kCapacity = 1u << 16;
 
-        Buffer::Buffer(GLuint id, GLsizeiptr size) : m_Id(id), m_Size(size) {}
+            std::unique_ptr<ZoneEvent[]> events {new ZoneEvent[kCapacity]};
+            std::atomic<uint64_t>        writeIndex {0};
+            uint32_t                     threadId {0};
+            std::string                  threadName;
+        };
 
-        Buffer::operator GLuint() const { return m_Id; }
+        struct ProfilerState
+        {
+            std::atomic<bool> enabled {true};
+            time::TimePoint   start {time::Clock::now()};
 
-        IndexType  IndexBuffer::getIndexType() const { return m_IndexType; }
-        GLsizeiptr IndexBuffer::getCapacity() const { return m_Size / static_cast<GLsizei>(m_IndexType); }
+            std::mutex                                 mutex;
+            std::vector<std::shared_ptr<ThreadBuffer>> threadBuffers;
+            std::vector<uint64_t>                      frameEnds;
 
-        IndexBuffer::IndexBuffer(Buffer buffer, IndexType indexType) :
-            Buffer {std::move(buffer)}, m_IndexType {indexType}
-        {}
+            uint32_t              captureFramesLeft {0};
+            uint64_t              captureStartNs {0};
+            std::filesystem::path capturePath;
+        };
 
-        GLsizei    VertexBuffer::getStride() const { return m_Stride; }
-        GLsizeiptr VertexBuffer::getCapacity() const { return m_Size / m_Stride; }
+        static ProfilerState g_Profiler;
 
-        VertexBuffer::VertexBuffer(Buffer buffer, GLsizei stride) : Buffer {std::move(buffer)}, m_Stride {stride} {}
+        // Thread buffers are shared with the registry, so zones of finished threads can still be exported
+        thread_local ThreadBuffer* t_ThreadBuffer = nullptr;
 
-        int32_t getSize(VertexAttribute::Type type)
+        ThreadBuffer& getThreadBuffer()
         {
-            switch (type)
+            if (!t_ThreadBuffer)
             {
-                using enum VertexAttribute::Type;
-                case eFloat:
-                    return sizeof(float);
-                case eFloat2:
-                    return sizeof(float) * 2;
-                case eFloat3:
-                    return sizeof(float) * 3;
-                case eFloat4:
-                    return sizeof(float) * 4;
-
-                case VertexAttribute::Type::eInt:
-                    return sizeof(int32_t);
-                case eInt4:
-                    return sizeof(int32_t) * 4;
+                auto buffer = std::make_shared<ThreadBuffer>();
 
-                case eUByte4_Norm:
-                    return sizeof(uint8_t) * 4;
+                std::lock_guard lock {g_Profiler.mutex};
+                buffer->threadId   = static_cast<uint32_t>(g_Profiler.threadBuffers.size());
+                buffer->threadName = fmt::format("Thread {0}", buffer->threadId);
+                t_ThreadBuffer     = buffer.get();
+                g_Profiler.threadBuffers.push_back(std::move(buffer));
             }
-            return 0;
+            return *t_ThreadBuffer;
         }
 
-        std::size_t VertexFormat::getHash() const { return m_Hash; }
-
-        const VertexAttributes& VertexFormat::getAttributes() const { return m_Attributes; }
-        bool                    VertexFormat::contains(AttributeLocation location) const
+        ScopedZone::ScopedZone(const char* name)
         {
-            return m_Attributes.contains(static_cast<int32_t>(location));
+            if (isEnabled())
+            {
+                m_Name    = name;
+                m_BeginNs = now();
+            }
         }
 
-        bool VertexFormat::contains(std::initializer_list<AttributeLocation> locations) const
+        ScopedZone::~ScopedZone()
         {
-            return std::all_of(std::cbegin(locations), std::cend(locations), [&](auto location) {
-                return std::any_of(m_Attributes.cbegin(),
-                                   m_Attributes.cend(),
-                                   [v = static_cast<int32_t>(location)](const auto& p) { return p.first == v; });
-            });
+            if (m_Name)
+                recordZone(m_Name, m_BeginNs, now());
         }
 
-        uint32_t VertexFormat::getStride() const { return m_Stride; }
+        void setEnabled(bool enabled) { g_Profiler.enabled.store(enabled, std::memory_order_relaxed); }
+        bool isEnabled() { return g_Profiler.enabled.load(std::memory_order_relaxed); }
 
-        VertexFormat::VertexFormat(std::size_t hash, VertexAttributes&& attributes, uint32_t stride) :
-            m_Hash {hash}, m_Attributes {attributes}, m_Stride {stride}
-        {}
+        uint64_t now()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(time::Clock::now() - g_Profiler.start).count();
+        }
 
-        using Builder = VertexFormat::Builder;
+        void setThreadName(std::string_view name)
+        {
+            auto& buffer = getThreadBuffer();
 
-        Builder& Builder::setAttribute(AttributeLocation location, const VertexAttribute& attribute)
+            std::lock_guard lock {g_Profiler.mutex};
+            buffer.threadName = name;
+        }
+
+        void recordZone(const char* name, uint64_t beginNs, uint64_t endNs)
         {
-            m_Attributes.insert_or_assign(static_cast<int32_t>(location), attribute);
-            return *this;
+            auto&      buffer = getThreadBuffer();
+            const auto index  = buffer.writeIndex.load(std::memory_order_relaxed);
+
+            buffer.events[index % ThreadBuffer::kCapacity] = {name, beginNs, endNs};
+            buffer.writeIndex.store(index + 1, std::memory_order_release);
         }
 
-        std::shared_ptr<VertexFormat> Builder::build()
+        std::string exportChromeTrace(uint64_t fromNs, uint64_t toNs)
         {
-            uint32_t    stride {0};
-            std::size_t hash {0};
-            for (const auto& [location, attribute] : m_Attributes)
+            VGFW_PROFILE_FUNCTION
+
+            std::vector<std::shared_ptr<ThreadBuffer>> threadBuffers;
+            std::vector<uint64_t>                      frameEnds;
             {
-                stride += getSize(attribute.vertType);
-                utils::hashCombine(hash, location, attribute);
+                std::lock_guard lock {g_Profiler.mutex};
+                threadBuffers = g_Profiler.threadBuffers;
+                frameEnds     = g_Profiler.frameEnds;
             }
 
-            if (const auto it = s_Cache.find(hash); it != s_Cache.cend())
-                if (auto vertexFormat = it->second.lock(); vertexFormat)
-                    return vertexFormat;
+            std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+            bool        first {true};
+            const auto  separator = [&first] { return std::exchange(first, false) ? "" : ","; };
 
-            auto vertexFormat = std::make_shared<VertexFormat>(VertexFormat {hash, std::move(m_Attributes), stride});
-            s_Cache.insert_or_assign(hash, vertexFormat);
-            return vertexFormat;
-        }
+            for (const auto& buffer : threadBuffers)
+            {
+                json += fmt::format(
+                    "{0}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{1},\"args\":{{\"name\":\"{2}\"}}}}",
+                    separator(),
+                    buffer->threadId,
+                    utils::escapeJson(buffer->threadName));
+
+                // Slots may be overwritten by their owner while we read, that only affects the oldest zones
+                const auto end   = buffer->writeIndex.load(std::memory_order_acquire);
+                const auto begin = end > ThreadBuffer::kCapacity ? end - ThreadBuffer::kCapacity : 0;
+                for (auto i = begin; i < end; ++i)
+                {
+                    const auto event = buffer->events[i % ThreadBuffer::kCapacity];
+                    if (event.beginNs < fromNs || event.endNs > toNs)
+                        continue;
 
-        std::shared_ptr<VertexFormat> Builder::buildDefault()
-        {
-            m_Attributes.clear();
+                    json += fmt::format(
+                        "{0}{{\"name\":\"{1}\",\"ph\":\"X\",\"pid\":1,\"tid\":{2},\"ts\":{3:.3f},\"dur\":{4:.3f}}}",
+                        separator(),
+                        utils::escapeJson(event.name),
+                        buffer->threadId,
+                        static_cast<double>(event.beginNs) / 1e3,
+                        static_cast<double>(event.endNs - event.beginNs) / 1e3);
+                }
+            }
 
-            setAttribute(AttributeLocation::ePosition, {.vertType = VertexAttribute::Type::eFloat3, .offset = 0});
-            setAttribute(AttributeLocation::eNormal_Color, {.vertType = VertexAttribute::Type::eFloat3, .offset = 12});
-            setAttribute(AttributeLocation::eTexCoords, {.vertType = VertexAttribute::Type::eFloat2, .offset = 24});
+            for (const auto frameEnd : frameEnds)
+            {
+                if (frameEnd < fromNs || frameEnd > toNs)
+                    continue;
 
-            return build();
-        }
+                json += fmt::format(
+                    "{0}{{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":{1:.3f}}}",
+                    separator(),
+                    static_cast<double>(frameEnd) / 1e3);
+            }
 
-        Texture::Texture(Texture&& other) noexcept :
-            m_Id {other.m_Id}, m_Type {other.m_Type}, m_View {other.m_View}, m_Extent {other.m_Extent},
-            m_Depth {other.m_Depth}, m_NumMipLevels {other.m_NumMipLevels}, m_NumLayers {other.m_NumLayers},
-            m_PixelFormat {other.m_PixelFormat}
-        {
-            memset(reinterpret_cast<void*>(&other), 0, sizeof(Texture));
+            json += "]}";
+            return json;
         }
 
-        Texture::~Texture()
+        std::string exportChromeTrace() { return exportChromeTrace(0, std::numeric_limits<uint64_t>::max()); }
+
+        bool exportChromeTrace(const std::filesystem::path& filePath)
         {
-            if (m_Id != GL_NONE)
-                VGFW_ERROR("Texture leak: {0}", m_Id);
+            return utils::writeFileAllText(filePath, exportChromeTrace());
         }
 
-        Texture& Texture::operator=(Texture&& rhs) noexcept
+        void endFrame()
         {
-            if (this != &rhs)
+            const auto frameEnd = now();
+
+            std::filesystem::path capturePath;
+            uint64_t              captureStartNs {0};
             {
-                memcpy(reinterpret_cast<void*>(this), reinterpret_cast<void*>(&rhs), sizeof(Texture));
-                memset(reinterpret_cast<void*>(&rhs), 0, sizeof(Texture));
+                std::lock_guard lock {g_Profiler.mutex};
+
+                // Keep roughly as many frame markers as the zone ring buffers can hold
+                constexpr size_t kMaxFrameEnds = 4096;
+                if (g_Profiler.frameEnds.size() == kMaxFrameEnds)
+                    g_Profiler.frameEnds.erase(g_Profiler.frameEnds.begin(),
+                                               g_Profiler.frameEnds.begin() + kMaxFrameEnds / 2);
+                g_Profiler.frameEnds.push_back(frameEnd);
+
+                if (g_Profiler.captureFramesLeft > 0 && --g_Profiler.captureFramesLeft == 0)
+                {
+                    capturePath    = std::move(g_Profiler.capturePath);
+                    captureStartNs = g_Profiler.captureStartNs;
+                }
+            }
+
+            if (!capturePath.empty())
+            {
+                if (utils::writeFileAllText(capturePath, exportChromeTrace(captureStartNs, frameEnd)))
+                    VGFW_INFO("[Profiler] Captured trace: {0}", capturePath.generic_string());
             }
-            return *this;
         }
 
-        Texture::operator bool() const { return m_Id != GL_NONE; }
+        void captureFrames(uint32_t numFrames, const std::filesystem::path& filePath)
+        {
+            std::lock_guard lock {g_Profiler.mutex};
+            g_Profiler.captureFramesLeft = numFrames;
+            g_Profiler.captureStartNs    = now();
+            g_Profiler.capturePath       = filePath;
+        }
+    } // namespace profiler
 
-        GLenum Texture::getType() const { return m_Type; }
+    namespace jobs
+    {
+        struct JobEntry
+        {
+            Job      job;
+            Counter* counter {nullptr};
+        };
 
-        Extent2D    Texture::getExtent() const { return m_Extent; }
-        uint32_t    Texture::getDepth() const { return m_Depth; }
-        uint32_t    Texture::getNumMipLevels() const { return m_NumMipLevels; }
-        uint32_t    Texture::getNumLayers() const { return m_NumLayers; }
-        PixelFormat Texture::getPixelFormat() const { return m_PixelFormat; }
+        // Chase-Lev work-stealing deque (fixed capacity), see "Correct and Efficient Work-Stealing for Weak Memory
+        // Models" (Le et al. 2013). The owner pushes and pops at the bottom, thieves steal from the top.
+        class WorkStealingDeque
+        {
+        public:
+            explicit WorkStealingDeque(uint32_t capacity) : m_Mask {capacity - 1}, m_Entries(capacity)
+            {
+                assert(math::isPowerOf2(capacity));
+            }
 
-        Texture::Texture(GLuint      id,
-                         GLenum      type,
-                         PixelFormat pixelFormat,
-                         Extent2D    extent,
-                         uint32_t    depth,
-                         uint32_t    numMipLevels,
-                         uint32_t    numLayers) :
-            m_Id {id},
-            m_Type {type}, m_Extent {extent}, m_Depth {depth}, m_NumMipLevels {numMipLevels}, m_NumLayers {numLayers},
-            m_PixelFormat {pixelFormat}
-        {}
+            bool push(JobEntry* entry)
+            {
+                const auto b = m_Bottom.load(std::memory_order_relaxed);
+                const auto t = m_Top.load(std::memory_order_acquire);
+                if (b - t > static_cast<int64_t>(m_Mask))
+                    return false;
+
+                m_Entries[b & m_Mask].store(entry, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                m_Bottom.store(b + 1, std::memory_order_relaxed);
+                return true;
+            }
 
-        Texture::operator GLuint() const { return m_Id; }
+            JobEntry* pop()
+            {
+                const auto b = m_Bottom.load(std::memory_order_relaxed) - 1;
+                m_Bottom.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                auto t = m_Top.load(std::memory_order_relaxed);
 
-        uint32_t   calcMipLevels(uint32_t size) { return glm::floor(glm::log2(static_cast<float>(size))) + 1u; }
-        glm::uvec3 calcMipSize(const glm::uvec3& baseSize, uint32_t level)
-        {
-            return glm::vec3 {baseSize} * glm::pow(0.5f, static_cast<float>(level));
-        }
+                if (t > b)
+                {
+                    m_Bottom.store(b + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
 
-        const char* toString(PixelFormat pixelFormat)
-        {
-            switch (pixelFormat)
+                auto* entry = m_Entries[b & m_Mask].load(std::memory_order_relaxed);
+                if (t == b)
+                {
+                    // Last entry, race against thieves
+                    if (!m_Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                        entry = nullptr;
+                    m_Bottom.store(b + 1, std::memory_order_relaxed);
+                }
+                return entry;
+            }
+
+            JobEntry* steal()
             {
-                using enum PixelFormat;
+                auto t = m_Top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const auto b = m_Bottom.load(std::memory_order_acquire);
+                if (t >= b)
+                    return nullptr;
+
+                auto* entry = m_Entries[t & m_Mask].load(std::memory_order_relaxed);
+                if (!m_Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    return nullptr;
+                return entry;
+            }
 
-                case eR8_UNorm:
-                    return "R8_Unorm";
+        private:
+            const int64_t m_Mask;
 
-                case eRGB8_UNorm:
-                    return "RGB8_UNorm";
-                case eRGBA8_UNorm:
-                    return "RGBA8_UNorm";
+            alignas(64) std::atomic<int64_t> m_Top {0};
+            alignas(64) std::atomic<int64_t> m_Bottom {0};
 
-                case eRGB8_SNorm:
-                    return "RGB8_SNorm";
-                case eRGBA8_SNorm:
-                    return "RGBA8_SNorm";
+            std::vector<std::atomic<JobEntry*>> m_Entries;
+        };
 
-                case eR16F:
-                    return "R16F";
-                case eRG16F:
-                    return "RG16F";
-                case eRGB16F:
-                    return "RGB16F";
-                case eRGBA16F:
-                    return "RGBA16F";
+        struct JobSystem
+        {
+            std::vector<std::unique_ptr<WorkStealingDeque>> deques;
+            std::vector<std::thread>                        workers;
 
-                case eRGB32F:
-                    return "RGB32F";
-                case eRGBA32F:
-                    return "RGBA32F";
+            // Jobs submitted by threads that do not own a deque
+            std::mutex            injectionMutex;
+            std::deque<JobEntry*> injectionQueue;
 
-                case eR32I:
-                    return "R32I";
-                case eRGBA32UI:
-                    return "RGBA32UI";
+            std::mutex            glThreadMutex;
+            std::vector<JobEntry> glThreadJobs;
 
-                case eDepth16:
-                    return "Depth16";
-                case eDepth24:
-                    return "Depth24";
-                case eDepth32F:
-                    return "Depth32F";
+            std::mutex              sleepMutex;
+            std::condition_variable sleepCondition;
+            std::atomic<uint32_t>   numPending {0};
+            std::atomic<uint32_t>   numSleeping {0};
+            std::atomic<bool>       running {false};
+        };
 
-                case PixelFormat::eUnknown:
-                    break;
-            }
+        static std::unique_ptr<JobSystem> g_JobSystem = nullptr;
+        static std::thread::id            g_GLThreadId {};
 
-            return "Undefined";
-        }
+        thread_local int32_t  t_ThreadIndex = -1;
+        thread_local uint32_t t_RandomState = 0;
 
-        GraphicsPipeline::Builder& GraphicsPipeline::Builder::setShaderProgram(GLuint program)
+        void execute(JobEntry* entry)
         {
-            m_Program = program;
-            return *this;
+            {
+                VGFW_PROFILE_NAMED_SCOPE("Job")
+                entry->job();
+            }
+            if (entry->counter)
+                entry->counter->done();
+            delete entry;
         }
 
-        GraphicsPipeline::Builder& GraphicsPipeline::Builder::setVAO(GLuint vao)
+        uint32_t nextRandom()
         {
-            m_VAO = vao;
-            return *this;
+            // xorshift32
+            auto x = t_RandomState;
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            return t_RandomState = x;
         }
 
-        GraphicsPipeline::Builder& GraphicsPipeline::Builder::setDepthStencil(const DepthStencilState& state)
+        JobEntry* findJob()
         {
-            m_DepthStencilState = state;
-            return *this;
+            auto& js = *g_JobSystem;
+
+            JobEntry* entry = nullptr;
+            if (t_ThreadIndex >= 0)
+                entry = js.deques[t_ThreadIndex]->pop();
+
+            if (!entry)
+            {
+                const auto numDeques = static_cast<uint32_t>(js.deques.size());
+                const auto start     = nextRandom() % numDeques;
+                for (uint32_t i {0}; i < numDeques && !entry; ++i)
+                {
+                    const auto victim = (start + i) % numDeques;
+                    if (static_cast<int32_t>(victim) != t_ThreadIndex)
+                        entry = js.deques[victim]->steal();
+                }
+            }
+
+            if (!entry)
+            {
+                std::lock_guard lock {js.injectionMutex};
+                if (!js.injectionQueue.empty())
+                {
+                    entry = js.injectionQueue.front();
+                    js.injectionQueue.pop_front();
+                }
+            }
+
+            if (entry)
+                js.numPending.fetch_sub(1);
+            return entry;
         }
 
-        GraphicsPipeline::Builder& GraphicsPipeline::Builder::setRasterizerState(const RasterizerState& state)
+        void workerMain(int32_t threadIndex)
         {
-            m_RasterizerState = state;
-            return *this;
+            t_ThreadIndex = threadIndex;
+            t_RandomState = 0x9e3779b9u * static_cast<uint32_t>(threadIndex + 1);
+
+            const auto threadName = fmt::format("VGFW Worker {0}", threadIndex);
+#ifdef VGFW_ENABLE_TRACY
+            tracy::SetThreadName(threadName.c_str());
+#endif
+#ifdef VGFW_ENABLE_BUILTIN_PROFILER
+            profiler::setThreadName(threadName);
+#endif
+
+            auto& js = *g_JobSystem;
+            while (js.running.load(std::memory_order_acquire))
+            {
+                if (auto* entry = findJob())
+                {
+                    execute(entry);
+                    continue;
+                }
+
+                std::unique_lock lock {js.sleepMutex};
+                js.numSleeping.fetch_add(1);
+                js.sleepCondition.wait(lock, [&js] { return js.numPending.load() > 0 || !js.running.load(); });
+                js.numSleeping.fetch_sub(1);
+            }
         }
 
-        GraphicsPipeline::Builder& GraphicsPipeline::Builder::setBlendState(uint32_t          attachment,
-                                                                            const BlendState& state)
+        void init(const JobSystemInitInfo& initInfo)
         {
-            assert(attachment < kMaxNumBlendStates);
-            m_BlendStates[attachment] = state;
-            return *this;
+            assert(!g_JobSystem);
+
+            const auto hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+            const auto numWorkers      = initInfo.numWorkers.value_or(hardwareThreads - 1);
+
+            g_GLThreadId  = std::this_thread::get_id();
+            t_ThreadIndex = 0;
+            t_RandomState = 0x9e3779b9u;
+
+            g_JobSystem          = std::make_unique<JobSystem>();
+            g_JobSystem->running = true;
+            for (uint32_t i {0}; i <= numWorkers; ++i)
+                g_JobSystem->deques.push_back(std::make_unique<WorkStealingDeque>(initInfo.queueCapacity));
+            for (uint32_t i {1}; i <= numWorkers; ++i)
+                g_JobSystem->workers.emplace_back(workerMain, static_cast<int32_t>(i));
+
+            VGFW_INFO("[JobSystem] Initialized with {0} worker(s)", numWorkers);
         }
 
-        GraphicsPipeline GraphicsPipeline::Builder::build()
+        void shutdown()
         {
-            GraphicsPipeline g;
+            if (!g_JobSystem)
+                return;
 
-            g.m_Program           = m_Program;
-            g.m_VAO               = m_VAO;
-            g.m_DepthStencilState = m_DepthStencilState;
-            g.m_RasterizerState   = m_RasterizerState;
-            g.m_BlendStates       = m_BlendStates;
+            {
+                std::lock_guard lock {g_JobSystem->sleepMutex};
+                g_JobSystem->running = false;
+            }
+            g_JobSystem->sleepCondition.notify_all();
+            for (auto& worker : g_JobSystem->workers)
+                worker.join();
 
-            return g;
+            // Finish what is left so nobody waits on a counter forever
+            while (auto* entry = findJob())
+                execute(entry);
+            pumpGLThread();
+
+            g_JobSystem.reset();
+            t_ThreadIndex = -1;
+
+            VGFW_INFO("[JobSystem] Shutdown");
         }
 
-        // @return {data type, number of components, normalize}
-        std::tuple<GLenum, GLint, GLboolean> statAttribute(VertexAttribute::Type type)
+        bool isInitialized() { return g_JobSystem != nullptr; }
+
+        uint32_t getNumThreads() { return g_JobSystem ? static_cast<uint32_t>(g_JobSystem->deques.size()) : 1u; }
+        int32_t  getThreadIndex() { return t_ThreadIndex; }
+        bool     isGLThread() { return !g_JobSystem || std::this_thread::get_id() == g_GLThreadId; }
+
+        void run(Job job, Counter* counter)
         {
-            switch (type)
+            if (counter)
+                counter->add();
+
+            if (!g_JobSystem)
             {
-                using enum VertexAttribute::Type;
-                case eFloat:
-                    return {GL_FLOAT, 1, GL_FALSE};
-                case eFloat2:
-                    return {GL_FLOAT, 2, GL_FALSE};
-                case eFloat3:
-                    return {GL_FLOAT, 3, GL_FALSE};
-                case eFloat4:
-                    return {GL_FLOAT, 4, GL_FALSE};
+                execute(new JobEntry {std::move(job), counter});
+                return;
+            }
 
-                case eInt:
-                    return {GL_INT, 1, GL_FALSE};
-                case eInt4:
-                    return {GL_INT, 4, GL_FALSE};
+            auto& js    = *g_JobSystem;
+            auto* entry = new JobEntry {std::move(job), counter};
+            if (t_ThreadIndex >= 0)
+            {
+                if (!js.deques[t_ThreadIndex]->push(entry))
+                {
+                    execute(entry);
+                    return;
+                }
+            }
+            else
+            {
+                std::lock_guard lock {js.injectionMutex};
+                js.injectionQueue.push_back(entry);
+            }
 
-                case eUByte4_Norm:
-                    return {GL_UNSIGNED_BYTE, 4, GL_TRUE};
+            js.numPending.fetch_add(1);
+            if (js.numSleeping.load() > 0)
+            {
+                // Take the lock so the notification cannot slip in between a worker's check and its wait
+                {
+                    std::lock_guard lock {js.sleepMutex};
+                }
+                js.sleepCondition.notify_one();
             }
-            return {GL_INVALID_INDEX, 0, GL_FALSE};
         }
 
-        GLenum selectTextureMinFilter(TexelFilter minFilter, MipmapMode mipmapMode)
+        void wait(const Counter& counter)
         {
-            GLenum result {GL_NONE};
-            switch (minFilter)
+            VGFW_PROFILE_FUNCTION
+            const auto onGLThread = isGLThread();
+            while (!counter.isDone())
             {
-                case TexelFilter::eNearest:
-                    switch (mipmapMode)
-                    {
-                        case MipmapMode::eNone:
-                            result = GL_NEAREST;
-                            break;
-                        case MipmapMode::eNearest:
-                            result = GL_NEAREST_MIPMAP_NEAREST;
-                            break;
-                        case MipmapMode::eLinear:
-                            result = GL_NEAREST_MIPMAP_LINEAR;
-                            break;
-                    }
-                    break;
+                if (onGLThread)
+                    pumpGLThread();
 
-                case TexelFilter::eLinear:
-                    switch (mipmapMode)
+                if (g_JobSystem)
+                {
+                    if (auto* entry = findJob())
                     {
-                        case MipmapMode::eNone:
-                            result = GL_LINEAR;
-                            break;
-                        case MipmapMode::eNearest:
-                            result = GL_LINEAR_MIPMAP_NEAREST;
-                            break;
-                        case MipmapMode::eLinear:
-                            result = GL_LINEAR_MIPMAP_LINEAR;
-                            break;
+                        execute(entry);
+                        continue;
                     }
-                    break;
+                }
+                std::this_thread::yield();
             }
-            assert(result != GL_NONE);
-            return result;
         }
-        GLenum getIndexDataType(GLsizei stride)
+
+        void runOnGLThread(Job job, Counter* counter)
         {
-            switch (stride)
+            if (counter)
+                counter->add();
+
+            if (!g_JobSystem)
             {
-                case sizeof(GLubyte):
-                    return GL_UNSIGNED_BYTE;
-                case sizeof(GLushort):
-                    return GL_UNSIGNED_SHORT;
-                case sizeof(GLuint):
-                    return GL_UNSIGNED_INT;
+                execute(new JobEntry {std::move(job), counter});
+                return;
             }
-            assert(false);
-            return GL_NONE;
-        }
 
-        GLenum getPolygonOffsetCap(PolygonMode polygonMode)
-        {
-            switch (polygonMode)
             {
-                case PolygonMode::eFill:
-                    return GL_POLYGON_OFFSET_FILL;
-                case PolygonMode::eLine:
-                    return GL_POLYGON_OFFSET_LINE;
-                case PolygonMode::ePoint:
-                    return GL_POLYGON_OFFSET_POINT;
+                std::lock_guard lock {g_JobSystem->glThreadMutex};
+                g_JobSystem->glThreadJobs.push_back({std::move(job), counter});
             }
-            assert(false);
-            return GL_NONE;
-        }
 
-        RenderContext::RenderContext() { glCreateVertexArrays(1, &m_DummyVAO); }
+            if (renderer::isLoaded())
+                renderer::getGraphicsContext().getWindow()->requestRedraw();
+        }
 
-        RenderContext::~RenderContext()
+        void pumpGLThread()
         {
-            glDeleteVertexArrays(1, &m_DummyVAO);
-            for (auto [_, vao] : m_VertexArrays)
-                glDeleteVertexArrays(1, &vao);
+            if (!g_JobSystem)
+                return;
 
-            m_CurrentPipeline = {};
-        }
+            assert(isGLThread());
 
-        RenderContext& RenderContext::setViewport(const Rect2D& rect)
-        {
-            auto& current = m_CurrentPipeline.m_Viewport;
-            if (rect != current)
+            std::vector<JobEntry> jobs;
             {
-                glViewport(rect.offset.x, rect.offset.y, rect.extent.width, rect.extent.height);
-                current = rect;
+                std::lock_guard lock {g_JobSystem->glThreadMutex};
+                jobs.swap(g_JobSystem->glThreadJobs);
+            }
+            for (auto& entry : jobs)
+            {
+                entry.job();
+                if (entry.counter)
+                    entry.counter->done();
             }
-            return *this;
         }
 
-        Rect2D RenderContext::getViewport()
+        void parallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& fn)
         {
-            GLint viewport[4];
-            glGetIntegerv(GL_VIEWPORT, viewport);
+            VGFW_PROFILE_FUNCTION
+            assert(grainSize > 0);
 
-            return {{viewport[0], viewport[1]},
-                    {static_cast<uint32_t>(viewport[2]), static_cast<uint32_t>(viewport[3])}};
+            const auto numChunks = getNumChunks(count, grainSize);
+            if (numChunks == 0)
+                return;
+
+            // Chunks are claimed dynamically, so a slow chunk never stalls the others
+            std::atomic<uint32_t> nextChunk {0};
+            const auto            runChunks = [&] {
+                for (auto chunk = nextChunk.fetch_add(1); chunk < numChunks; chunk = nextChunk.fetch_add(1))
+                {
+                    const auto begin = chunk * grainSize;
+                    fn(begin, std::min(begin + grainSize, count));
+                }
+            };
+
+            Counter    counter;
+            const auto numHelpers = std::min(numChunks, getNumThreads()) - 1;
+            for (uint32_t i {0}; i < numHelpers; ++i)
+                run(runChunks, &counter);
+
+            runChunks();
+            wait(counter);
         }
+    } // namespace jobs
 
-        RenderContext& RenderContext::setScissor(const Rect2D& rect)
+    namespace memory
+    {
+        // Defined here only, so that every translation unit shares the arena through getFrameArena
+        static FrameArena g_FrameArena;
+
+        FrameArena::FrameArena(size_t initialCapacity, std::pmr::memory_resource* upstream) :
+            m_Upstream {upstream}, m_InitialCapacity {initialCapacity}
         {
-            auto& current = m_CurrentPipeline.m_Scissor;
-            if (rect != current)
-            {
-                glScissor(rect.offset.x, rect.offset.y, rect.extent.width, rect.extent.height);
-                current = rect;
-            }
-            return *this;
+            assert(upstream);
         }
 
-        Buffer RenderContext::createBuffer(GLsizeiptr size, const void* data)
+        FrameArena::~FrameArena()
         {
-            GLuint buffer;
-            glCreateBuffers(1, &buffer);
-            glNamedBufferStorage(buffer, size, data, GL_DYNAMIC_STORAGE_BIT);
-
-            return {buffer, size};
+            for (auto& block : m_Blocks)
+                releaseBlock(block);
         }
 
-        VertexBuffer RenderContext::createVertexBuffer(GLsizei stride, int64_t capacity, const void* data)
+        void FrameArena::nextFrame()
         {
-            return VertexBuffer {createBuffer(stride * capacity, data), stride};
+            m_Current ^= 1;
+            auto& block = m_Blocks[m_Current];
+
+            // The half held the frame before last, it can be reallocated
+            if (block.overflowBytes > 0)
+            {
+                const auto capacity = std::bit_ceil(block.capacity + block.overflowBytes);
+                releaseBlock(block);
+                allocateBlock(block, capacity);
+            }
+            block.offset        = 0;
+            block.overflowBytes = 0;
         }
 
-        IndexBuffer RenderContext::createIndexBuffer(IndexType indexType, int64_t capacity, const void* data)
+        size_t FrameArena::getCapacity() const { return std::max(m_Blocks[m_Current].capacity, m_InitialCapacity); }
+
+        size_t FrameArena::getUsedBytes() const
         {
-            const auto stride = static_cast<GLsizei>(indexType);
-            return IndexBuffer {createBuffer(stride * capacity, data), indexType};
+            const auto& block = m_Blocks[m_Current];
+            return block.offset + block.overflowBytes;
         }
 
-        GLuint RenderContext::getVertexArray(const VertexAttributes& attributes)
+        void* FrameArena::do_allocate(size_t bytes, size_t alignment)
         {
-            assert(!attributes.empty());
-
-            std::size_t hash {0};
-            for (const auto& [location, attribute] : attributes)
-                utils::hashCombine(hash, location, attribute);
+            auto& block = m_Blocks[m_Current];
+            if (!block.data)
+                allocateBlock(block, m_InitialCapacity);
 
-            auto it = m_VertexArrays.find(hash);
-            if (it == m_VertexArrays.cend())
+            void* p     = block.data + block.offset;
+            auto  space = block.capacity - block.offset;
+            if (std::align(alignment, bytes, p, space))
             {
-                it = m_VertexArrays.emplace(hash, createVertexArray(attributes)).first;
-                VGFW_TRACE("[RenderContext] Created VAO: {0}", hash);
+                block.offset = static_cast<size_t>(static_cast<std::byte*>(p) - block.data) + bytes;
+            }
+            else
+            {
+                p = m_Upstream->allocate(bytes, alignment);
+                block.overflowBytes += bytes;
+                ++m_NumOverflows;
             }
 
-            return it->second;
+            m_PeakBytes = std::max(m_PeakBytes, getUsedBytes());
+            return p;
         }
 
-        GLuint RenderContext::createGraphicsProgram(const std::string&                vertSource,
-                                                    const std::string&                fragSource,
-                                                    const std::optional<std::string>& geomSource)
+        void FrameArena::do_deallocate(void* p, size_t bytes, size_t alignment)
         {
-            return createShaderProgram({
-                createShaderObject(GL_VERTEX_SHADER, vertSource),
-                geomSource ? createShaderObject(GL_GEOMETRY_SHADER, *geomSource) : GL_NONE,
-                createShaderObject(GL_FRAGMENT_SHADER, fragSource),
-            });
+            // Arena memory is reclaimed by nextFrame, only overflow allocations go back upstream
+            if (!m_Blocks[0].contains(p) && !m_Blocks[1].contains(p))
+                m_Upstream->deallocate(p, bytes, alignment);
         }
 
-        GLuint RenderContext::createComputeProgram(const std::string& compSource)
+        bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept { return this == &other; }
+
+        bool FrameArena::Block::contains(const void* p) const
         {
-            return createShaderProgram({
-                createShaderObject(GL_COMPUTE_SHADER, compSource),
-            });
+            return data && std::less_equal<const void*> {}(data, p) && std::less<const void*> {}(p, data + capacity);
         }
 
-        Texture RenderContext::createTexture2D(Extent2D    extent,
-                                               PixelFormat pixelFormat,
-                                               uint32_t    numMipLevels,
-                                               uint32_t    numLayers)
+        void FrameArena::allocateBlock(Block& block, size_t capacity)
         {
-            assert(extent.width > 0 && extent.height > 0 && pixelFormat != PixelFormat::eUnknown);
-
-            if (numMipLevels <= 0)
-                numMipLevels = calcMipLevels(glm::max(extent.width, extent.height));
-
-            return createImmutableTexture(extent, 0, pixelFormat, 1, numMipLevels, numLayers);
+            block.data     = static_cast<std::byte*>(m_Upstream->allocate(capacity, alignof(std::max_align_t)));
+            block.capacity = capacity;
         }
 
-        Texture RenderContext::createTexture3D(Extent2D extent, uint32_t depth, PixelFormat pixelFormat)
+        void FrameArena::releaseBlock(Block& block)
         {
-            return createImmutableTexture(extent, depth, pixelFormat, 1, 1, 0);
+            if (block.data)
+                m_Upstream->deallocate(block.data, block.capacity, alignof(std::max_align_t));
+            block = {};
         }
 
-        Texture
-        RenderContext::createCubemap(uint32_t size, PixelFormat pixelFormat, uint32_t numMipLevels, uint32_t numLayers)
+        FrameArena& getFrameArena() { return g_FrameArena; }
+    } // namespace memory
+
+    namespace window
+    {
+        bool GLFWWindow::init(const WindowInitInfo& initInfo)
         {
-            assert(size > 0 && pixelFormat != PixelFormat::eUnknown);
+            if (!glfwInit())
+            {
+                VGFW_ERROR("Failed to initialize GLFW");
+                return false;
+            }
 
-            if (numMipLevels <= 0)
-                numMipLevels = calcMipLevels(size);
+            glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_API);
+            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, VGFW_RENDER_API_OPENGL_MIN_MAJOR);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, VGFW_RENDER_API_OPENGL_MIN_MINOR);
 
-            return createImmutableTexture({size, size}, 0, pixelFormat, 6, numMipLevels, numLayers);
-        }
+            glfwWindowHint(GLFW_SAMPLES, static_cast<int>(initInfo.aaSample));
+            glfwWindowHint(GLFW_RESIZABLE, initInfo.isResizable);
+            glfwWindowHint(GLFW_VISIBLE, initInfo.isVisible);
 
-        RenderContext& RenderContext::generateMipmaps(Texture& texture)
-        {
-            assert(texture);
-            glGenerateTextureMipmap(texture.m_Id);
+            GLFWmonitor*       primaryMonitor = glfwGetPrimaryMonitor();
+            const GLFWvidmode* mode           = glfwGetVideoMode(primaryMonitor);
 
-            return *this;
-        }
+            GLFWmonitor* requestMonitor = nullptr;
+            int          requestWidth   = initInfo.width;
+            int          requestHeight  = initInfo.height;
 
-        RenderContext& RenderContext::setupSampler(Texture& texture, const SamplerInfo& samplerInfo)
-        {
-            assert(texture);
+            if (initInfo.isFullScreen)
+            {
+                requestMonitor = primaryMonitor;
+                requestWidth   = mode->width;
+                requestHeight  = mode->height;
+            }
 
-            glTextureParameteri(texture.m_Id,
-                                GL_TEXTURE_MIN_FILTER,
-                                selectTextureMinFilter(samplerInfo.minFilter, samplerInfo.mipmapMode));
-            glTextureParameteri(texture.m_Id, GL_TEXTURE_MAG_FILTER, static_cast<GLenum>(samplerInfo.magFilter));
-            glTextureParameteri(texture.m_Id, GL_TEXTURE_WRAP_S, static_cast<GLenum>(samplerInfo.addressModeS));
-            glTextureParameteri(texture.m_Id, GL_TEXTURE_WRAP_T, static_cast<GLenum>(samplerInfo.addressModeT));
-            glTextureParameteri(texture.m_Id, GL_TEXTURE_WRAP_R, static_cast<GLenum>(samplerInfo.addressModeR));
+            m_Window = glfwCreateWindow(requestWidth, requestHeight, initInfo.title.c_str(), requestMonitor, nullptr);
+            if (!m_Window)
+            {
+                VGFW_ERROR("Failed to create GLFW window");
+                glfwTerminate();
+                return false;
+            }
 
-            glTextureParameterf(texture.m_Id, GL_TEXTURE_MAX_ANISOTROPY, samplerInfo.maxAnisotropy);
+            m_Data.title          = initInfo.title;
+            m_Data.width          = initInfo.width;
+            m_Data.height         = initInfo.height;
+            m_Data.platformWindow = this;
 
-            if (samplerInfo.compareOperator.has_value())
+            setEventDriven(initInfo.isEventDriven);
+
+            // Installed before ImGui, which chains them
+            glfwSetWindowUserPointer(m_Window, &m_Data);
+            glfwSetWindowSizeCallback(m_Window, [](GLFWwindow* window, int width, int height) {
+                auto& data  = *static_cast<WindowData*>(glfwGetWindowUserPointer(window));
+                data.width  = width;
+                data.height = height;
+                data.platformWindow->onEvent();
+            });
+            glfwSetWindowRefreshCallback(m_Window, [](GLFWwindow* window) {
+                static_cast<WindowData*>(glfwGetWindowUserPointer(window))->platformWindow->onEvent();
+            });
+            glfwSetWindowFocusCallback(m_Window, [](GLFWwindow* window, int) {
+                static_cast<WindowData*>(glfwGetWindowUserPointer(window))->platformWindow->onEvent();
+            });
+            glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int, int, int, int) {
+                static_cast<WindowData*>(glfwGetWindowUserPointer(window))->platformWindow->onEvent();
+            });
+            glfwSetCharCallback(m_Window, [](GLFWwindow* window, unsigned int) {
+                static_cast<WindowData*>(glfwGetWindowUserPointer(window))->platformWindow->onEvent();
+            });
+            glfwSetMouseButtonCallback(m_Window, [](GLFWwindow* window, int, int, int) {
+                static_cast<WindowData*>(glfwGetWindowUserPointer(window))->platformWindow->onEvent();
+            });
+            glfwSetCursorPosCallback(m_Window, [](GLFWwindow* window, double, double) {
+                static_cast<WindowData*>(glfwGetWindowUserPointer(window))->platformWindow->onEvent();
+            });
+            glfwSetScrollCallback(m_Window, [](GLFWwindow* window, double, double) {
+                static_cast<WindowData*>(glfwGetWindowUserPointer(window))->platformWindow->onEvent();
+            });
+
+            return true;
+        }
+
+        void GLFWWindow::shutdown()
+        {
+            if (m_Window)
             {
-                glTextureParameteri(texture.m_Id, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
-                glTextureParameteri(
-                    texture.m_Id, GL_TEXTURE_COMPARE_FUNC, static_cast<GLenum>(*samplerInfo.compareOperator));
+                glfwDestroyWindow(m_Window);
+                m_Window = nullptr;
             }
-            glTextureParameterfv(texture.m_Id, GL_TEXTURE_BORDER_COLOR, glm::value_ptr(samplerInfo.borderColor));
 
-            return *this;
+            glfwTerminate();
         }
 
-        GLuint RenderContext::createSampler(const SamplerInfo& samplerInfo)
+        void GLFWWindow::onTick()
         {
-            GLuint sampler {GL_NONE};
-            glCreateSamplers(1, &sampler);
+            VGFW_PROFILE_FUNCTION
 
-            glSamplerParameteri(
-                sampler, GL_TEXTURE_MIN_FILTER, selectTextureMinFilter(samplerInfo.minFilter, samplerInfo.mipmapMode));
-            glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, static_cast<GLenum>(samplerInfo.magFilter));
-            glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, static_cast<GLenum>(samplerInfo.addressModeS));
-            glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, static_cast<GLenum>(samplerInfo.addressModeT));
-            glSamplerParameteri(sampler, GL_TEXTURE_WRAP_R, static_cast<GLenum>(samplerInfo.addressModeR));
+            // A minimized window has nothing to draw in either mode, block until it is restored (or requestRedraw)
+            if (isMinimized())
+                glfwWaitEvents();
+            else if (m_EventDriven && m_PendingRedraws.load() == 0)
+                glfwWaitEventsTimeout(m_IdleTimeout.count());
+            else
+                glfwPollEvents();
+            m_LastPollTime = time::Clock::now();
 
-            glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY, samplerInfo.maxAnisotropy);
+            if (isMinimized())
+            {
+                m_ShouldRedraw = false;
+                return;
+            }
 
-            if (samplerInfo.compareOperator.has_value())
+            if (!m_EventDriven)
             {
-                glSamplerParameteri(sampler, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
-                glSamplerParameteri(
-                    sampler, GL_TEXTURE_COMPARE_FUNC, static_cast<GLenum>(*samplerInfo.compareOperator));
+                m_ShouldRedraw = true;
+                return;
             }
-            glSamplerParameterfv(sampler, GL_TEXTURE_BORDER_COLOR, glm::value_ptr(samplerInfo.borderColor));
 
-            return sampler;
+            auto pending = m_PendingRedraws.load();
+            while (pending > 0 && !m_PendingRedraws.compare_exchange_weak(pending, pending - 1))
+            {
+            }
+            m_ShouldRedraw = pending > 0;
         }
 
-        RenderContext& RenderContext::clear(Texture& texture)
+        void GLFWWindow::requestRedraw()
         {
-            assert(texture);
-            uint8_t v {0};
-            glClearTexImage(texture.m_Id, 0, GL_RED, GL_UNSIGNED_BYTE, &v);
-
-            return *this;
+            auto pending = m_PendingRedraws.load();
+            while (pending == 0 && !m_PendingRedraws.compare_exchange_weak(pending, 1))
+            {
+            }
+            glfwPostEmptyEvent();
         }
 
-        RenderContext&
-        RenderContext::upload(Texture& texture, GLint mipLevel, glm::uvec2 dimensions, const ImageData& image)
+        void GLFWWindow::onEvent()
         {
-            return upload(texture, mipLevel, {dimensions, 0}, 0, 0, image);
-        }
+            // ImGui reacts to input one frame late, so input buys two frames
+            constexpr uint32_t kInputRedraws {2};
 
-        RenderContext& RenderContext::upload(Texture&         texture,
-                                             GLint            mipLevel,
-                                             GLint            face,
-                                             glm::uvec2       dimensions,
-                                             const ImageData& image)
-        {
-            return upload(texture, mipLevel, {dimensions, 0}, face, 0, image);
+            auto pending = m_PendingRedraws.load();
+            while (pending < kInputRedraws && !m_PendingRedraws.compare_exchange_weak(pending, kInputRedraws))
+            {
+            }
         }
 
-        RenderContext& RenderContext::upload(Texture&          texture,
-                                             GLint             mipLevel,
-                                             const glm::uvec3& dimensions,
-                                             GLint             face,
-                                             GLsizei           layer,
-                                             const ImageData&  image)
+        bool GLFWWindow::shouldClose() const { return m_Window && glfwWindowShouldClose(m_Window); }
+
+        bool GLFWWindow::isMinimized() const
         {
-            assert(texture && image.pixels != nullptr);
+            if (m_Window)
+            {
+                int width, height;
+                glfwGetWindowSize(m_Window, &width, &height);
+                return width == 0 || height == 0;
+            }
 
-            switch (texture.m_Type)
+            return false;
+        }
+
+        void GLFWWindow::makeCurrentContext()
+        {
+            if (m_Window)
             {
-                case GL_TEXTURE_1D:
-                    glTextureSubImage1D(
-                        texture.m_Id, mipLevel, 0, dimensions.x, image.format, image.dataType, image.pixels);
-                    break;
-                case GL_TEXTURE_1D_ARRAY:
-                    glTextureSubImage2D(
-                        texture.m_Id, mipLevel, 0, 0, dimensions.x, layer, image.format, image.dataType, image.pixels);
-                    break;
-                case GL_TEXTURE_2D:
-                    glTextureSubImage2D(texture.m_Id,
-                                        mipLevel,
-                                        0,
-                                        0,
-                                        dimensions.x,
-                                        dimensions.y,
-                                        image.format,
-                                        image.dataType,
-                                        image.pixels);
+                glfwMakeContextCurrent(m_Window);
+            }
+        }
+
+        void GLFWWindow::swapBuffers()
+        {
+            if (m_Window)
+            {
+                glfwSwapBuffers(m_Window);
+            }
+
+            VGFW_PROFILE_GL_COLLECT
+        }
+
+        void GLFWWindow::setHideCursor(bool hide)
+        {
+            if (m_Window)
+            {
+                glfwSetInputMode(m_Window, GLFW_CURSOR, hide ? GLFW_CURSOR_HIDDEN : GLFW_CURSOR_NORMAL);
+            }
+        }
+
+        bool NullWindow::init(const WindowInitInfo& initInfo)
+        {
+            m_Width  = initInfo.width;
+            m_Height = initInfo.height;
+            setEventDriven(initInfo.isEventDriven);
+            return true;
+        }
+
+        void NullWindow::onTick()
+        {
+            VGFW_PROFILE_FUNCTION
+
+            m_LastPollTime = time::Clock::now();
+
+            // Nothing but requestRedraw wakes up an event-driven null window, and nothing blocks either
+            auto pending = m_PendingRedraws.load();
+            while (pending > 0 && !m_PendingRedraws.compare_exchange_weak(pending, pending - 1))
+            {
+            }
+            m_ShouldRedraw = !m_EventDriven || pending > 0;
+        }
+
+        void NullWindow::swapBuffers() { VGFW_PROFILE_GL_COLLECT }
+
+        void NullWindow::requestRedraw()
+        {
+            auto pending = m_PendingRedraws.load();
+            while (pending == 0 && !m_PendingRedraws.compare_exchange_weak(pending, 1))
+            {
+            }
+        }
+
+        std::shared_ptr<Window> create(const WindowInitInfo& windowInitInfo, WindowType type)
+        {
+            std::shared_ptr<Window> window = nullptr;
+
+            switch (type)
+            {
+                case WindowType::eGLFW:
+                    window = std::make_shared<GLFWWindow>();
                     break;
-                case GL_TEXTURE_2D_ARRAY:
-                    glTextureSubImage3D(texture.m_Id,
-                                        mipLevel,
-                                        0,
-                                        0,
-                                        layer,
-                                        dimensions.x,
-                                        dimensions.y,
-                                        1,
-                                        image.format,
-                                        image.dataType,
-                                        image.pixels);
+
+                case WindowType::eNull:
+#ifdef VGFW_NULL_GL
+                    window = std::make_shared<NullWindow>();
+#else
+                    VGFW_ERROR("NullWindow has no GL context, define VGFW_NULL_GL to use it");
+#endif
                     break;
-                case GL_TEXTURE_3D:
-                    glTextureSubImage3D(texture.m_Id,
-                                        mipLevel,
-                                        0,
-                                        0,
-                                        0,
-                                        dimensions.x,
-                                        dimensions.y,
-                                        dimensions.z,
-                                        image.format,
-                                        image.dataType,
-                                        image.pixels);
+            }
+
+            if (!window || !window->init(windowInitInfo))
+            {
+                throw std::runtime_error("Failed to initialize window!");
+            }
+
+            return window;
+        }
+    } // namespace window
+
+    namespace renderer
+    {
+        GpuScope::GpuScope(std::string_view name) : m_Index {g_GpuProfiler.beginScope(name)} {}
+        GpuScope::~GpuScope() { g_GpuProfiler.endScope(m_Index); }
+
+        DebugMarker::DebugMarker(std::string_view name) : m_GpuScope {name}
+        {
+            glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name.data());
+        }
+        DebugMarker::~DebugMarker() { glPopDebugGroup(); }
+
+        void GraphicsContext::init(const std::shared_ptr<window::Window>& window)
+        {
+            m_Window = window;
+
+            window->makeCurrentContext();
+            setVSync(false);
+
+            int version = loadGl();
+
+            assert(version);
+            if (version)
+            {
+                int minMajor = getMinMajor();
+                int minMinor = getMinMinor();
+                VGFW_INFO("[GraphicsContext] Loaded OpenGL {0}.{1}", GLVersion.major, GLVersion.minor);
+
+                std::stringstream ss;
+                ss << "    Vendor:       " << glGetString(GL_VENDOR) << std::endl;
+                ss << "    Version:      " << glGetString(GL_VERSION) << std::endl;
+                ss << "    Renderer:     " << glGetString(GL_RENDERER) << std::endl;
+                ss << "    GLSL Version: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << std::endl;
+
+                VGFW_INFO("[GraphicsContext] OpenGL Context Info:\n {0}", ss.str());
+
+                assert(GLVersion.major > minMajor || (GLVersion.major == minMajor && GLVersion.minor >= minMinor));
+            }
+
+            m_SupportDSA = GLAD_GL_VERSION_4_5 || GLAD_GL_VERSION_4_6;
+
+            VGFW_PROFILE_GL_INIT_CONTEXT
+        }
+
+        void GraphicsContext::shutdown() { m_Window->shutdown(); }
+
+        void GraphicsContext::swapBuffers() { m_Window->swapBuffers(); }
+
+        void GraphicsContext::setVSync(bool vsyncEnabled)
+        {
+            setVSyncMode(vsyncEnabled ? VSyncMode::eOn : VSyncMode::eOff);
+        }
+
+        void GraphicsContext::setVSyncMode(VSyncMode mode)
+        {
+            // No GLFW context to apply a swap interval to (window::NullWindow)
+            if (!glfwGetCurrentContext())
+                return;
+
+            if (mode == VSyncMode::eAdaptive && !glfwExtensionSupported("WGL_EXT_swap_control_tear") &&
+                !glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+            {
+                VGFW_WARN("[GraphicsContext] Adaptive VSync is not supported, falling back to VSync");
+                mode = VSyncMode::eOn;
+            }
+            glfwSwapInterval(static_cast<int>(mode));
+        }
+
+        void FramePacer::init(const FramePacingInfo& info)
+        {
+            m_Info = info;
+            GraphicsContext::setVSyncMode(m_Info.vsyncMode);
+            m_LastFrameEnd = time::Clock::now();
+        }
+
+        void FramePacer::shutdown()
+        {
+            for (auto& frame : m_InFlightFrames)
+                glDeleteSync(frame.fence);
+            m_InFlightFrames.clear();
+        }
+
+        void FramePacer::onPresent()
+        {
+            VGFW_PROFILE_FUNCTION
+
+            const auto waitStart = time::Clock::now();
+
+            m_InFlightFrames.push_back({
+                .fence      = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0),
+                .submitTime = waitStart,
+            });
+            retireFrames(false);
+            retireFrames(true);
+            limitFrameRate();
+
+            m_LastFrameEnd         = time::Clock::now();
+            m_Stats.cpuWait        = m_LastFrameEnd - waitStart;
+            m_Stats.framesInFlight = static_cast<uint32_t>(m_InFlightFrames.size());
+        }
+
+        void FramePacer::setMaxFramesInFlight(uint32_t n) { m_Info.maxFramesInFlight = std::max(n, 1u); }
+
+        void FramePacer::setVSyncMode(VSyncMode mode)
+        {
+            m_Info.vsyncMode = mode;
+            GraphicsContext::setVSyncMode(mode);
+        }
+
+        void FramePacer::setTargetFrameRate(std::optional<float> fps) { m_Info.targetFrameRate = fps; }
+
+        void FramePacer::retireFrames(bool block)
+        {
+            // Non-blocking: drop every frame the GPU already finished. Blocking: wait until we are within the limit.
+            while (!m_InFlightFrames.empty())
+            {
+                if (block && m_InFlightFrames.size() <= m_Info.maxFramesInFlight)
                     break;
-                case GL_TEXTURE_CUBE_MAP:
-                    glTextureSubImage3D(texture.m_Id,
-                                        mipLevel,
-                                        0,
-                                        0,
-                                        face,
-                                        dimensions.x,
-                                        dimensions.y,
-                                        1,
-                                        image.format,
-                                        image.dataType,
-                                        image.pixels);
+
+                auto&          frame   = m_InFlightFrames.front();
+                const GLuint64 timeout = block ? std::numeric_limits<GLuint64>::max() : 0;
+                const auto     result  = glClientWaitSync(frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+                if (result == GL_TIMEOUT_EXPIRED)
                     break;
-                case GL_TEXTURE_CUBE_MAP_ARRAY: {
-                    const auto zoffset = (layer * 6) + face; // desired layer-face
-                    // depth = how many layer-faces
-                    glTextureSubImage3D(texture.m_Id,
-                                        mipLevel,
-                                        0,
-                                        0,
-                                        zoffset,
-                                        dimensions.x,
-                                        dimensions.y,
-                                        6 * texture.m_NumLayers,
-                                        image.format,
-                                        image.dataType,
-                                        image.pixels);
-                }
-                break;
 
-                default:
-                    assert(false);
+                m_Stats.gpuLatency = time::Clock::now() - frame.submitTime;
+                glDeleteSync(frame.fence);
+                m_InFlightFrames.pop_front();
             }
-            return *this;
         }
 
-        RenderContext& RenderContext::clear(Buffer& buffer)
+        void FramePacer::limitFrameRate()
         {
-            assert(buffer);
+            if (!m_Info.targetFrameRate || *m_Info.targetFrameRate <= 0.0f)
+                return;
 
-            uint8_t v {0};
-            glClearNamedBufferData(buffer.m_Id, GL_R8, GL_RED, GL_UNSIGNED_BYTE, &v);
+            VGFW_PROFILE_NAMED_SCOPE("Frame Rate Limiter")
 
-            return *this;
+            // OS sleep granularity is around 1ms (worse on Windows without timeBeginPeriod), spin for the rest
+            constexpr time::Duration kSpinThreshold {0.002f};
+
+            const auto deadline =
+                m_LastFrameEnd + std::chrono::duration_cast<time::Clock::duration>(
+                                     time::Duration(1.0f / *m_Info.targetFrameRate));
+
+            if (const auto remaining = deadline - time::Clock::now(); remaining > kSpinThreshold)
+                std::this_thread::sleep_for(remaining - kSpinThreshold);
+            while (time::Clock::now() < deadline)
+                std::this_thread::yield();
         }
 
-        RenderContext& RenderContext::upload(Buffer& buffer, GLintptr offset, GLsizeiptr size, const void* data)
+        void LatencyTracker::init(uint32_t historySize)
         {
-            assert(buffer);
+            m_Enabled     = true;
+            m_HistorySize = std::max(historySize, 1u);
+            m_Samples.clear();
+            m_Samples.reserve(m_HistorySize);
+            m_NextSample = 0;
+            calibrate();
+        }
 
-            if (size > 0 && data != nullptr)
-                glNamedBufferSubData(buffer.m_Id, offset, size, data);
+        void LatencyTracker::shutdown()
+        {
+            if (!m_Enabled)
+                return;
 
-            return *this;
+            for (const auto& frame : m_PendingFrames)
+                m_FreeQueries.push_back(frame.query);
+            m_PendingFrames.clear();
+            if (!m_FreeQueries.empty())
+                glDeleteQueries(static_cast<GLsizei>(m_FreeQueries.size()), m_FreeQueries.data());
+            m_FreeQueries.clear();
+
+            m_Enabled = false;
+        }
+
+        void LatencyTracker::onPresent(time::TimePoint inputTime)
+        {
+            VGFW_PROFILE_FUNCTION
+
+            collect();
+
+            // Resync every few seconds, the GPU and CPU clocks drift apart
+            if (m_FrameIndex % 512 == 0)
+                calibrate();
+
+            GLuint query {GL_NONE};
+            if (m_FreeQueries.empty())
+            {
+                glGenQueries(1, &query);
+            }
+            else
+            {
+                query = m_FreeQueries.back();
+                m_FreeQueries.pop_back();
+            }
+            glQueryCounter(query, GL_TIMESTAMP);
+
+            m_PendingFrames.push_back({
+                .query      = query,
+                .frameIndex = m_FrameIndex++,
+                .inputTime  = inputTime,
+                .submitTime = time::Clock::now(),
+            });
+        }
+
+        void LatencyTracker::calibrate()
+        {
+            GLint64 gpuTime {0};
+            glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+            const auto cpuTime =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(time::Clock::now().time_since_epoch()).count();
+            m_GpuToCpuOffset = gpuTime - cpuTime;
+        }
+
+        void LatencyTracker::collect()
+        {
+            while (!m_PendingFrames.empty())
+            {
+                const auto& frame = m_PendingFrames.front();
+
+                GLint available {GL_FALSE};
+                glGetQueryObjectiv(frame.query, GL_QUERY_RESULT_AVAILABLE, &available);
+                if (!available)
+                    break;
+
+                GLuint64 gpuTime {0};
+                glGetQueryObjectui64v(frame.query, GL_QUERY_RESULT, &gpuTime);
+
+                const time::TimePoint completeTime {std::chrono::duration_cast<time::Clock::duration>(
+                    std::chrono::nanoseconds(static_cast<int64_t>(gpuTime) - m_GpuToCpuOffset))};
+
+                FrameLatencySample sample {
+                    .frameIndex    = frame.frameIndex,
+                    .inputToSubmit = frame.submitTime - frame.inputTime,
+                    .submitToGpu   = std::max(completeTime - frame.submitTime, time::Clock::duration::zero()),
+                    .inputToGpu    = std::max(completeTime - frame.inputTime, time::Clock::duration::zero()),
+                };
+
+                if (m_Samples.size() < m_HistorySize)
+                    m_Samples.push_back(sample);
+                else
+                    m_Samples[m_NextSample] = sample;
+                m_NextSample = (m_NextSample + 1) % m_HistorySize;
+
+                m_FreeQueries.push_back(frame.query);
+                m_PendingFrames.pop_front();
+            }
+        }
+
+        LatencyReport LatencyTracker::getReport() const
+        {
+            LatencyReport report {.numSamples = static_cast<uint32_t>(m_Samples.size())};
+            if (m_Samples.empty())
+                return report;
+
+            std::vector<float> values(m_Samples.size());
+
+            const auto collectMs = [this, &values](time::Duration FrameLatencySample::*member) {
+                std::transform(m_Samples.begin(), m_Samples.end(), values.begin(), [member](const auto& sample) {
+                    return (sample.*member).count() * 1000.0f;
+                });
+                std::sort(values.begin(), values.end());
+
+                const auto percentile = [&values](float p) {
+                    return values[static_cast<size_t>(p * static_cast<float>(values.size() - 1) + 0.5f)];
+                };
+                return LatencyDistribution {
+                    .min = values.front(),
+                    .avg = std::accumulate(values.begin(), values.end(), 0.0f) / static_cast<float>(values.size()),
+                    .p50 = percentile(0.50f),
+                    .p95 = percentile(0.95f),
+                    .p99 = percentile(0.99f),
+                    .max = values.back(),
+                };
+            };
+
+            report.inputToSubmit = collectMs(&FrameLatencySample::inputToSubmit);
+            report.submitToGpu   = collectMs(&FrameLatencySample::submitToGpu);
+            report.inputToGpu    = collectMs(&FrameLatencySample::inputToGpu);
+            return report;
+        }
+
+        void LatencyTracker::drawOverlay(bool* open) const
+        {
+            if (!m_Enabled)
+                return;
+
+            constexpr auto kFlags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+                                    ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing |
+                                    ImGuiWindowFlags_NoNav;
+
+            ImGui::SetNextWindowBgAlpha(0.5f);
+            if (ImGui::Begin("Latency", open, kFlags))
+            {
+                const auto report = getReport();
+                const auto row    = [](const char* label, const LatencyDistribution& d) {
+                    ImGui::Text("%-16s avg %6.2f  p50 %6.2f  p95 %6.2f  p99 %6.2f  max %6.2f",
+                                label,
+                                d.avg,
+                                d.p50,
+                                d.p95,
+                                d.p99,
+                                d.max);
+                };
+
+                ImGui::Text("Latency (ms) over %u frames", report.numSamples);
+                ImGui::Separator();
+                row("Input -> Submit", report.inputToSubmit);
+                row("Submit -> GPU", report.submitToGpu);
+                row("Input -> GPU", report.inputToGpu);
+
+                // Oldest sample first
+                std::vector<float> history(m_Samples.size());
+                for (size_t i = 0; i < m_Samples.size(); ++i)
+                {
+                    const auto& sample = m_Samples[(m_NextSample + i) % m_Samples.size()];
+                    history[i]         = sample.inputToGpu.count() * 1000.0f;
+                }
+                ImGui::PlotLines("##InputToGpu",
+                                 history.data(),
+                                 static_cast<int>(history.size()),
+                                 0,
+                                 "Input -> GPU",
+                                 0.0f,
+                                 report.inputToGpu.max,
+                                 ImVec2(0.0f, 60.0f));
+            }
+            ImGui::End();
+        }
+
+        constexpr std::array<GLenum, 3> kPipelineStatisticTargets {
+            GL_VERTICES_SUBMITTED, GL_PRIMITIVES_SUBMITTED, GL_FRAGMENT_SHADER_INVOCATIONS};
+
+        GLuint GpuProfiler::QueryPool::acquire()
+        {
+            if (numUsed == queries.size())
+            {
+                GLuint query {GL_NONE};
+                glGenQueries(1, &query);
+                queries.push_back(query);
+            }
+            return queries[numUsed++];
+        }
+
+        void GpuProfiler::init(bool enablePipelineStatistics)
+        {
+            m_Enabled = true;
+            setPipelineStatisticsEnabled(enablePipelineStatistics);
+        }
+
+        void GpuProfiler::shutdown()
+        {
+            if (!m_Enabled)
+                return;
+
+            for (auto& frame : m_Frames)
+            {
+                if (!frame.timestamps.queries.empty())
+                    glDeleteQueries(static_cast<GLsizei>(frame.timestamps.queries.size()),
+                                    frame.timestamps.queries.data());
+                for (auto& pool : frame.statistics)
+                {
+                    if (!pool.queries.empty())
+                        glDeleteQueries(static_cast<GLsizei>(pool.queries.size()), pool.queries.data());
+                }
+                frame = {};
+            }
+            m_Results.clear();
+            m_Enabled = false;
+        }
+
+        bool GpuProfiler::isPipelineStatisticsSupported() const { return GLAD_GL_VERSION_4_6; }
+
+        void GpuProfiler::setPipelineStatisticsEnabled(bool enabled)
+        {
+            if (enabled && !isPipelineStatisticsSupported())
+            {
+                VGFW_WARN("[GpuProfiler] Pipeline statistics queries require OpenGL 4.6");
+                enabled = false;
+            }
+            m_PipelineStatistics = enabled;
+        }
+
+        void GpuProfiler::beginFrame()
+        {
+            if (!m_Enabled)
+                return;
+
+            auto& frame = m_Frames[m_FrameIndex % kNumFrames];
+            if (frame.pending)
+                resolve(frame);
+
+            frame.index = m_FrameIndex;
+            frame.scopes.clear();
+            frame.timestamps.numUsed = 0;
+            for (auto& pool : frame.statistics)
+                pool.numUsed = 0;
+
+            m_Depth   = 0;
+            m_InFrame = true;
+        }
+
+        void GpuProfiler::endFrame()
+        {
+            if (!m_Enabled || !m_InFrame)
+                return;
+
+            auto& frame   = m_Frames[m_FrameIndex % kNumFrames];
+            frame.pending = !frame.scopes.empty();
+
+            m_InFrame = false;
+            ++m_FrameIndex;
+        }
+
+        int32_t GpuProfiler::beginScope(std::string_view name)
+        {
+            if (!m_InFrame)
+                return -1;
+
+            auto& frame = m_Frames[m_FrameIndex % kNumFrames];
+            auto& scope = frame.scopes.emplace_back();
+            scope.name  = name;
+            scope.depth = m_Depth++;
+            scope.begin = frame.timestamps.acquire();
+            scope.end   = frame.timestamps.acquire();
+            glQueryCounter(scope.begin, GL_TIMESTAMP);
+            scope.cpuBegin = time::Clock::now();
+
+            if (m_PipelineStatistics && scope.depth == 0)
+            {
+                scope.hasStatistics = true;
+                for (uint32_t i {0}; i < kNumStatistics; ++i)
+                {
+                    scope.statistics[i] = frame.statistics[i].acquire();
+                    glBeginQuery(kPipelineStatisticTargets[i], scope.statistics[i]);
+                }
+            }
+
+            return static_cast<int32_t>(frame.scopes.size() - 1);
+        }
+
+        void GpuProfiler::endScope(int32_t index)
+        {
+            if (!m_InFrame || index < 0)
+                return;
+
+            const auto cpuEnd   = time::Clock::now();
+            auto&      scope    = m_Frames[m_FrameIndex % kNumFrames].scopes[index];
+            scope.cpuDurationMs = std::chrono::duration<double, std::milli>(cpuEnd - scope.cpuBegin).count();
+            if (scope.hasStatistics)
+            {
+                for (const auto target : kPipelineStatisticTargets)
+                    glEndQuery(target);
+            }
+            glQueryCounter(scope.end, GL_TIMESTAMP);
+            --m_Depth;
+        }
+
+        void GpuProfiler::resolve(Frame& frame)
+        {
+            VGFW_PROFILE_FUNCTION
+            frame.pending = false;
+
+            // Queries complete in order, the last end timestamp being available implies all of them are
+            GLint available {GL_FALSE};
+            glGetQueryObjectiv(frame.scopes.back().end, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+            {
+                // The GPU is more than kNumFrames behind, drop the frame instead of stalling
+                ++m_NumDroppedFrames;
+                return;
+            }
+
+            GLuint64 frameStart {0};
+            glGetQueryObjectui64v(frame.scopes.front().begin, GL_QUERY_RESULT, &frameStart);
+
+            m_Results.clear();
+            for (const auto& scope : frame.scopes)
+            {
+                GLuint64 begin {0}, end {0};
+                glGetQueryObjectui64v(scope.begin, GL_QUERY_RESULT, &begin);
+                glGetQueryObjectui64v(scope.end, GL_QUERY_RESULT, &end);
+
+                auto& result      = m_Results.emplace_back();
+                result.name       = scope.name;
+                result.depth      = scope.depth;
+                result.startMs    = static_cast<double>(begin - frameStart) / 1e6;
+                result.durationMs = static_cast<double>(end - begin) / 1e6;
+
+                result.cpuDurationMs = scope.cpuDurationMs;
+
+                if (scope.hasStatistics)
+                {
+                    std::array<GLuint64, kNumStatistics> values {};
+                    for (uint32_t i {0}; i < kNumStatistics; ++i)
+                        glGetQueryObjectui64v(scope.statistics[i], GL_QUERY_RESULT, &values[i]);
+
+                    result.statistics = PipelineStatistics {
+                        .verticesSubmitted         = values[0],
+                        .primitivesSubmitted       = values[1],
+                        .fragmentShaderInvocations = values[2],
+                    };
+                }
+            }
+            m_ResultsFrameIndex = frame.index;
+        }
+
+        std::string GpuProfiler::exportJson() const
+        {
+            std::string json = fmt::format("{{\"frame\":{0},\"scopes\":[", m_ResultsFrameIndex);
+            for (size_t i = 0; i < m_Results.size(); ++i)
+            {
+                const auto& result = m_Results[i];
+                json += fmt::format("{0}{{\"name\":\"{1}\",\"depth\":{2},\"start_ms\":{3:.4f},\"duration_ms\":{4:.4f}"
+                                    ",\"cpu_ms\":{5:.4f}",
+                                    i > 0 ? "," : "",
+                                    utils::escapeJson(result.name),
+                                    result.depth,
+                                    result.startMs,
+                                    result.durationMs,
+                                    result.cpuDurationMs);
+                if (result.statistics)
+                {
+                    json += fmt::format(",\"vertices\":{0},\"primitives\":{1},\"fragment_invocations\":{2}",
+                                        result.statistics->verticesSubmitted,
+                                        result.statistics->primitivesSubmitted,
+                                        result.statistics->fragmentShaderInvocations);
+                }
+                json += "}";
+            }
+            json += "]}";
+            return json;
+        }
+
+        bool GpuProfiler::exportJson(const std::filesystem::path& filePath) const
+        {
+            return utils::writeFileAllText(filePath, exportJson());
+        }
+
+        void FrameStatsRecorder::init(uint32_t capacity)
+        {
+            m_Capacity = std::max(capacity, 1u);
+            m_Samples.clear();
+            m_Samples.reserve(m_Capacity);
+            m_FrameIndex = 0;
+
+            // Re-initializing (e.g. after a warm-up) drops the samples and the pending GPU times
+            for (auto& queries : m_GpuQueries)
+            {
+                if (queries.begin == GL_NONE)
+                {
+                    glGenQueries(1, &queries.begin);
+                    glGenQueries(1, &queries.end);
+                }
+                queries.pending = false;
+            }
+
+            // Set by the next beginFrame, so loading between init and the first frame is not measured
+            m_LastPresentEnd = {};
+        }
+
+        void FrameStatsRecorder::shutdown()
+        {
+            if (!m_ExitExportPath.empty() && exportToFile(m_ExitExportPath))
+                VGFW_INFO("[FrameStatsRecorder] Exported frame stats: {0}", m_ExitExportPath.generic_string());
+
+            for (auto& queries : m_GpuQueries)
+            {
+                glDeleteQueries(1, &queries.begin);
+                glDeleteQueries(1, &queries.end);
+                queries = {};
+            }
+        }
+
+        void FrameStatsRecorder::beginFrame()
+        {
+            resolveGpuTimes();
+
+            m_FrameBegin = time::Clock::now();
+            m_Current    = {.frameIndex = m_FrameIndex};
+            if (m_LastPresentEnd == time::TimePoint {})
+                m_LastPresentEnd = m_FrameBegin;
+
+            auto& queries = m_GpuQueries[m_FrameIndex % kNumGpuQueryFrames];
+            if (!queries.pending && queries.begin != GL_NONE)
+                glQueryCounter(queries.begin, GL_TIMESTAMP);
+        }
+
+        void FrameStatsRecorder::beginPresent()
+        {
+            m_PresentBegin  = time::Clock::now();
+            m_Current.cpuMs = time::Duration(m_PresentBegin - m_FrameBegin).count() * 1000.0f;
+
+            auto& queries = m_GpuQueries[m_FrameIndex % kNumGpuQueryFrames];
+            if (!queries.pending && queries.end != GL_NONE)
+            {
+                glQueryCounter(queries.end, GL_TIMESTAMP);
+                queries.frameIndex = m_FrameIndex;
+                queries.pending    = true;
+            }
+        }
+
+        void FrameStatsRecorder::endPresent()
+        {
+            const auto now = time::Clock::now();
+
+            m_Current.presentMs = time::Duration(now - m_PresentBegin).count() * 1000.0f;
+            m_Current.frameMs   = time::Duration(now - m_LastPresentEnd).count() * 1000.0f;
+            m_DeltaTime         = m_Current.frameMs / 1000.0f;
+            m_LastPresentEnd    = now;
+
+            if (m_Samples.size() < m_Capacity)
+                m_Samples.push_back(m_Current);
+            else
+                m_Samples[m_FrameIndex % m_Capacity] = m_Current;
+            ++m_FrameIndex;
+        }
+
+        void FrameStatsRecorder::resolveGpuTimes()
+        {
+            for (auto& queries : m_GpuQueries)
+            {
+                if (!queries.pending)
+                    continue;
+
+                GLint available {GL_FALSE};
+                glGetQueryObjectiv(queries.end, GL_QUERY_RESULT_AVAILABLE, &available);
+                if (!available)
+                    continue;
+
+                GLuint64 begin {0}, end {0};
+                glGetQueryObjectui64v(queries.begin, GL_QUERY_RESULT, &begin);
+                glGetQueryObjectui64v(queries.end, GL_QUERY_RESULT, &end);
+                queries.pending = false;
+
+                // The sample may already have been overwritten when the ring is smaller than the query latency
+                auto& sample = m_Samples[queries.frameIndex % m_Capacity];
+                if (sample.frameIndex == queries.frameIndex)
+                    sample.gpuMs = static_cast<float>(static_cast<double>(end - begin) / 1e6);
+            }
+        }
+
+        std::vector<FrameTimeSample> FrameStatsRecorder::getSamples() const
+        {
+            std::vector<FrameTimeSample> samples(m_Samples.size());
+            for (size_t i = 0; i < m_Samples.size(); ++i)
+                samples[i] = m_Samples[(m_FrameIndex + i) % m_Samples.size()];
+            return samples;
+        }
+
+        FrameStatsReport FrameStatsRecorder::getReport() const
+        {
+            FrameStatsReport report {.numFrames = static_cast<uint32_t>(m_Samples.size())};
+            if (m_Samples.empty())
+                return report;
+
+            std::vector<float> values;
+            values.reserve(m_Samples.size());
+            const auto summarize = [this, &values](float FrameTimeSample::*member) {
+                values.clear();
+                for (const auto& sample : m_Samples)
+                {
+                    if (sample.*member >= 0.0f)
+                        values.push_back(sample.*member);
+                }
+                if (values.empty())
+                    return FrameTimeSummary {};
+
+                std::sort(values.begin(), values.end());
+                const auto percentile = [&values](float p) {
+                    return values[static_cast<size_t>(p * static_cast<float>(values.size() - 1) + 0.5f)];
+                };
+                return FrameTimeSummary {
+                    .mean = std::accumulate(values.begin(), values.end(), 0.0f) / static_cast<float>(values.size()),
+                    .p50  = percentile(0.50f),
+                    .p95  = percentile(0.95f),
+                    .p99  = percentile(0.99f),
+                    .max  = values.back(),
+                };
+            };
+
+            report.frame   = summarize(&FrameTimeSample::frameMs);
+            report.cpu     = summarize(&FrameTimeSample::cpuMs);
+            report.gpu     = summarize(&FrameTimeSample::gpuMs);
+            report.present = summarize(&FrameTimeSample::presentMs);
+
+            const auto stutterThreshold = report.frame.p50 * m_StutterFactor;
+            report.numStutters          = static_cast<uint32_t>(
+                std::count_if(m_Samples.begin(), m_Samples.end(), [stutterThreshold](const auto& sample) {
+                    return sample.frameMs > stutterThreshold;
+                }));
+
+            return report;
+        }
+
+        std::string FrameStatsRecorder::exportCsv() const
+        {
+            std::string csv = "frame,frame_ms,cpu_ms,gpu_ms,present_ms\n";
+            for (const auto& sample : getSamples())
+            {
+                csv += fmt::format("{0},{1:.4f},{2:.4f},{3:.4f},{4:.4f}\n",
+                                   sample.frameIndex,
+                                   sample.frameMs,
+                                   sample.cpuMs,
+                                   sample.gpuMs,
+                                   sample.presentMs);
+            }
+            return csv;
+        }
+
+        std::string FrameStatsRecorder::exportJson() const
+        {
+            const auto report    = getReport();
+            const auto summaryOf = [](const FrameTimeSummary& summary) {
+                return fmt::format("{{\"mean\":{0:.4f},\"p50\":{1:.4f},\"p95\":{2:.4f},"
+                                   "\"p99\":{3:.4f},\"max\":{4:.4f}}}",
+                                   summary.mean,
+                                   summary.p50,
+                                   summary.p95,
+                                   summary.p99,
+                                   summary.max);
+            };
+
+            std::string json = fmt::format("{{\"num_frames\":{0},\"num_stutters\":{1},\"frame_ms\":{2},"
+                                           "\"cpu_ms\":{3},\"gpu_ms\":{4},\"present_ms\":{5},",
+                report.numFrames,
+                report.numStutters,
+                summaryOf(report.frame),
+                summaryOf(report.cpu),
+                summaryOf(report.gpu),
+                summaryOf(report.present));
+
+            json += "\"samples\":[";
+            bool first {true};
+            for (const auto& sample : getSamples())
+            {
+                json += fmt::format("{0}[{1},{2:.4f},{3:.4f},{4:.4f},{5:.4f}]",
+                                    std::exchange(first, false) ? "" : ",",
+                                    sample.frameIndex,
+                                    sample.frameMs,
+                                    sample.cpuMs,
+                                    sample.gpuMs,
+                                    sample.presentMs);
+            }
+            json += "]}";
+            return json;
+        }
+
+        bool FrameStatsRecorder::exportToFile(const std::filesystem::path& filePath) const
+        {
+            return utils::writeFileAllText(filePath, filePath.extension() == ".csv" ? exportCsv() : exportJson());
+        }
+
+        thread_local std::optional<GpuMemoryCategory> t_GpuMemoryCategory {};
+
+        GpuMemoryScope::GpuMemoryScope(GpuMemoryCategory category, bool override) : m_Previous {t_GpuMemoryCategory}
+        {
+            if (override || !t_GpuMemoryCategory)
+                t_GpuMemoryCategory = category;
+        }
+
+        GpuMemoryScope::~GpuMemoryScope() { t_GpuMemoryCategory = m_Previous; }
+
+        // Buffer and texture names are separate, keep them apart in one map
+        constexpr uint64_t kTextureKeyBit = 1ull << 32;
+
+        void GpuMemoryTracker::onBufferCreated(GLuint id, uint64_t size) { onAllocated(id, size); }
+        void GpuMemoryTracker::onTextureCreated(GLuint id, uint64_t size) { onAllocated(kTextureKeyBit | id, size); }
+        void GpuMemoryTracker::onBufferDestroyed(GLuint id) { onFreed(id); }
+        void GpuMemoryTracker::onTextureDestroyed(GLuint id) { onFreed(kTextureKeyBit | id); }
+
+        void GpuMemoryTracker::setBudget(GpuMemoryCategory category, std::optional<uint64_t> bytes)
+        {
+            m_Budgets[static_cast<size_t>(category)] = bytes;
+            checkBudgets(category);
+        }
+
+        void GpuMemoryTracker::setTotalBudget(std::optional<uint64_t> bytes)
+        {
+            m_TotalBudget = bytes;
+            checkBudgets(GpuMemoryCategory::eOther);
+        }
+
+        const char* GpuMemoryTracker::getCategoryName(GpuMemoryCategory category)
+        {
+            switch (category)
+            {
+                case GpuMemoryCategory::eGeometry:
+                    return "GPU Geometry";
+                case GpuMemoryCategory::eMaterialTextures:
+                    return "GPU Material Textures";
+                case GpuMemoryCategory::eTransientTargets:
+                    return "GPU Transient Targets";
+                case GpuMemoryCategory::eUniforms:
+                    return "GPU Uniforms";
+                default:
+                    return "GPU Other";
+            }
+        }
+
+        void GpuMemoryTracker::onAllocated(uint64_t key, uint64_t size)
+        {
+            const auto category = t_GpuMemoryCategory.value_or(GpuMemoryCategory::eOther);
+            const auto index    = static_cast<size_t>(category);
+
+            m_Allocations[key] = {size, category};
+            m_Stats.bytes[index] += size;
+            ++m_Stats.numAllocations[index];
+            m_Stats.totalBytes += size;
+            m_Stats.peakBytes = std::max(m_Stats.peakBytes, m_Stats.totalBytes);
+
+#ifdef VGFW_ENABLE_TRACY
+            TracyAllocN(reinterpret_cast<void*>(key), size, getCategoryName(category));
+#endif
+
+            checkBudgets(category);
+        }
+
+        void GpuMemoryTracker::onFreed(uint64_t key)
+        {
+            const auto it = m_Allocations.find(key);
+            if (it == m_Allocations.end())
+                return;
+
+            const auto [size, category] = it->second;
+            const auto index            = static_cast<size_t>(category);
+
+            m_Stats.bytes[index] -= size;
+            --m_Stats.numAllocations[index];
+            m_Stats.totalBytes -= size;
+            m_Allocations.erase(it);
+
+#ifdef VGFW_ENABLE_TRACY
+            TracyFreeN(reinterpret_cast<void*>(key), getCategoryName(category));
+#endif
+
+            checkBudgets(category);
+        }
+
+        void GpuMemoryTracker::checkBudgets(GpuMemoryCategory category)
+        {
+            [[maybe_unused]] constexpr auto toMiB = [](uint64_t bytes) {
+                return static_cast<double>(bytes) / (1024.0 * 1024.0);
+            };
+
+            const auto index = static_cast<size_t>(category);
+            if (const auto& budget = m_Budgets[index]; budget)
+            {
+                const bool over = m_Stats.bytes[index] > *budget;
+                if (over && !m_OverBudget[index])
+                {
+                    VGFW_WARN("[GpuMemoryTracker] {0} over budget: {1:.1f} MiB / {2:.1f} MiB",
+                              getCategoryName(category),
+                              toMiB(m_Stats.bytes[index]),
+                              toMiB(*budget));
+                }
+                m_OverBudget[index] = over;
+            }
+
+            if (m_TotalBudget)
+            {
+                const bool over = m_Stats.totalBytes > *m_TotalBudget;
+                if (over && !m_OverTotalBudget)
+                {
+                    VGFW_WARN("[GpuMemoryTracker] Total GPU memory over budget: {0:.1f} MiB / {1:.1f} MiB",
+                              toMiB(m_Stats.totalBytes),
+                              toMiB(*m_TotalBudget));
+                }
+                m_OverTotalBudget = over;
+            }
+        }
+
+#ifdef VGFW_NULL_GL
+        namespace nullgl
+        {
+            // The generic stub takes no arguments and returns 0, which relies on caller-cleanup calling conventions
+            static_assert(sizeof(void*) == 8, "VGFW_NULL_GL requires a 64-bit target");
+
+            // Entry points get a counting stub each, glad loads about a thousand without extensions
+            constexpr uint32_t kMaxEntryPoints {2048};
+
+            struct EntryPoint
+            {
+                std::string name;
+                uint64_t    count {0};
+            };
+
+            static std::vector<EntryPoint>                   g_EntryPoints;
+            static std::unordered_map<std::string, uint32_t> g_EntryPointSlots;
+            static EntryPoint                                g_OtherEntryPoint {"<other>"};
+            static bool                                      g_CallLogging {false};
+
+            static GLuint                                              g_NextName {1};
+            static std::unordered_map<GLuint, std::vector<std::byte>> g_BufferData;
+            static std::unordered_map<GLuint, GLuint64>                g_QueryResults;
+            static int                                                 g_Fence {0};
+
+            uint32_t getSlot(const char* name)
+            {
+                if (const auto it = g_EntryPointSlots.find(name); it != g_EntryPointSlots.cend())
+                    return it->second;
+
+                if (g_EntryPoints.size() == kMaxEntryPoints)
+                    return kMaxEntryPoints;
+
+                const auto slot = static_cast<uint32_t>(g_EntryPoints.size());
+                g_EntryPoints.push_back({.name = name});
+                g_EntryPointSlots.emplace(name, slot);
+                return slot;
+            }
+
+            void onCall(uint32_t slot)
+            {
+                auto& entryPoint = slot < g_EntryPoints.size() ? g_EntryPoints[slot] : g_OtherEntryPoint;
+                ++entryPoint.count;
+                if (g_CallLogging)
+                    VGFW_TRACE("[NullGL] {0}", entryPoint.name);
+            }
+
+            // Every entry point without an override below
+            template<uint32_t Slot>
+            GLintptr APIENTRY stub()
+            {
+                onCall(Slot);
+                return 0;
+            }
+
+            using StubProc = GLintptr(APIENTRY*)();
+
+            template<uint32_t... Slots>
+            constexpr std::array<StubProc, sizeof...(Slots)> makeStubs(std::integer_sequence<uint32_t, Slots...>)
+            {
+                return {&stub<Slots>...};
+            }
+
+            constexpr auto kStubs = makeStubs(std::make_integer_sequence<uint32_t, kMaxEntryPoints> {});
+
+            // Overrides count themselves, the slot is resolved on the first call
+#define VGFW_NULL_GL_CALL(function) \
+    static const uint32_t kSlot = getSlot(function); \
+    onCall(kSlot);
+
+            GLint64 getTimestamp()
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(time::Clock::now().time_since_epoch())
+                    .count();
+            }
+
+            uint32_t getNumValues(GLenum pname)
+            {
+                switch (pname)
+                {
+                    case GL_VIEWPORT:
+                    case GL_SCISSOR_BOX:
+                    case GL_COLOR_WRITEMASK:
+                    case GL_COLOR_CLEAR_VALUE:
+                    case GL_BLEND_COLOR:
+                    case GL_TEXTURE_BORDER_COLOR:
+                        return 4;
+                    case GL_MAX_VIEWPORT_DIMS:
+                    case GL_DEPTH_RANGE:
+                    case GL_POLYGON_MODE:
+                        return 2;
+                    default:
+                        return 1;
+                }
+            }
+
+            template<typename T>
+            void writeZeros(GLenum pname, T* data)
+            {
+                if (data)
+                    std::fill_n(data, getNumValues(pname), T {0});
+            }
+
+            void generateNames(GLsizei n, GLuint* names)
+            {
+                for (GLsizei i {0}; i < n; ++i)
+                    names[i] = g_NextName++;
+            }
+
+            const GLubyte* APIENTRY getString(GLenum name)
+            {
+                VGFW_NULL_GL_CALL("glGetString")
+                switch (name)
+                {
+                    case GL_VENDOR:
+                        return reinterpret_cast<const GLubyte*>("VGFW");
+                    case GL_RENDERER:
+                        return reinterpret_cast<const GLubyte*>("Null GL");
+                    case GL_VERSION:
+                        return reinterpret_cast<const GLubyte*>("4.6.0 Null GL");
+                    case GL_SHADING_LANGUAGE_VERSION:
+                        return reinterpret_cast<const GLubyte*>("4.60");
+                    default:
+                        return reinterpret_cast<const GLubyte*>("");
+                }
+            }
+
+            const GLubyte* APIENTRY getStringi(GLenum, GLuint)
+            {
+                VGFW_NULL_GL_CALL("glGetStringi")
+                return reinterpret_cast<const GLubyte*>("");
+            }
+
+            void APIENTRY getIntegerv(GLenum pname, GLint* data)
+            {
+                VGFW_NULL_GL_CALL("glGetIntegerv")
+                writeZeros(pname, data);
+                if (pname == GL_MAJOR_VERSION)
+                    *data = 4;
+                else if (pname == GL_MINOR_VERSION)
+                    *data = 6;
+            }
+
+            void APIENTRY getInteger64v(GLenum pname, GLint64* data)
+            {
+                VGFW_NULL_GL_CALL("glGetInteger64v")
+                writeZeros(pname, data);
+                if (pname == GL_TIMESTAMP)
+                    *data = getTimestamp();
+            }
+
+            void APIENTRY getFloatv(GLenum pname, GLfloat* data)
+            {
+                VGFW_NULL_GL_CALL("glGetFloatv")
+                writeZeros(pname, data);
+            }
+
+            void APIENTRY getBooleanv(GLenum pname, GLboolean* data)
+            {
+                VGFW_NULL_GL_CALL("glGetBooleanv")
+                writeZeros(pname, data);
+            }
+
+            void APIENTRY genBuffers(GLsizei n, GLuint* buffers)
+            {
+                VGFW_NULL_GL_CALL("glGenBuffers")
+                generateNames(n, buffers);
+            }
+
+            void APIENTRY createBuffers(GLsizei n, GLuint* buffers)
+            {
+                VGFW_NULL_GL_CALL("glCreateBuffers")
+                generateNames(n, buffers);
+            }
+
+            void APIENTRY genTextures(GLsizei n, GLuint* textures)
+            {
+                VGFW_NULL_GL_CALL("glGenTextures")
+                generateNames(n, textures);
+            }
+
+            void APIENTRY createTextures(GLenum, GLsizei n, GLuint* textures)
+            {
+                VGFW_NULL_GL_CALL("glCreateTextures")
+                generateNames(n, textures);
+            }
+
+            void APIENTRY genFramebuffers(GLsizei n, GLuint* framebuffers)
+            {
+                VGFW_NULL_GL_CALL("glGenFramebuffers")
+                generateNames(n, framebuffers);
+            }
+
+            void APIENTRY createFramebuffers(GLsizei n, GLuint* framebuffers)
+            {
+                VGFW_NULL_GL_CALL("glCreateFramebuffers")
+                generateNames(n, framebuffers);
+            }
+
+            void APIENTRY genRenderbuffers(GLsizei n, GLuint* renderbuffers)
+            {
+                VGFW_NULL_GL_CALL("glGenRenderbuffers")
+                generateNames(n, renderbuffers);
+            }
+
+            void APIENTRY createRenderbuffers(GLsizei n, GLuint* renderbuffers)
+            {
+                VGFW_NULL_GL_CALL("glCreateRenderbuffers")
+                generateNames(n, renderbuffers);
+            }
+
+            void APIENTRY genVertexArrays(GLsizei n, GLuint* arrays)
+            {
+                VGFW_NULL_GL_CALL("glGenVertexArrays")
+                generateNames(n, arrays);
+            }
+
+            void APIENTRY createVertexArrays(GLsizei n, GLuint* arrays)
+            {
+                VGFW_NULL_GL_CALL("glCreateVertexArrays")
+                generateNames(n, arrays);
+            }
+
+            void APIENTRY genSamplers(GLsizei n, GLuint* samplers)
+            {
+                VGFW_NULL_GL_CALL("glGenSamplers")
+                generateNames(n, samplers);
+            }
+
+            void APIENTRY createSamplers(GLsizei n, GLuint* samplers)
+            {
+                VGFW_NULL_GL_CALL("glCreateSamplers")
+                generateNames(n, samplers);
+            }
+
+            void APIENTRY genQueries(GLsizei n, GLuint* ids)
+            {
+                VGFW_NULL_GL_CALL("glGenQueries")
+                generateNames(n, ids);
+            }
+
+            void APIENTRY createQueries(GLenum, GLsizei n, GLuint* ids)
+            {
+                VGFW_NULL_GL_CALL("glCreateQueries")
+                generateNames(n, ids);
+            }
+
+            void APIENTRY genProgramPipelines(GLsizei n, GLuint* pipelines)
+            {
+                VGFW_NULL_GL_CALL("glGenProgramPipelines")
+                generateNames(n, pipelines);
+            }
+
+            void APIENTRY createProgramPipelines(GLsizei n, GLuint* pipelines)
+            {
+                VGFW_NULL_GL_CALL("glCreateProgramPipelines")
+                generateNames(n, pipelines);
+            }
+
+            GLuint APIENTRY createProgram()
+            {
+                VGFW_NULL_GL_CALL("glCreateProgram")
+                return g_NextName++;
+            }
+
+            GLuint APIENTRY createShader(GLenum)
+            {
+                VGFW_NULL_GL_CALL("glCreateShader")
+                return g_NextName++;
+            }
+
+            // Every shader compiles and every program links
+            void APIENTRY getShaderiv(GLuint, GLenum pname, GLint* params)
+            {
+                VGFW_NULL_GL_CALL("glGetShaderiv")
+                *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+            }
+
+            void APIENTRY getProgramiv(GLuint, GLenum pname, GLint* params)
+            {
+                VGFW_NULL_GL_CALL("glGetProgramiv")
+                *params = pname == GL_LINK_STATUS || pname == GL_VALIDATE_STATUS ? GL_TRUE : 0;
+            }
+
+            void APIENTRY getShaderInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+            {
+                VGFW_NULL_GL_CALL("glGetShaderInfoLog")
+                if (length)
+                    *length = 0;
+                if (bufSize > 0)
+                    infoLog[0] = '\0';
+            }
+
+            void APIENTRY getProgramInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+            {
+                VGFW_NULL_GL_CALL("glGetProgramInfoLog")
+                if (length)
+                    *length = 0;
+                if (bufSize > 0)
+                    infoLog[0] = '\0';
+            }
+
+            GLenum APIENTRY checkFramebufferStatus(GLenum)
+            {
+                VGFW_NULL_GL_CALL("glCheckFramebufferStatus")
+                return GL_FRAMEBUFFER_COMPLETE;
+            }
+
+            GLenum APIENTRY checkNamedFramebufferStatus(GLuint, GLenum)
+            {
+                VGFW_NULL_GL_CALL("glCheckNamedFramebufferStatus")
+                return GL_FRAMEBUFFER_COMPLETE;
+            }
+
+            // Buffers keep their contents in system memory, so maps and readbacks behave
+            void APIENTRY namedBufferStorage(GLuint buffer, GLsizeiptr size, const void* data, GLbitfield)
+            {
+                VGFW_NULL_GL_CALL("glNamedBufferStorage")
+                auto& storage = g_BufferData[buffer];
+                storage.assign(static_cast<size_t>(size), std::byte {0});
+                if (data)
+                    std::memcpy(storage.data(), data, storage.size());
+            }
+
+            void APIENTRY namedBufferData(GLuint buffer, GLsizeiptr size, const void* data, GLenum)
+            {
+                VGFW_NULL_GL_CALL("glNamedBufferData")
+                auto& storage = g_BufferData[buffer];
+                storage.assign(static_cast<size_t>(size), std::byte {0});
+                if (data)
+                    std::memcpy(storage.data(), data, storage.size());
+            }
+
+            void APIENTRY namedBufferSubData(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data)
+            {
+                VGFW_NULL_GL_CALL("glNamedBufferSubData")
+                const auto it = g_BufferData.find(buffer);
+                if (it != g_BufferData.cend() && data && static_cast<size_t>(offset + size) <= it->second.size())
+                    std::memcpy(it->second.data() + offset, data, static_cast<size_t>(size));
+            }
+
+            void APIENTRY getNamedBufferSubData(GLuint buffer, GLintptr offset, GLsizeiptr size, void* data)
+            {
+                VGFW_NULL_GL_CALL("glGetNamedBufferSubData")
+                const auto it = g_BufferData.find(buffer);
+                if (it != g_BufferData.cend() && static_cast<size_t>(offset + size) <= it->second.size())
+                    std::memcpy(data, it->second.data() + offset, static_cast<size_t>(size));
+                else
+                    std::memset(data, 0, static_cast<size_t>(size));
+            }
+
+            void* APIENTRY mapNamedBuffer(GLuint buffer, GLenum)
+            {
+                VGFW_NULL_GL_CALL("glMapNamedBuffer")
+                const auto it = g_BufferData.find(buffer);
+                return it != g_BufferData.cend() ? it->second.data() : nullptr;
+            }
+
+            void* APIENTRY mapNamedBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr, GLbitfield)
+            {
+                VGFW_NULL_GL_CALL("glMapNamedBufferRange")
+                const auto it = g_BufferData.find(buffer);
+                return it != g_BufferData.cend() ? it->second.data() + offset : nullptr;
+            }
+
+            GLboolean APIENTRY unmapNamedBuffer(GLuint)
+            {
+                VGFW_NULL_GL_CALL("glUnmapNamedBuffer")
+                return GL_TRUE;
+            }
+
+            void APIENTRY deleteBuffers(GLsizei n, const GLuint* buffers)
+            {
+                VGFW_NULL_GL_CALL("glDeleteBuffers")
+                for (GLsizei i {0}; i < n; ++i)
+                    g_BufferData.erase(buffers[i]);
+            }
+
+            void APIENTRY getTextureImage(GLuint, GLint, GLenum, GLenum, GLsizei bufSize, void* pixels)
+            {
+                VGFW_NULL_GL_CALL("glGetTextureImage")
+                std::memset(pixels, 0, static_cast<size_t>(bufSize));
+            }
+
+            void APIENTRY getTextureParameteriv(GLuint, GLenum pname, GLint* params)
+            {
+                VGFW_NULL_GL_CALL("glGetTextureParameteriv")
+                writeZeros(pname, params);
+            }
+
+            void APIENTRY getTextureParameterfv(GLuint, GLenum pname, GLfloat* params)
+            {
+                VGFW_NULL_GL_CALL("glGetTextureParameterfv")
+                writeZeros(pname, params);
+            }
+
+            // Commands complete as soon as they are submitted: fences are signaled and timestamps are the CPU time
+            GLsync APIENTRY fenceSync(GLenum, GLbitfield)
+            {
+                VGFW_NULL_GL_CALL("glFenceSync")
+                return reinterpret_cast<GLsync>(&g_Fence);
+            }
+
+            GLenum APIENTRY clientWaitSync(GLsync, GLbitfield, GLuint64)
+            {
+                VGFW_NULL_GL_CALL("glClientWaitSync")
+                return GL_ALREADY_SIGNALED;
+            }
+
+            void APIENTRY getSynciv(GLsync, GLenum pname, GLsizei count, GLsizei* length, GLint* values)
+            {
+                VGFW_NULL_GL_CALL("glGetSynciv")
+                if (length)
+                    *length = count > 0 ? 1 : 0;
+                if (count > 0)
+                    values[0] = pname == GL_SYNC_STATUS ? GL_SIGNALED : 0;
+            }
+
+            void APIENTRY queryCounter(GLuint id, GLenum)
+            {
+                VGFW_NULL_GL_CALL("glQueryCounter")
+                g_QueryResults[id] = static_cast<GLuint64>(getTimestamp());
+            }
+
+            void APIENTRY beginQuery(GLenum, GLuint id)
+            {
+                VGFW_NULL_GL_CALL("glBeginQuery")
+                g_QueryResults[id] = 0;
+            }
+
+            void APIENTRY deleteQueries(GLsizei n, const GLuint* ids)
+            {
+                VGFW_NULL_GL_CALL("glDeleteQueries")
+                for (GLsizei i {0}; i < n; ++i)
+                    g_QueryResults.erase(ids[i]);
+            }
+
+            GLuint64 getQueryResult(GLuint id, GLenum pname)
+            {
+                if (pname == GL_QUERY_RESULT_AVAILABLE)
+                    return GL_TRUE;
+
+                const auto it = g_QueryResults.find(id);
+                return it != g_QueryResults.cend() ? it->second : 0;
+            }
+
+            void APIENTRY getQueryObjectiv(GLuint id, GLenum pname, GLint* params)
+            {
+                VGFW_NULL_GL_CALL("glGetQueryObjectiv")
+                *params = static_cast<GLint>(getQueryResult(id, pname));
+            }
+
+            void APIENTRY getQueryObjectuiv(GLuint id, GLenum pname, GLuint* params)
+            {
+                VGFW_NULL_GL_CALL("glGetQueryObjectuiv")
+                *params = static_cast<GLuint>(getQueryResult(id, pname));
+            }
+
+            void APIENTRY getQueryObjecti64v(GLuint id, GLenum pname, GLint64* params)
+            {
+                VGFW_NULL_GL_CALL("glGetQueryObjecti64v")
+                *params = static_cast<GLint64>(getQueryResult(id, pname));
+            }
+
+            void APIENTRY getQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params)
+            {
+                VGFW_NULL_GL_CALL("glGetQueryObjectui64v")
+                *params = getQueryResult(id, pname);
+            }
+
+            void APIENTRY getQueryiv(GLenum, GLenum pname, GLint* params)
+            {
+                VGFW_NULL_GL_CALL("glGetQueryiv")
+                *params = pname == GL_QUERY_COUNTER_BITS ? 64 : 0;
+            }
+
+#undef VGFW_NULL_GL_CALL
+
+            void* getProcAddress(const char* name)
+            {
+                static const std::unordered_map<std::string_view, void*> kOverrides {
+                    {"glGetString", reinterpret_cast<void*>(&getString)},
+                    {"glGetStringi", reinterpret_cast<void*>(&getStringi)},
+                    {"glGetIntegerv", reinterpret_cast<void*>(&getIntegerv)},
+                    {"glGetInteger64v", reinterpret_cast<void*>(&getInteger64v)},
+                    {"glGetFloatv", reinterpret_cast<void*>(&getFloatv)},
+                    {"glGetBooleanv", reinterpret_cast<void*>(&getBooleanv)},
+                    {"glGenBuffers", reinterpret_cast<void*>(&genBuffers)},
+                    {"glCreateBuffers", reinterpret_cast<void*>(&createBuffers)},
+                    {"glGenTextures", reinterpret_cast<void*>(&genTextures)},
+                    {"glCreateTextures", reinterpret_cast<void*>(&createTextures)},
+                    {"glGenFramebuffers", reinterpret_cast<void*>(&genFramebuffers)},
+                    {"glCreateFramebuffers", reinterpret_cast<void*>(&createFramebuffers)},
+                    {"glGenRenderbuffers", reinterpret_cast<void*>(&genRenderbuffers)},
+                    {"glCreateRenderbuffers", reinterpret_cast<void*>(&createRenderbuffers)},
+                    {"glGenVertexArrays", reinterpret_cast<void*>(&genVertexArrays)},
+                    {"glCreateVertexArrays", reinterpret_cast<void*>(&createVertexArrays)},
+                    {"glGenSamplers", reinterpret_cast<void*>(&genSamplers)},
+                    {"glCreateSamplers", reinterpret_cast<void*>(&createSamplers)},
+                    {"glGenQueries", reinterpret_cast<void*>(&genQueries)},
+                    {"glCreateQueries", reinterpret_cast<void*>(&createQueries)},
+                    {"glGenProgramPipelines", reinterpret_cast<void*>(&genProgramPipelines)},
+                    {"glCreateProgramPipelines", reinterpret_cast<void*>(&createProgramPipelines)},
+                    {"glCreateProgram", reinterpret_cast<void*>(&createProgram)},
+                    {"glCreateShader", reinterpret_cast<void*>(&createShader)},
+                    {"glGetShaderiv", reinterpret_cast<void*>(&getShaderiv)},
+                    {"glGetProgramiv", reinterpret_cast<void*>(&getProgramiv)},
+                    {"glGetShaderInfoLog", reinterpret_cast<void*>(&getShaderInfoLog)},
+                    {"glGetProgramInfoLog", reinterpret_cast<void*>(&getProgramInfoLog)},
+                    {"glCheckFramebufferStatus", reinterpret_cast<void*>(&checkFramebufferStatus)},
+                    {"glCheckNamedFramebufferStatus", reinterpret_cast<void*>(&checkNamedFramebufferStatus)},
+                    {"glNamedBufferStorage", reinterpret_cast<void*>(&namedBufferStorage)},
+                    {"glNamedBufferData", reinterpret_cast<void*>(&namedBufferData)},
+                    {"glNamedBufferSubData", reinterpret_cast<void*>(&namedBufferSubData)},
+                    {"glGetNamedBufferSubData", reinterpret_cast<void*>(&getNamedBufferSubData)},
+                    {"glMapNamedBuffer", reinterpret_cast<void*>(&mapNamedBuffer)},
+                    {"glMapNamedBufferRange", reinterpret_cast<void*>(&mapNamedBufferRange)},
+                    {"glUnmapNamedBuffer", reinterpret_cast<void*>(&unmapNamedBuffer)},
+                    {"glDeleteBuffers", reinterpret_cast<void*>(&deleteBuffers)},
+                    {"glGetTextureImage", reinterpret_cast<void*>(&getTextureImage)},
+                    {"glGetTextureParameteriv", reinterpret_cast<void*>(&getTextureParameteriv)},
+                    {"glGetTextureParameterfv", reinterpret_cast<void*>(&getTextureParameterfv)},
+                    {"glFenceSync", reinterpret_cast<void*>(&fenceSync)},
+                    {"glClientWaitSync", reinterpret_cast<void*>(&clientWaitSync)},
+                    {"glGetSynciv", reinterpret_cast<void*>(&getSynciv)},
+                    {"glQueryCounter", reinterpret_cast<void*>(&queryCounter)},
+                    {"glBeginQuery", reinterpret_cast<void*>(&beginQuery)},
+                    {"glDeleteQueries", reinterpret_cast<void*>(&deleteQueries)},
+                    {"glGetQueryObjectiv", reinterpret_cast<void*>(&getQueryObjectiv)},
+                    {"glGetQueryObjectuiv", reinterpret_cast<void*>(&getQueryObjectuiv)},
+                    {"glGetQueryObjecti64v", reinterpret_cast<void*>(&getQueryObjecti64v)},
+                    {"glGetQueryObjectui64v", reinterpret_cast<void*>(&getQueryObjectui64v)},
+                    {"glGetQueryiv", reinterpret_cast<void*>(&getQueryiv)},
+                };
+
+                const auto slot = getSlot(name);
+                if (const auto it = kOverrides.find(name); it != kOverrides.cend())
+                    return it->second;
+
+                return reinterpret_cast<void*>(slot < kMaxEntryPoints ? kStubs[slot] : &stub<kMaxEntryPoints>);
+            }
+
+            void setCallLogging(bool enabled) { g_CallLogging = enabled; }
+
+            bool isCallLogging() { return g_CallLogging; }
+
+            uint64_t getNumCalls()
+            {
+                uint64_t numCalls {g_OtherEntryPoint.count};
+                for (const auto& entryPoint : g_EntryPoints)
+                    numCalls += entryPoint.count;
+                return numCalls;
+            }
+
+            std::vector<CallCount> getCallCounts()
+            {
+                std::vector<CallCount> callCounts;
+                for (const auto& entryPoint : g_EntryPoints)
+                {
+                    if (entryPoint.count > 0)
+                        callCounts.push_back({.function = entryPoint.name, .count = entryPoint.count});
+                }
+                if (g_OtherEntryPoint.count > 0)
+                    callCounts.push_back({.function = g_OtherEntryPoint.name, .count = g_OtherEntryPoint.count});
+
+                std::sort(callCounts.begin(), callCounts.end(), [](const CallCount& lhs, const CallCount& rhs) {
+                    return lhs.count > rhs.count;
+                });
+                return callCounts;
+            }
+
+            void resetCallCounts()
+            {
+                for (auto& entryPoint : g_EntryPoints)
+                    entryPoint.count = 0;
+                g_OtherEntryPoint.count = 0;
+            }
+        } // namespace nullgl
+
+        int GraphicsContext::loadGl()
+        {
+            VGFW_INFO("[GraphicsContext] VGFW_NULL_GL: GL calls are stubs, nothing will be rendered");
+            return gladLoadGLLoader(nullgl::getProcAddress);
+        }
+#else
+        int GraphicsContext::loadGl() { return gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)); }
+#endif
+
+        int GraphicsContext::getMinMajor() { return VGFW_RENDER_API_OPENGL_MIN_MAJOR; }
+
+        int GraphicsContext::getMinMinor() { return VGFW_RENDER_API_OPENGL_MIN_MINOR; }
+
+        // Member-wise, Buffer is polymorphic and a memset would clear the vtable pointer of the moved-from object
+        Buffer::Buffer(Buffer&& other) noexcept :
+            m_Id(std::exchange(other.m_Id, GL_NONE)), m_Size(std::exchange(other.m_Size, 0)),
+            m_MappedMemory(std::exchange(other.m_MappedMemory, nullptr))
+        {}
+
+        Buffer::~Buffer()
+        {
+            if (m_Id != GL_NONE)
+                VGFW_ERROR("Buffer leak: {0}", m_Id);
+        }
+
+        Buffer& Buffer::operator=(Buffer&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                m_Id           = std::exchange(rhs.m_Id, GL_NONE);
+                m_Size         = std::exchange(rhs.m_Size, 0);
+                m_MappedMemory = std::exchange(rhs.m_MappedMemory, nullptr);
+            }
+            return *this;
+        }
+
+        Buffer::operator bool() const { return m_Id != GL_NONE; }
+
+        GLsizeiptr Buffer::getSize() const { return m_Size; }
+        bool       Buffer::isMapped() const { return m_MappedMemory != nullptr; }
+
+        Buffer::Buffer(GLuint id, GLsizeiptr size) : m_Id(id), m_Size(size) {}
+
+        Buffer::operator GLuint() const { return m_Id; }
+
+        IndexType  IndexBuffer::getIndexType() const { return m_IndexType; }
+        GLsizeiptr IndexBuffer::getCapacity() const { return m_Size / static_cast<GLsizei>(m_IndexType); }
+
+        IndexBuffer::IndexBuffer(Buffer buffer, IndexType indexType) :
+            Buffer {std::move(buffer)}, m_IndexType {indexType}
+        {}
+
+        GLsizei    VertexBuffer::getStride() const { return m_Stride; }
+        GLsizeiptr VertexBuffer::getCapacity() const { return m_Size / m_Stride; }
+
+        VertexBuffer::VertexBuffer(Buffer buffer, GLsizei stride) : Buffer {std::move(buffer)}, m_Stride {stride} {}
+
+        int32_t getSize(VertexAttribute::Type type)
+        {
+            switch (type)
+            {
+                using enum VertexAttribute::Type;
+                case eFloat:
+                    return sizeof(float);
+                case eFloat2:
+                    return sizeof(float) * 2;
+                case eFloat3:
+                    return sizeof(float) * 3;
+                case eFloat4:
+                    return sizeof(float) * 4;
+
+                case VertexAttribute::Type::eInt:
+                    return sizeof(int32_t);
+                case eInt4:
+                    return sizeof(int32_t) * 4;
+
+                case eUByte4_Norm:
+                    return sizeof(uint8_t) * 4;
+            }
+            return 0;
+        }
+
+        std::size_t VertexFormat::getHash() const { return m_Hash; }
+
+        const VertexAttributes& VertexFormat::getAttributes() const { return m_Attributes; }
+        bool                    VertexFormat::contains(AttributeLocation location) const
+        {
+            return m_Attributes.contains(static_cast<int32_t>(location));
+        }
+
+        bool VertexFormat::contains(std::initializer_list<AttributeLocation> locations) const
+        {
+            return std::all_of(std::cbegin(locations), std::cend(locations), [&](auto location) {
+                return std::any_of(m_Attributes.cbegin(),
+                                   m_Attributes.cend(),
+                                   [v = static_cast<int32_t>(location)](const auto& p) { return p.first == v; });
+            });
+        }
+
+        uint32_t VertexFormat::getStride() const { return m_Stride; }
+
+        VertexFormat::VertexFormat(std::size_t hash, VertexAttributes&& attributes, uint32_t stride) :
+            m_Hash {hash}, m_Attributes {attributes}, m_Stride {stride}
+        {}
+
+        using Builder = VertexFormat::Builder;
+
+        Builder& Builder::setAttribute(AttributeLocation location, const VertexAttribute& attribute)
+        {
+            m_Attributes.insert_or_assign(static_cast<int32_t>(location), attribute);
+            return *this;
+        }
+
+        std::shared_ptr<VertexFormat> Builder::build(uint32_t stride)
+        {
+            uint32_t packedStride {0};
+            auto     layoutHash = kVertexLayoutHashSeed;
+            for (const auto& [location, attribute] : m_Attributes)
+            {
+                packedStride += getSize(attribute.vertType);
+                layoutHash = hashVertexLayout(layoutHash, location, attribute);
+            }
+            if (stride == 0)
+                stride = packedStride;
+            assert(stride >= packedStride);
+
+            // Same sequence as VertexLayout::kHash
+            layoutHash      = hashVertexLayoutStride(layoutHash, stride);
+            const auto hash = static_cast<std::size_t>(layoutHash);
+
+            if (const auto it = s_Cache.find(hash); it != s_Cache.cend())
+                if (auto vertexFormat = it->second.lock(); vertexFormat)
+                    return vertexFormat;
+
+            auto vertexFormat = std::make_shared<VertexFormat>(VertexFormat {hash, std::move(m_Attributes), stride});
+            s_Cache.insert_or_assign(hash, vertexFormat);
+            return vertexFormat;
+        }
+
+        std::shared_ptr<VertexFormat> Builder::buildDefault()
+        {
+            m_Attributes.clear();
+
+            setAttribute(AttributeLocation::ePosition, {.vertType = VertexAttribute::Type::eFloat3, .offset = 0});
+            setAttribute(AttributeLocation::eNormal_Color, {.vertType = VertexAttribute::Type::eFloat3, .offset = 12});
+            setAttribute(AttributeLocation::eTexCoords, {.vertType = VertexAttribute::Type::eFloat2, .offset = 24});
+
+            return build();
+        }
+
+        Texture::Texture(Texture&& other) noexcept :
+            m_Id {other.m_Id}, m_Type {other.m_Type}, m_View {other.m_View}, m_Extent {other.m_Extent},
+            m_Depth {other.m_Depth}, m_NumMipLevels {other.m_NumMipLevels}, m_NumLayers {other.m_NumLayers},
+            m_PixelFormat {other.m_PixelFormat}
+        {
+            memset(reinterpret_cast<void*>(&other), 0, sizeof(Texture));
+        }
+
+        Texture::~Texture()
+        {
+            if (m_Id != GL_NONE)
+                VGFW_ERROR("Texture leak: {0}", m_Id);
+        }
+
+        Texture& Texture::operator=(Texture&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                memcpy(reinterpret_cast<void*>(this), reinterpret_cast<void*>(&rhs), sizeof(Texture));
+                memset(reinterpret_cast<void*>(&rhs), 0, sizeof(Texture));
+            }
+            return *this;
+        }
+
+        Texture::operator bool() const { return m_Id != GL_NONE; }
+
+        GLenum Texture::getType() const { return m_Type; }
+
+        Extent2D    Texture::getExtent() const { return m_Extent; }
+        uint32_t    Texture::getDepth() const { return m_Depth; }
+        uint32_t    Texture::getNumMipLevels() const { return m_NumMipLevels; }
+        uint32_t    Texture::getNumLayers() const { return m_NumLayers; }
+        PixelFormat Texture::getPixelFormat() const { return m_PixelFormat; }
+
+        Texture::Texture(GLuint      id,
+                         GLenum      type,
+                         PixelFormat pixelFormat,
+                         Extent2D    extent,
+                         uint32_t    depth,
+                         uint32_t    numMipLevels,
+                         uint32_t    numLayers) :
+            m_Id {id},
+            m_Type {type}, m_Extent {extent}, m_Depth {depth}, m_NumMipLevels {numMipLevels}, m_NumLayers {numLayers},
+            m_PixelFormat {pixelFormat}
+        {}
+
+        Texture::operator GLuint() const { return m_Id; }
+
+        uint32_t   calcMipLevels(uint32_t size) { return glm::floor(glm::log2(static_cast<float>(size))) + 1u; }
+        glm::uvec3 calcMipSize(const glm::uvec3& baseSize, uint32_t level)
+        {
+            return glm::vec3 {baseSize} * glm::pow(0.5f, static_cast<float>(level));
+        }
+
+        const char* toString(PixelFormat pixelFormat)
+        {
+            switch (pixelFormat)
+            {
+                using enum PixelFormat;
+
+                case eR8_UNorm:
+                    return "R8_Unorm";
+
+                case eRGB8_UNorm:
+                    return "RGB8_UNorm";
+                case eRGBA8_UNorm:
+                    return "RGBA8_UNorm";
+
+                case eRGB8_SNorm:
+                    return "RGB8_SNorm";
+                case eRGBA8_SNorm:
+                    return "RGBA8_SNorm";
+
+                case eR16F:
+                    return "R16F";
+                case eRG16F:
+                    return "RG16F";
+                case eRGB16F:
+                    return "RGB16F";
+                case eRGBA16F:
+                    return "RGBA16F";
+
+                case eRGB32F:
+                    return "RGB32F";
+                case eRGBA32F:
+                    return "RGBA32F";
+
+                case eR32I:
+                    return "R32I";
+                case eRGBA32UI:
+                    return "RGBA32UI";
+
+                case eDepth16:
+                    return "Depth16";
+                case eDepth24:
+                    return "Depth24";
+                case eDepth32F:
+                    return "Depth32F";
+
+                case PixelFormat::eUnknown:
+                    break;
+            }
+
+            return "Undefined";
+        }
+
+        GraphicsPipeline::Builder& GraphicsPipeline::Builder::setShaderProgram(GLuint program)
+        {
+            m_Program = program;
+            return *this;
+        }
+
+        GraphicsPipeline::Builder& GraphicsPipeline::Builder::setVAO(GLuint vao)
+        {
+            m_VAO = vao;
+            return *this;
+        }
+
+        GraphicsPipeline::Builder& GraphicsPipeline::Builder::setDepthStencil(const DepthStencilState& state)
+        {
+            m_DepthStencilState = state;
+            return *this;
+        }
+
+        GraphicsPipeline::Builder& GraphicsPipeline::Builder::setRasterizerState(const RasterizerState& state)
+        {
+            m_RasterizerState = state;
+            return *this;
+        }
+
+        GraphicsPipeline::Builder& GraphicsPipeline::Builder::setBlendState(uint32_t          attachment,
+                                                                            const BlendState& state)
+        {
+            assert(attachment < kMaxNumBlendStates);
+            m_BlendStates[attachment] = state;
+            return *this;
+        }
+
+        GraphicsPipeline GraphicsPipeline::Builder::build()
+        {
+            GraphicsPipeline g;
+
+            g.m_Program           = m_Program;
+            g.m_VAO               = m_VAO;
+            g.m_DepthStencilState = m_DepthStencilState;
+            g.m_RasterizerState   = m_RasterizerState;
+            g.m_BlendStates       = m_BlendStates;
+
+            // Interned, rebuilding an existing pipeline every frame costs one lookup and binds as a no-op
+            g.m_StateKey = PipelineStateKey::make(m_DepthStencilState, m_RasterizerState, m_BlendStates);
+            g.m_Id       = s_Cache.try_emplace({g.m_StateKey, m_Program, m_VAO}, s_Cache.size() + 1).first->second;
+
+            return g;
+        }
+
+        std::size_t GraphicsPipeline::Builder::CacheKeyHash::operator()(const CacheKey& key) const noexcept
+        {
+            std::size_t h {0};
+            utils::hashCombine(h,
+                               key.state.bits[0],
+                               key.state.bits[1],
+                               key.state.polygonOffset.factor,
+                               key.state.polygonOffset.units,
+                               key.program,
+                               key.vao);
+            return h;
+        }
+
+        // Small indices of the GL enums packed into a PipelineStateKey
+        template<typename T, size_t N>
+        constexpr uint64_t getStateIndex(const std::array<T, N>& values, T value)
+        {
+            const auto it = std::find(values.cbegin(), values.cend(), value);
+            assert(it != values.cend());
+            return static_cast<uint64_t>(it - values.cbegin());
+        }
+
+        constexpr std::array kStateBlendFactors {
+            BlendFactor::eZero,          BlendFactor::eOne,
+            BlendFactor::eSrcColor,      BlendFactor::eOneMinusSrcColor,
+            BlendFactor::eDstColor,      BlendFactor::eOneMinusDstColor,
+            BlendFactor::eSrcAlpha,      BlendFactor::eOneMinusSrcAlpha,
+            BlendFactor::eDstAlpha,      BlendFactor::eOneMinusDstAlpha,
+            BlendFactor::eConstantColor, BlendFactor::eOneMinusConstantColor,
+            BlendFactor::eConstantAlpha, BlendFactor::eOneMinusConstantAlpha,
+            BlendFactor::eSrcAlphaSaturate,
+            BlendFactor::eSrc1Color,     BlendFactor::eOneMinusSrc1Color,
+            BlendFactor::eSrc1Alpha,     BlendFactor::eOneMinusSrc1Alpha,
+        };
+        constexpr std::array kStateBlendOps {
+            BlendOp::eAdd, BlendOp::eSubtract, BlendOp::eReverseSubtract, BlendOp::eMin, BlendOp::eMax};
+        constexpr std::array kStateCullModes {CullMode::eNone, CullMode::eBack, CullMode::eFront};
+        constexpr std::array kStatePolygonModes {PolygonMode::ePoint, PolygonMode::eLine, PolygonMode::eFill};
+        constexpr std::array kStateCompareOps {CompareOp::eNever,
+                                               CompareOp::eLess,
+                                               CompareOp::eEqual,
+                                               CompareOp::eLessOrEqual,
+                                               CompareOp::eGreater,
+                                               CompareOp::eNotEqual,
+                                               CompareOp::eGreaterOrEqual,
+                                               CompareOp::eAlways};
+
+        // Writes a field that may straddle the two words
+        void setStateBits(PipelineStateKey::Bits& bits, PipelineStateKey::Field field, uint64_t value)
+        {
+            assert(field.offset + field.width <= 128 && value < (1ull << field.width));
+            const auto word  = field.offset / 64;
+            const auto shift = field.offset % 64;
+            bits[word] |= value << shift;
+            if (shift + field.width > 64)
+                bits[word + 1] |= value >> (64 - shift);
+        }
+
+        PipelineStateKey PipelineStateKey::make(const DepthStencilState&                          depthStencilState,
+                                                const RasterizerState&                            rasterizerState,
+                                                const std::array<BlendState, kMaxNumBlendStates>& blendStates)
+        {
+            static_assert(kBlendOffset + kMaxNumBlendStates * kBlendBits <= 128);
+
+            PipelineStateKey key;
+            // The compare op is ignored by a disabled depth test, like in RenderContext::setDepthTest
+            if (depthStencilState.depthTest)
+            {
+                const auto compareOp = getStateIndex(kStateCompareOps, depthStencilState.depthCompareOp);
+                setStateBits(key.bits, kDepthTest, 1 | compareOp << 1);
+            }
+            setStateBits(key.bits, kDepthWrite, depthStencilState.depthWrite);
+
+            setStateBits(key.bits, kPolygonMode, getStateIndex(kStatePolygonModes, rasterizerState.polygonMode));
+            setStateBits(key.bits, kCullMode, getStateIndex(kStateCullModes, rasterizerState.cullMode));
+            if (rasterizerState.polygonOffset)
+            {
+                setStateBits(key.bits, kPolygonOffset, 1);
+                key.polygonOffset = *rasterizerState.polygonOffset;
+            }
+            setStateBits(key.bits, kDepthClamp, rasterizerState.depthClampEnable);
+            setStateBits(key.bits, kScissorTest, rasterizerState.scissorTest);
+
+            for (uint32_t i {0}; i < blendStates.size(); ++i)
+            {
+                const auto& state = blendStates[i];
+                if (!state.enabled)
+                    continue;
+
+                uint64_t value {1};
+                value |= getStateIndex(kStateBlendFactors, state.srcColor) << 1;
+                value |= getStateIndex(kStateBlendFactors, state.destColor) << 6;
+                value |= getStateIndex(kStateBlendFactors, state.srcAlpha) << 11;
+                value |= getStateIndex(kStateBlendFactors, state.destAlpha) << 16;
+                value |= getStateIndex(kStateBlendOps, state.colorOp) << 21;
+                value |= getStateIndex(kStateBlendOps, state.alphaOp) << 24;
+                setStateBits(key.bits, getBlendField(i), value);
+            }
+
+            return key;
+        }
+
+        bool PipelineStateKey::intersects(const Bits& bits, Field field)
+        {
+            const auto word  = field.offset / 64;
+            const auto shift = field.offset % 64;
+            auto       value = bits[word] >> shift;
+            if (shift + field.width > 64)
+                value |= bits[word + 1] << (64 - shift);
+            return (value & ((1ull << field.width) - 1)) != 0;
+        }
+
+        // @return {data type, number of components, normalize}
+        std::tuple<GLenum, GLint, GLboolean> statAttribute(VertexAttribute::Type type)
+        {
+            switch (type)
+            {
+                using enum VertexAttribute::Type;
+                case eFloat:
+                    return {GL_FLOAT, 1, GL_FALSE};
+                case eFloat2:
+                    return {GL_FLOAT, 2, GL_FALSE};
+                case eFloat3:
+                    return {GL_FLOAT, 3, GL_FALSE};
+                case eFloat4:
+                    return {GL_FLOAT, 4, GL_FALSE};
+
+                case eInt:
+                    return {GL_INT, 1, GL_FALSE};
+                case eInt4:
+                    return {GL_INT, 4, GL_FALSE};
+
+                case eUByte4_Norm:
+                    return {GL_UNSIGNED_BYTE, 4, GL_TRUE};
+            }
+            return {GL_INVALID_INDEX, 0, GL_FALSE};
+        }
+
+        GLenum selectTextureMinFilter(TexelFilter minFilter, MipmapMode mipmapMode)
+        {
+            GLenum result {GL_NONE};
+            switch (minFilter)
+            {
+                case TexelFilter::eNearest:
+                    switch (mipmapMode)
+                    {
+                        case MipmapMode::eNone:
+                            result = GL_NEAREST;
+                            break;
+                        case MipmapMode::eNearest:
+                            result = GL_NEAREST_MIPMAP_NEAREST;
+                            break;
+                        case MipmapMode::eLinear:
+                            result = GL_NEAREST_MIPMAP_LINEAR;
+                            break;
+                    }
+                    break;
+
+                case TexelFilter::eLinear:
+                    switch (mipmapMode)
+                    {
+                        case MipmapMode::eNone:
+                            result = GL_LINEAR;
+                            break;
+                        case MipmapMode::eNearest:
+                            result = GL_LINEAR_MIPMAP_NEAREST;
+                            break;
+                        case MipmapMode::eLinear:
+                            result = GL_LINEAR_MIPMAP_LINEAR;
+                            break;
+                    }
+                    break;
+            }
+            assert(result != GL_NONE);
+            return result;
+        }
+        GLenum getIndexDataType(GLsizei stride)
+        {
+            switch (stride)
+            {
+                case sizeof(GLubyte):
+                    return GL_UNSIGNED_BYTE;
+                case sizeof(GLushort):
+                    return GL_UNSIGNED_SHORT;
+                case sizeof(GLuint):
+                    return GL_UNSIGNED_INT;
+            }
+            assert(false);
+            return GL_NONE;
+        }
+
+        GLenum getPolygonOffsetCap(PolygonMode polygonMode)
+        {
+            switch (polygonMode)
+            {
+                case PolygonMode::eFill:
+                    return GL_POLYGON_OFFSET_FILL;
+                case PolygonMode::eLine:
+                    return GL_POLYGON_OFFSET_LINE;
+                case PolygonMode::ePoint:
+                    return GL_POLYGON_OFFSET_POINT;
+            }
+            assert(false);
+            return GL_NONE;
+        }
+
+        uint32_t getImageDataPixelSize(const ImageData& imageData)
+        {
+            uint32_t numComponents {0};
+            switch (imageData.format)
+            {
+                case GL_RED:
+                case GL_RED_INTEGER:
+                case GL_DEPTH_COMPONENT:
+                case GL_STENCIL_INDEX:
+                    numComponents = 1;
+                    break;
+                case GL_RG:
+                case GL_RG_INTEGER:
+                case GL_DEPTH_STENCIL:
+                    numComponents = 2;
+                    break;
+                case GL_RGB:
+                case GL_RGB_INTEGER:
+                case GL_BGR:
+                    numComponents = 3;
+                    break;
+                case GL_RGBA:
+                case GL_RGBA_INTEGER:
+                case GL_BGRA:
+                    numComponents = 4;
+                    break;
+            }
+
+            switch (imageData.dataType)
+            {
+                case GL_UNSIGNED_BYTE:
+                case GL_BYTE:
+                    return numComponents;
+                case GL_UNSIGNED_SHORT:
+                case GL_SHORT:
+                case GL_HALF_FLOAT:
+                    return numComponents * 2;
+                case GL_UNSIGNED_INT:
+                case GL_INT:
+                case GL_FLOAT:
+                    return numComponents * 4;
+                case GL_UNSIGNED_INT_24_8:
+                    return 4;
+            }
+            return 0;
+        }
+
+        uint64_t countTriangles(PrimitiveTopology topology, uint32_t numElements)
+        {
+            switch (topology)
+            {
+                case PrimitiveTopology::eTriangleList:
+                    return numElements / 3;
+                case PrimitiveTopology::eTriangleStrip:
+                    return numElements > 2 ? numElements - 2 : 0;
+                default:
+                    return 0;
+            }
+        }
+
+        RenderContext::RenderContext() { glCreateVertexArrays(1, &m_DummyVAO); }
+
+        void RenderContext::flushFrameStats()
+        {
+            m_LastFrameStats = std::exchange(m_Stats, {});
+
+#if defined(VGFW_ENABLE_RENDER_STATS) && defined(VGFW_ENABLE_TRACY)
+            TracyPlot("Draw Calls", static_cast<int64_t>(m_LastFrameStats.drawCalls));
+            TracyPlot("Triangles", static_cast<int64_t>(m_LastFrameStats.triangles));
+            TracyPlot("Pipeline Binds", static_cast<int64_t>(m_LastFrameStats.pipelineBinds));
+            TracyPlot("Program Binds", static_cast<int64_t>(m_LastFrameStats.programBinds));
+            TracyPlot("Texture Binds", static_cast<int64_t>(m_LastFrameStats.textureBinds));
+            TracyPlot("Redundant Binds Skipped", static_cast<int64_t>(m_LastFrameStats.redundantBindsSkipped));
+            TracyPlot("Upload Bytes",
+                      static_cast<int64_t>(m_LastFrameStats.bufferUploadBytes + m_LastFrameStats.textureUploadBytes));
+#endif
+        }
+
+        RenderContext::~RenderContext()
+        {
+            destroyResources();
+
+            glDeleteVertexArrays(1, &m_DummyVAO);
+            for (auto [_, vao] : m_VertexArrays)
+                glDeleteVertexArrays(1, &vao);
+
+            m_CurrentPipeline = {};
+        }
+
+        RenderContext& RenderContext::setViewport(const Rect2D& rect)
+        {
+            VGFW_CAPTURE(onSetViewport(rect))
+            auto& current = m_CurrentPipeline.m_Viewport;
+            if (rect != current)
+            {
+                glViewport(rect.offset.x, rect.offset.y, rect.extent.width, rect.extent.height);
+                current = rect;
+            }
+            return *this;
+        }
+
+        Rect2D RenderContext::getViewport()
+        {
+            GLint viewport[4];
+            glGetIntegerv(GL_VIEWPORT, viewport);
+
+            return {{viewport[0], viewport[1]},
+                    {static_cast<uint32_t>(viewport[2]), static_cast<uint32_t>(viewport[3])}};
+        }
+
+        RenderContext& RenderContext::setScissor(const Rect2D& rect)
+        {
+            VGFW_CAPTURE(onSetScissor(rect))
+            auto& current = m_CurrentPipeline.m_Scissor;
+            if (rect != current)
+            {
+                glScissor(rect.offset.x, rect.offset.y, rect.extent.width, rect.extent.height);
+                current = rect;
+            }
+            return *this;
+        }
+
+        Buffer RenderContext::createBuffer(GLsizeiptr size, const void* data)
+        {
+            GLuint buffer;
+            glCreateBuffers(1, &buffer);
+            glNamedBufferStorage(buffer, size, data, GL_DYNAMIC_STORAGE_BIT);
+            g_GpuMemoryTracker.onBufferCreated(buffer, size);
+
+            return {buffer, size};
+        }
+
+        VertexBuffer RenderContext::createVertexBuffer(GLsizei stride, int64_t capacity, const void* data)
+        {
+            const GpuMemoryScope memoryScope {GpuMemoryCategory::eGeometry, false};
+            return VertexBuffer {createBuffer(stride * capacity, data), stride};
+        }
+
+        IndexBuffer RenderContext::createIndexBuffer(IndexType indexType, int64_t capacity, const void* data)
+        {
+            const GpuMemoryScope memoryScope {GpuMemoryCategory::eGeometry, false};
+            const auto stride = static_cast<GLsizei>(indexType);
+            return IndexBuffer {createBuffer(stride * capacity, data), indexType};
+        }
+
+        GLuint RenderContext::getVertexArray(const VertexAttributes& attributes)
+        {
+            assert(!attributes.empty());
+
+            std::size_t hash {0};
+            for (const auto& [location, attribute] : attributes)
+                utils::hashCombine(hash, location, attribute);
+
+            auto it = m_VertexArrays.find(hash);
+            if (it == m_VertexArrays.cend())
+            {
+                it = m_VertexArrays.emplace(hash, createVertexArray(attributes)).first;
+                VGFW_TRACE("[RenderContext] Created VAO: {0}", hash);
+                VGFW_CAPTURE(onCreateVertexArray(it->second, attributes))
+            }
+
+            return it->second;
+        }
+
+        GLuint RenderContext::getVertexArray(const VertexFormat& vertexFormat)
+        {
+            if (vertexFormat.m_VertexArrayContextId != m_Id)
+            {
+                vertexFormat.m_VertexArray          = getVertexArray(vertexFormat.getAttributes());
+                vertexFormat.m_VertexArrayContextId = m_Id;
+            }
+            return vertexFormat.m_VertexArray;
+        }
+
+        GLuint RenderContext::createGraphicsProgram(const std::string&                vertSource,
+                                                    const std::string&                fragSource,
+                                                    const std::optional<std::string>& geomSource)
+        {
+            const auto program = createShaderProgram({
+                createShaderObject(GL_VERTEX_SHADER, vertSource),
+                geomSource ? createShaderObject(GL_GEOMETRY_SHADER, *geomSource) : GL_NONE,
+                createShaderObject(GL_FRAGMENT_SHADER, fragSource),
+            });
+            VGFW_CAPTURE(onCreateGraphicsProgram(program, vertSource, fragSource, geomSource))
+
+            return program;
+        }
+
+        GLuint RenderContext::createComputeProgram(const std::string& compSource)
+        {
+            const auto program = createShaderProgram({
+                createShaderObject(GL_COMPUTE_SHADER, compSource),
+            });
+            VGFW_CAPTURE(onCreateComputeProgram(program, compSource))
+
+            return program;
+        }
+
+        Texture RenderContext::createTexture2D(Extent2D    extent,
+                                               PixelFormat pixelFormat,
+                                               uint32_t    numMipLevels,
+                                               uint32_t    numLayers)
+        {
+            assert(extent.width > 0 && extent.height > 0 && pixelFormat != PixelFormat::eUnknown);
+
+            if (numMipLevels <= 0)
+                numMipLevels = calcMipLevels(glm::max(extent.width, extent.height));
+
+            return createImmutableTexture(extent, 0, pixelFormat, 1, numMipLevels, numLayers);
+        }
+
+        Texture RenderContext::createTexture3D(Extent2D extent, uint32_t depth, PixelFormat pixelFormat)
+        {
+            return createImmutableTexture(extent, depth, pixelFormat, 1, 1, 0);
+        }
+
+        Texture
+        RenderContext::createCubemap(uint32_t size, PixelFormat pixelFormat, uint32_t numMipLevels, uint32_t numLayers)
+        {
+            assert(size > 0 && pixelFormat != PixelFormat::eUnknown);
+
+            if (numMipLevels <= 0)
+                numMipLevels = calcMipLevels(size);
+
+            return createImmutableTexture({size, size}, 0, pixelFormat, 6, numMipLevels, numLayers);
+        }
+
+        RenderContext& RenderContext::generateMipmaps(Texture& texture)
+        {
+            assert(texture);
+            VGFW_CAPTURE(onGenerateMipmaps(texture))
+            glGenerateTextureMipmap(texture.m_Id);
+
+            return *this;
+        }
+
+        RenderContext& RenderContext::setupSampler(Texture& texture, const SamplerInfo& samplerInfo)
+        {
+            assert(texture);
+            VGFW_CAPTURE(onSetupSampler(texture, samplerInfo))
+
+            glTextureParameteri(texture.m_Id,
+                                GL_TEXTURE_MIN_FILTER,
+                                selectTextureMinFilter(samplerInfo.minFilter, samplerInfo.mipmapMode));
+            glTextureParameteri(texture.m_Id, GL_TEXTURE_MAG_FILTER, static_cast<GLenum>(samplerInfo.magFilter));
+            glTextureParameteri(texture.m_Id, GL_TEXTURE_WRAP_S, static_cast<GLenum>(samplerInfo.addressModeS));
+            glTextureParameteri(texture.m_Id, GL_TEXTURE_WRAP_T, static_cast<GLenum>(samplerInfo.addressModeT));
+            glTextureParameteri(texture.m_Id, GL_TEXTURE_WRAP_R, static_cast<GLenum>(samplerInfo.addressModeR));
+
+            glTextureParameterf(texture.m_Id, GL_TEXTURE_MAX_ANISOTROPY, samplerInfo.maxAnisotropy);
+
+            if (samplerInfo.compareOperator.has_value())
+            {
+                glTextureParameteri(texture.m_Id, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+                glTextureParameteri(
+                    texture.m_Id, GL_TEXTURE_COMPARE_FUNC, static_cast<GLenum>(*samplerInfo.compareOperator));
+            }
+            glTextureParameterfv(texture.m_Id, GL_TEXTURE_BORDER_COLOR, glm::value_ptr(samplerInfo.borderColor));
+
+            return *this;
+        }
+
+        GLuint RenderContext::createSampler(const SamplerInfo& samplerInfo)
+        {
+            GLuint sampler {GL_NONE};
+            glCreateSamplers(1, &sampler);
+
+            glSamplerParameteri(
+                sampler, GL_TEXTURE_MIN_FILTER, selectTextureMinFilter(samplerInfo.minFilter, samplerInfo.mipmapMode));
+            glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, static_cast<GLenum>(samplerInfo.magFilter));
+            glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, static_cast<GLenum>(samplerInfo.addressModeS));
+            glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, static_cast<GLenum>(samplerInfo.addressModeT));
+            glSamplerParameteri(sampler, GL_TEXTURE_WRAP_R, static_cast<GLenum>(samplerInfo.addressModeR));
+
+            glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY, samplerInfo.maxAnisotropy);
+
+            if (samplerInfo.compareOperator.has_value())
+            {
+                glSamplerParameteri(sampler, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+                glSamplerParameteri(
+                    sampler, GL_TEXTURE_COMPARE_FUNC, static_cast<GLenum>(*samplerInfo.compareOperator));
+            }
+            glSamplerParameterfv(sampler, GL_TEXTURE_BORDER_COLOR, glm::value_ptr(samplerInfo.borderColor));
+            VGFW_CAPTURE(onCreateSampler(sampler, samplerInfo))
+
+            return sampler;
+        }
+
+        RenderContext& RenderContext::clear(Texture& texture)
+        {
+            assert(texture);
+            VGFW_CAPTURE(onClear(texture))
+            uint8_t v {0};
+            glClearTexImage(texture.m_Id, 0, GL_RED, GL_UNSIGNED_BYTE, &v);
+
+            return *this;
+        }
+
+        RenderContext&
+        RenderContext::upload(Texture& texture, GLint mipLevel, glm::uvec2 dimensions, const ImageData& image)
+        {
+            return upload(texture, mipLevel, {dimensions, 0}, 0, 0, image);
+        }
+
+        RenderContext& RenderContext::upload(Texture&         texture,
+                                             GLint            mipLevel,
+                                             GLint            face,
+                                             glm::uvec2       dimensions,
+                                             const ImageData& image)
+        {
+            return upload(texture, mipLevel, {dimensions, 0}, face, 0, image);
+        }
+
+        RenderContext& RenderContext::upload(Texture&          texture,
+                                             GLint             mipLevel,
+                                             const glm::uvec3& dimensions,
+                                             GLint             face,
+                                             GLsizei           layer,
+                                             const ImageData&  image)
+        {
+            assert(texture && image.pixels != nullptr);
+            VGFW_CAPTURE(onUpload(texture, mipLevel, dimensions, face, layer, image))
+            VGFW_RENDER_STAT(textureUploadBytes,
+                             static_cast<uint64_t>(dimensions.x) * std::max(dimensions.y, 1u) *
+                                 std::max(dimensions.z, 1u) * getImageDataPixelSize(image))
+
+            switch (texture.m_Type)
+            {
+                case GL_TEXTURE_1D:
+                    glTextureSubImage1D(
+                        texture.m_Id, mipLevel, 0, dimensions.x, image.format, image.dataType, image.pixels);
+                    break;
+                case GL_TEXTURE_1D_ARRAY:
+                    glTextureSubImage2D(
+                        texture.m_Id, mipLevel, 0, 0, dimensions.x, layer, image.format, image.dataType, image.pixels);
+                    break;
+                case GL_TEXTURE_2D:
+                    glTextureSubImage2D(texture.m_Id,
+                                        mipLevel,
+                                        0,
+                                        0,
+                                        dimensions.x,
+                                        dimensions.y,
+                                        image.format,
+                                        image.dataType,
+                                        image.pixels);
+                    break;
+                case GL_TEXTURE_2D_ARRAY:
+                    glTextureSubImage3D(texture.m_Id,
+                                        mipLevel,
+                                        0,
+                                        0,
+                                        layer,
+                                        dimensions.x,
+                                        dimensions.y,
+                                        1,
+                                        image.format,
+                                        image.dataType,
+                                        image.pixels);
+                    break;
+                case GL_TEXTURE_3D:
+                    glTextureSubImage3D(texture.m_Id,
+                                        mipLevel,
+                                        0,
+                                        0,
+                                        0,
+                                        dimensions.x,
+                                        dimensions.y,
+                                        dimensions.z,
+                                        image.format,
+                                        image.dataType,
+                                        image.pixels);
+                    break;
+                case GL_TEXTURE_CUBE_MAP:
+                    glTextureSubImage3D(texture.m_Id,
+                                        mipLevel,
+                                        0,
+                                        0,
+                                        face,
+                                        dimensions.x,
+                                        dimensions.y,
+                                        1,
+                                        image.format,
+                                        image.dataType,
+                                        image.pixels);
+                    break;
+                case GL_TEXTURE_CUBE_MAP_ARRAY: {
+                    const auto zoffset = (layer * 6) + face; // desired layer-face
+                    // depth = how many layer-faces
+                    glTextureSubImage3D(texture.m_Id,
+                                        mipLevel,
+                                        0,
+                                        0,
+                                        zoffset,
+                                        dimensions.x,
+                                        dimensions.y,
+                                        6 * texture.m_NumLayers,
+                                        image.format,
+                                        image.dataType,
+                                        image.pixels);
+                }
+                break;
+
+                default:
+                    assert(false);
+            }
+            return *this;
+        }
+
+        void RenderContext::download(const Texture& texture,
+                                     GLint          mipLevel,
+                                     GLenum         format,
+                                     GLenum         dataType,
+                                     GLsizei        size,
+                                     void*          pixels)
+        {
+            assert(texture && pixels != nullptr);
+            glGetTextureImage(texture.m_Id, mipLevel, format, dataType, size, pixels);
+        }
+
+        RenderContext& RenderContext::clear(Buffer& buffer)
+        {
+            assert(buffer);
+            VGFW_CAPTURE(onClear(buffer))
+
+            uint8_t v {0};
+            glClearNamedBufferData(buffer.m_Id, GL_R8, GL_RED, GL_UNSIGNED_BYTE, &v);
+
+            return *this;
+        }
+
+        RenderContext& RenderContext::upload(Buffer& buffer, GLintptr offset, GLsizeiptr size, const void* data)
+        {
+            assert(buffer);
+
+            if (size > 0 && data != nullptr)
+            {
+                VGFW_CAPTURE(onUpload(buffer, offset, size, data))
+                glNamedBufferSubData(buffer.m_Id, offset, size, data);
+                VGFW_RENDER_STAT(bufferUploadBytes, size)
+            }
+
+            return *this;
+        }
+
+        void* RenderContext::map(Buffer& buffer)
+        {
+            assert(buffer);
+
+            if (!buffer.isMapped())
+                buffer.m_MappedMemory = glMapNamedBuffer(buffer.m_Id, GL_WRITE_ONLY);
+
+            return buffer.m_MappedMemory;
+        }
+
+        RenderContext& RenderContext::unmap(Buffer& buffer)
+        {
+            assert(buffer);
+
+            if (buffer.isMapped())
+            {
+                glUnmapNamedBuffer(buffer.m_Id);
+                buffer.m_MappedMemory = nullptr;
+                VGFW_CAPTURE(onUnmap(buffer))
+            }
+
+            return *this;
+        }
+
+        RenderContext& RenderContext::destroy(Buffer& buffer)
+        {
+            if (buffer)
+            {
+                g_GpuMemoryTracker.onBufferDestroyed(buffer.m_Id);
+                VGFW_CAPTURE(onDestroy(buffer))
+                glDeleteBuffers(1, &buffer.m_Id);
+                buffer = {};
+            }
+
+            return *this;
+        }
+
+        RenderContext& RenderContext::destroy(Texture& texture)
+        {
+            if (texture)
+            {
+                g_GpuMemoryTracker.onTextureDestroyed(texture.m_Id);
+                VGFW_CAPTURE(onDestroy(texture))
+                glDeleteTextures(1, &texture.m_Id);
+                if (texture.m_View != GL_NONE)
+                    glDeleteTextures(1, &texture.m_View);
+                texture = {};
+            }
+            return *this;
+        }
+
+        RenderContext& RenderContext::destroy(GraphicsPipeline& gp)
+        {
+            if (gp.m_Program != GL_NONE)
+            {
+                VGFW_CAPTURE(onDestroyProgram(gp.m_Program))
+                glDeleteProgram(gp.m_Program);
+                gp.m_Program = GL_NONE;
+            }
+            gp.m_VAO = GL_NONE;
+            if (gp.m_Id == m_BoundPipelineId)
+                m_BoundPipelineId = 0;
+            gp.m_Id = 0;
+
+            return *this;
+        }
+
+        RenderContext& RenderContext::destroy(Sampler& sampler)
+        {
+            if (sampler.id != GL_NONE)
+            {
+                glDeleteSamplers(1, &sampler.id);
+                sampler.id = GL_NONE;
+            }
+
+            return *this;
+        }
+
+        void RenderContext::collectGarbage(uint32_t numFramesInFlight)
+        {
+            // Releases of frame N are safe once the fence of frame N retired, i.e. N + framesInFlight <= current frame
+            const auto it = std::find_if(m_PendingReleases.begin(), m_PendingReleases.end(), [&](const auto& pending) {
+                return pending.frameIndex + numFramesInFlight > m_FrameIndex;
+            });
+            for (auto pending = m_PendingReleases.begin(); pending != it; ++pending)
+                std::visit([this](auto& resource) { destroy(resource); }, pending->resource);
+            m_PendingReleases.erase(m_PendingReleases.begin(), it);
+
+            ++m_FrameIndex;
+        }
+
+        void RenderContext::destroyResources()
+        {
+            for (auto& pending : m_PendingReleases)
+                std::visit([this](auto& resource) { destroy(resource); }, pending.resource);
+            m_PendingReleases.clear();
+
+            std::apply(
+                [this](auto&... registries) {
+                    (registries.forEach([this](auto, auto& resource) { destroy(resource); }), ...);
+                    ((registries = std::remove_reference_t<decltype(registries)> {}), ...);
+                },
+                m_Registry);
+        }
+
+        RenderContext& RenderContext::dispatch(GLuint computeProgram, const glm::uvec3& numGroups)
+        {
+            VGFW_CAPTURE(onDispatch(computeProgram, numGroups))
+            setShaderProgram(computeProgram);
+            m_BoundPipelineId = 0;
+            glDispatchCompute(numGroups.x, numGroups.y, numGroups.z);
+            VGFW_RENDER_STAT(dispatches, 1)
+
+            return *this;
+        }
+
+        GLuint RenderContext::beginRendering(const RenderingInfo& renderingInfo)
+        {
+            return beginRendering(renderingInfo.area, renderingInfo.colorAttachments, renderingInfo.depthAttachment);
+        }
+
+        GLuint RenderContext::beginRendering(const FrameRenderingInfo& renderingInfo)
+        {
+            return beginRendering(renderingInfo.area, renderingInfo.colorAttachments, renderingInfo.depthAttachment);
+        }
+
+        GLuint RenderContext::beginRendering(const Rect2D&                        area,
+                                             std::span<const AttachmentInfo>      colorAttachments,
+                                             const std::optional<AttachmentInfo>& depthAttachment)
+        {
+            assert(!m_RenderingStarted);
+            VGFW_CAPTURE(onBeginRendering(area, colorAttachments, depthAttachment))
+
+            GLuint framebuffer;
+            glCreateFramebuffers(1, &framebuffer);
+            VGFW_RENDER_STAT(framebufferCreations, 1)
+            if (depthAttachment.has_value())
+            {
+                attachTexture(framebuffer, GL_DEPTH_ATTACHMENT, *depthAttachment);
+            }
+            for (size_t i {0}; i < colorAttachments.size(); ++i)
+            {
+                attachTexture(framebuffer, GL_COLOR_ATTACHMENT0 + i, colorAttachments[i]);
+            }
+            if (const auto n = colorAttachments.size(); n > 0)
+            {
+                memory::FrameVector<GLenum> colorBuffers(n);
+                std::iota(colorBuffers.begin(), colorBuffers.end(), GL_COLOR_ATTACHMENT0);
+                glNamedFramebufferDrawBuffers(framebuffer, colorBuffers.size(), colorBuffers.data());
+            }
+#ifdef _DEBUG
+            const auto status = glCheckNamedFramebufferStatus(framebuffer, GL_DRAW_FRAMEBUFFER);
+            assert(GL_FRAMEBUFFER_COMPLETE == status);
+#endif
+
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+            setViewport(area);
+            setScissorTest(false);
+            // Scissor test and depth write may differ from the bound pipeline now
+            m_BoundPipelineId = 0;
+            m_BoundStateKey.reset();
+
+            if (depthAttachment.has_value())
+                if (depthAttachment->clearValue.has_value())
+                {
+                    setDepthWrite(true);
+
+                    const auto clearValue = std::get<float>(*depthAttachment->clearValue);
+                    glClearNamedFramebufferfv(framebuffer, GL_DEPTH, 0, &clearValue);
+                }
+            for (int32_t i {0}; const auto& attachment : colorAttachments)
+            {
+                if (attachment.clearValue.has_value())
+                {
+                    const auto& clearValue = std::get<glm::vec4>(*attachment.clearValue);
+                    glClearNamedFramebufferfv(framebuffer, GL_COLOR, i, glm::value_ptr(clearValue));
+                }
+                ++i;
+            }
+
+            m_RenderingStarted = true;
+
+            return framebuffer;
+        }
+
+        RenderContext& RenderContext::beginRendering(const Rect2D&            area,
+                                                     std::optional<glm::vec4> clearColor,
+                                                     std::optional<float>     clearDepth,
+                                                     std::optional<int>       clearStencil)
+        {
+            VGFW_CAPTURE(onBeginRendering(area, clearColor, clearDepth, clearStencil))
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, GL_NONE);
+            setViewport(area);
+            setScissorTest(false);
+            m_BoundPipelineId = 0;
+            m_BoundStateKey.reset();
+
+            if (clearDepth.has_value())
+            {
+                setDepthWrite(true);
+                glClearNamedFramebufferfv(GL_NONE, GL_DEPTH, 0, &clearDepth.value());
+            }
+            if (clearStencil.has_value())
+                glClearNamedFramebufferiv(GL_NONE, GL_STENCIL, 0, &clearStencil.value());
+            if (clearColor.has_value())
+            {
+                glClearNamedFramebufferfv(GL_NONE, GL_COLOR, 0, glm::value_ptr(clearColor.value()));
+            }
+
+            return *this;
+        }
+
+        RenderContext& RenderContext::endRendering(GLuint frameBufferID)
+        {
+            assert(m_RenderingStarted && frameBufferID != GL_NONE);
+            VGFW_CAPTURE(onEndRendering())
+
+            glDeleteFramebuffers(1, &frameBufferID);
+            m_RenderingStarted = false;
+
+            return *this;
+        }
+
+        RenderContext& RenderContext::bindGraphicsPipeline(const GraphicsPipeline& gp)
+        {
+            VGFW_CAPTURE(onBindGraphicsPipeline(gp))
+            VGFW_RENDER_STAT(pipelineBinds, 1)
+
+            if (gp.m_Id != 0 && gp.m_Id == m_BoundPipelineId)
+            {
+                VGFW_RENDER_STAT(redundantBindsSkipped, 1)
+                return *this;
+            }
+
+            // Only the state groups whose bits differ from the bound key are applied, everything without a key
+            using Key       = PipelineStateKey;
+            const auto diff = [&]() -> Key::Bits {
+                if (gp.m_Id == 0 || !m_BoundStateKey)
+                    return {~0ull, ~0ull};
+                return {gp.m_StateKey.bits[0] ^ m_BoundStateKey->bits[0],
+                        gp.m_StateKey.bits[1] ^ m_BoundStateKey->bits[1]};
+            }();
+
+            {
+                const auto& state = gp.m_DepthStencilState;
+                if (Key::intersects(diff, Key::kDepthTest))
+                    setDepthTest(state.depthTest, state.depthCompareOp);
+                if (Key::intersects(diff, Key::kDepthWrite))
+                    setDepthWrite(state.depthWrite);
+            }
+
+            {
+                const auto& state = gp.m_RasterizerState;
+                if (Key::intersects(diff, Key::kPolygonMode))
+                    setPolygonMode(state.polygonMode);
+                if (Key::intersects(diff, Key::kCullMode))
+                    setCullMode(state.cullMode);
+                if (Key::intersects(diff, Key::kPolygonOffset) || state.polygonOffset)
+                    setPolygonOffset(state.polygonOffset);
+                if (Key::intersects(diff, Key::kDepthClamp))
+                    setDepthClamp(state.depthClampEnable);
+                if (Key::intersects(diff, Key::kScissorTest))
+                    setScissorTest(state.scissorTest);
+            }
+
+            for (uint32_t i {0}; i < gp.m_BlendStates.size(); ++i)
+            {
+                if (Key::intersects(diff, Key::getBlendField(i)))
+                    setBlendState(i, gp.m_BlendStates[i]);
+            }
+
+            setVertexArray(gp.m_VAO);
+            setShaderProgram(gp.m_Program);
+
+            m_BoundPipelineId = gp.m_Id;
+            m_BoundStateKey   = gp.m_Id != 0 ? std::optional {gp.m_StateKey} : std::nullopt;
+
+            return *this;
+        }
+
+        RenderContext& RenderContext::setUniform1f(const std::string& name, float f)
+        {
+            VGFW_CAPTURE(onSetUniform(CommandType::eSetUniform1f, name, &f, sizeof(f)))
+            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
+            if (location != GL_INVALID_INDEX)
+                glProgramUniform1f(m_CurrentPipeline.m_Program, location, f);
+            return *this;
+        }
+
+        RenderContext& RenderContext::setUniform1i(const std::string& name, int32_t i)
+        {
+            VGFW_CAPTURE(onSetUniform(CommandType::eSetUniform1i, name, &i, sizeof(i)))
+            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
+            if (location != GL_INVALID_INDEX)
+                glProgramUniform1i(m_CurrentPipeline.m_Program, location, i);
+            return *this;
+        }
+
+        RenderContext& RenderContext::setUniform1ui(const std::string& name, uint32_t i)
+        {
+            VGFW_CAPTURE(onSetUniform(CommandType::eSetUniform1ui, name, &i, sizeof(i)))
+            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
+            if (location != GL_INVALID_INDEX)
+                glProgramUniform1ui(m_CurrentPipeline.m_Program, location, i);
+            return *this;
+        }
+
+        RenderContext& RenderContext::setUniformVec2(const std::string& name, const glm::vec2& v)
+        {
+            VGFW_CAPTURE(onSetUniform(CommandType::eSetUniformVec2, name, &v, sizeof(v)))
+            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
+            if (location != GL_INVALID_INDEX)
+            {
+                glProgramUniform2fv(m_CurrentPipeline.m_Program, location, 1, glm::value_ptr(v));
+            }
+            return *this;
+        }
+
+        RenderContext& RenderContext::setUniformVec3(const std::string& name, const glm::vec3& v)
+        {
+            VGFW_CAPTURE(onSetUniform(CommandType::eSetUniformVec3, name, &v, sizeof(v)))
+            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
+            if (location != GL_INVALID_INDEX)
+            {
+                glProgramUniform3fv(m_CurrentPipeline.m_Program, location, 1, glm::value_ptr(v));
+            }
+            return *this;
+        }
+
+        RenderContext& RenderContext::setUniformVec4(const std::string& name, const glm::vec4& v)
+        {
+            VGFW_CAPTURE(onSetUniform(CommandType::eSetUniformVec4, name, &v, sizeof(v)))
+            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
+            if (location != GL_INVALID_INDEX)
+            {
+                glProgramUniform4fv(m_CurrentPipeline.m_Program, location, 1, glm::value_ptr(v));
+            }
+            return *this;
+        }
+
+        RenderContext& RenderContext::setUniformMat3(const std::string& name, const glm::mat3& m)
+        {
+            VGFW_CAPTURE(onSetUniform(CommandType::eSetUniformMat3, name, &m, sizeof(m)))
+            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
+            if (location != GL_INVALID_INDEX)
+            {
+                glProgramUniformMatrix3fv(m_CurrentPipeline.m_Program, location, 1, GL_FALSE, glm::value_ptr(m));
+            }
+            return *this;
+        }
+
+        RenderContext& RenderContext::setUniformMat4(const std::string& name, const glm::mat4& m)
+        {
+            VGFW_CAPTURE(onSetUniform(CommandType::eSetUniformMat4, name, &m, sizeof(m)))
+            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
+            if (location != GL_INVALID_INDEX)
+            {
+                glProgramUniformMatrix4fv(m_CurrentPipeline.m_Program, location, 1, GL_FALSE, glm::value_ptr(m));
+            }
+            return *this;
+        }
+
+        RenderContext& RenderContext::bindImage(GLuint unit, const Texture& texture, GLint mipLevel, GLenum access)
+        {
+            assert(texture && mipLevel < texture.m_NumMipLevels);
+            VGFW_CAPTURE(onBindImage(unit, texture, mipLevel, access))
+            glBindImageTexture(
+                unit, texture.m_Id, mipLevel, GL_FALSE, 0, access, static_cast<GLenum>(texture.m_PixelFormat));
+            VGFW_RENDER_STAT(textureBinds, 1)
+            return *this;
+        }
+
+        RenderContext& RenderContext::bindTexture(GLuint unit, const Texture& texture, std::optional<GLuint> samplerId)
+        {
+            assert(texture);
+            VGFW_CAPTURE(onBindTexture(unit, texture, samplerId))
+            glBindTextureUnit(unit, texture.m_Id);
+            if (samplerId.has_value())
+                glBindSampler(unit, *samplerId);
+            VGFW_RENDER_STAT(textureBinds, 1)
+            return *this;
+        }
+
+        RenderContext& RenderContext::bindUniformBuffer(GLuint index, const UniformBuffer& buffer)
+        {
+            assert(buffer);
+            VGFW_CAPTURE(onBindBuffer(TraceRecordType::eBindUniformBuffer, index, buffer))
+            glBindBufferBase(GL_UNIFORM_BUFFER, index, buffer.m_Id);
+            VGFW_RENDER_STAT(bufferBinds, 1)
+            return *this;
+        }
+
+        RenderContext& RenderContext::bindStorageBuffer(GLuint index, const StorageBuffer& buffer)
+        {
+            assert(buffer);
+            VGFW_CAPTURE(onBindBuffer(TraceRecordType::eBindStorageBuffer, index, buffer))
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index, buffer.m_Id);
+            VGFW_RENDER_STAT(bufferBinds, 1)
+            return *this;
+        }
+
+        RenderContext& RenderContext::bindMeshPrimitiveMaterialBuffer(GLuint                         index,
+                                                                      const resource::MeshPrimitive& meshPrimitive)
+        {
+            return bindUniformBuffer(index, *get(meshPrimitive.materialBuffer));
+        }
+
+        RenderContext& RenderContext::bindMeshPrimitiveTextures(GLuint                         startUnit,
+                                                                const resource::MeshPrimitive& meshPrimitive,
+                                                                std::optional<GLuint>          samplerId)
+        {
+            meshPrimitive.ownerModel->bindMeshPrimitiveTextures(
+                meshPrimitive.indexInOwnerModel, startUnit, *this, samplerId);
+            return *this;
+        }
+
+        RenderContext& RenderContext::drawFullScreenTriangle()
+        {
+            return draw({},
+                        {},
+                        {
+                            .topology    = PrimitiveTopology::eTriangleList,
+                            .numVertices = 3,
+                        });
+        }
+
+        RenderContext& RenderContext::drawCube()
+        {
+            return draw({},
+                        {},
+                        {
+                            .topology    = PrimitiveTopology::eTriangleList,
+                            .numVertices = 36,
+                        });
+        }
+
+        RenderContext& RenderContext::draw(OptionalReference<const VertexBuffer> vertexBuffer,
+                                           OptionalReference<const IndexBuffer>  indexBuffer,
+                                           const GeometryInfo&                   geometryInfo,
+                                           uint32_t                              numInstances)
+        {
+            VGFW_PROFILE_FUNCTION
+            VGFW_CAPTURE(onDraw(vertexBuffer ? &vertexBuffer->get() : nullptr,
+                                indexBuffer ? &indexBuffer->get() : nullptr,
+                                geometryInfo,
+                                numInstances))
+            if (vertexBuffer.has_value())
+            {
+                setVertexBuffer(*vertexBuffer);
+                VGFW_RENDER_STAT(bufferBinds, 1)
+            }
+
+            VGFW_RENDER_STAT(drawCalls, 1)
+            VGFW_RENDER_STAT(instances, numInstances)
+
+            if (geometryInfo.numIndices > 0)
+            {
+                assert(indexBuffer.has_value());
+                setIndexBuffer(*indexBuffer);
+                VGFW_RENDER_STAT(bufferBinds, 1)
+                VGFW_RENDER_STAT(indices, static_cast<uint64_t>(geometryInfo.numIndices) * numInstances)
+                VGFW_RENDER_STAT(triangles,
+                                 countTriangles(geometryInfo.topology, geometryInfo.numIndices) * numInstances)
+
+                const auto stride = static_cast<GLsizei>(indexBuffer->get().getIndexType());
+                const auto indices =
+                    reinterpret_cast<const void*>(static_cast<uint64_t>(stride) * geometryInfo.indexOffset);
+
+                glDrawElementsInstancedBaseVertex(static_cast<GLenum>(geometryInfo.topology),
+                                                  geometryInfo.numIndices,
+                                                  getIndexDataType(stride),
+                                                  indices,
+                                                  numInstances,
+                                                  geometryInfo.vertexOffset);
+            }
+            else
+            {
+                glDrawArraysInstanced(static_cast<GLenum>(geometryInfo.topology),
+                                      geometryInfo.vertexOffset,
+                                      geometryInfo.numVertices,
+                                      numInstances);
+                VGFW_RENDER_STAT(triangles,
+                                 countTriangles(geometryInfo.topology, geometryInfo.numVertices) * numInstances)
+            }
+            return *this;
+        }
+
+        RenderContext& RenderContext::drawMeshPrimitive(const resource::MeshPrimitive& meshPrimitive)
+        {
+            VGFW_PROFILE_FUNCTION
+            meshPrimitive.draw(*this);
+            return *this;
+        }
+
+        namespace command
+        {
+            struct BindImage
+            {
+                GLuint         unit;
+                const Texture* texture;
+                GLint          mipLevel;
+                GLenum         access;
+            };
+            struct BindTexture
+            {
+                GLuint         unit;
+                const Texture* texture;
+                bool           hasSampler;
+                GLuint         samplerId;
+            };
+            struct BindBuffer
+            {
+                GLuint        index;
+                const Buffer* buffer;
+            };
+            struct BindMeshPrimitive
+            {
+                GLuint                         unit;
+                const resource::MeshPrimitive* meshPrimitive;
+                bool                           hasSampler;
+                GLuint                         samplerId;
+            };
+            struct Dispatch
+            {
+                GLuint     computeProgram;
+                glm::uvec3 numGroups;
+            };
+            struct Draw
+            {
+                const VertexBuffer* vertexBuffer;
+                const IndexBuffer*  indexBuffer;
+                GeometryInfo        geometryInfo;
+                uint32_t            numInstances;
+            };
+
+            template<typename T>
+            T read(const std::byte* payload)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                T v;
+                memcpy(&v, payload, sizeof(T));
+                return v;
+            }
+        } // namespace command
+
+        RenderContext& RenderContext::execute(const CommandList& commandList)
+        {
+            VGFW_PROFILE_FUNCTION
+
+            // Uniform names are stored inline, reuse one string for the whole list.
+            std::string name;
+
+            const auto* it  = commandList.m_Stream.data();
+            const auto* end = it + commandList.m_Stream.size();
+            while (it < end)
+            {
+                const auto  header  = command::read<CommandList::CommandHeader>(it);
+                const auto* payload = it + sizeof(CommandList::CommandHeader);
+                if (header.nameLength > 0)
+                    name.assign(reinterpret_cast<const char*>(payload + header.payloadSize), header.nameLength);
+
+                switch (header.type)
+                {
+                    using enum CommandType;
+                    case eSetViewport:
+                        setViewport(command::read<Rect2D>(payload));
+                        break;
+                    case eSetScissor:
+                        setScissor(command::read<Rect2D>(payload));
+                        break;
+
+                    case eBindGraphicsPipeline:
+                        bindGraphicsPipeline(command::read<GraphicsPipeline>(payload));
+                        break;
+                    case eBindImage: {
+                        const auto cmd = command::read<command::BindImage>(payload);
+                        bindImage(cmd.unit, *cmd.texture, cmd.mipLevel, cmd.access);
+                    }
+                    break;
+                    case eBindTexture: {
+                        const auto cmd = command::read<command::BindTexture>(payload);
+                        bindTexture(cmd.unit,
+                                    *cmd.texture,
+                                    cmd.hasSampler ? std::optional<GLuint> {cmd.samplerId} : std::nullopt);
+                    }
+                    break;
+                    case eBindUniformBuffer: {
+                        const auto cmd = command::read<command::BindBuffer>(payload);
+                        bindUniformBuffer(cmd.index, *cmd.buffer);
+                    }
+                    break;
+                    case eBindStorageBuffer: {
+                        const auto cmd = command::read<command::BindBuffer>(payload);
+                        bindStorageBuffer(cmd.index, *cmd.buffer);
+                    }
+                    break;
+                    case eBindMeshPrimitiveMaterialBuffer: {
+                        const auto cmd = command::read<command::BindMeshPrimitive>(payload);
+                        bindMeshPrimitiveMaterialBuffer(cmd.unit, *cmd.meshPrimitive);
+                    }
+                    break;
+                    case eBindMeshPrimitiveTextures: {
+                        const auto cmd = command::read<command::BindMeshPrimitive>(payload);
+                        bindMeshPrimitiveTextures(cmd.unit,
+                                                  *cmd.meshPrimitive,
+                                                  cmd.hasSampler ? std::optional<GLuint> {cmd.samplerId} :
+                                                                   std::nullopt);
+                    }
+                    break;
+
+                    case eSetUniform1f:
+                        setUniform1f(name, command::read<float>(payload));
+                        break;
+                    case eSetUniform1i:
+                        setUniform1i(name, command::read<int32_t>(payload));
+                        break;
+                    case eSetUniform1ui:
+                        setUniform1ui(name, command::read<uint32_t>(payload));
+                        break;
+                    case eSetUniformVec2:
+                        setUniformVec2(name, command::read<glm::vec2>(payload));
+                        break;
+                    case eSetUniformVec3:
+                        setUniformVec3(name, command::read<glm::vec3>(payload));
+                        break;
+                    case eSetUniformVec4:
+                        setUniformVec4(name, command::read<glm::vec4>(payload));
+                        break;
+                    case eSetUniformMat3:
+                        setUniformMat3(name, command::read<glm::mat3>(payload));
+                        break;
+                    case eSetUniformMat4:
+                        setUniformMat4(name, command::read<glm::mat4>(payload));
+                        break;
+
+                    case eDispatch: {
+                        const auto cmd = command::read<command::Dispatch>(payload);
+                        dispatch(cmd.computeProgram, cmd.numGroups);
+                    }
+                    break;
+                    case eDraw: {
+                        const auto cmd = command::read<command::Draw>(payload);
+
+                        OptionalReference<const VertexBuffer> vertexBuffer;
+                        if (cmd.vertexBuffer)
+                            vertexBuffer = *cmd.vertexBuffer;
+                        OptionalReference<const IndexBuffer> indexBuffer;
+                        if (cmd.indexBuffer)
+                            indexBuffer = *cmd.indexBuffer;
+
+                        draw(vertexBuffer, indexBuffer, cmd.geometryInfo, cmd.numInstances);
+                    }
+                    break;
+                    case eDrawMeshPrimitive:
+                        drawMeshPrimitive(*command::read<const resource::MeshPrimitive*>(payload));
+                        break;
+
+                    default:
+                        assert(false);
+                }
+
+                it = payload + header.payloadSize + header.nameLength;
+            }
+
+            return *this;
+        }
+
+        GLuint RenderContext::createVertexArray(const VertexAttributes& attributes)
+        {
+            GLuint vao;
+            glCreateVertexArrays(1, &vao);
+
+            for (const auto& [location, attribute] : attributes)
+            {
+                const auto [type, size, normalized] = statAttribute(attribute.vertType);
+                assert(type != GL_INVALID_INDEX);
+
+                glEnableVertexArrayAttrib(vao, location);
+                if (attribute.vertType == VertexAttribute::Type::eInt4)
+                {
+                    glVertexArrayAttribIFormat(vao, location, size, type, attribute.offset);
+                }
+                else
+                {
+                    glVertexArrayAttribFormat(vao, location, size, type, normalized, attribute.offset);
+                }
+                glVertexArrayAttribBinding(vao, location, 0);
+            }
+            return vao;
+        }
+
+        Texture RenderContext::createImmutableTexture(Extent2D    extent,
+                                                      uint32_t    depth,
+                                                      PixelFormat pixelFormat,
+                                                      uint32_t    numFaces,
+                                                      uint32_t    numMipLevels,
+                                                      uint32_t    numLayers)
+        {
+            assert(numMipLevels > 0);
+
+            // http://github.khronos.org/KTX-Specification/#_texture_type
+
+            GLenum target = numFaces == 6     ? GL_TEXTURE_CUBE_MAP :
+                            depth > 0         ? GL_TEXTURE_3D :
+                            extent.height > 0 ? GL_TEXTURE_2D :
+                                                GL_TEXTURE_1D;
+            assert(target == GL_TEXTURE_CUBE_MAP ? extent.width == extent.height : true);
+
+            if (numLayers > 0)
+            {
+                switch (target)
+                {
+                    case GL_TEXTURE_1D:
+                        target = GL_TEXTURE_1D_ARRAY;
+                        break;
+                    case GL_TEXTURE_2D:
+                        target = GL_TEXTURE_2D_ARRAY;
+                        break;
+                    case GL_TEXTURE_CUBE_MAP:
+                        target = GL_TEXTURE_CUBE_MAP_ARRAY;
+                        break;
+
+                    default:
+                        assert(false);
+                }
+            }
+
+            GLuint id {GL_NONE};
+            glCreateTextures(target, 1, &id);
+
+            const auto internalFormat = static_cast<GLenum>(pixelFormat);
+            switch (target)
+            {
+                case GL_TEXTURE_1D:
+                    glTextureStorage1D(id, numMipLevels, internalFormat, extent.width);
+                    break;
+                case GL_TEXTURE_1D_ARRAY:
+                    glTextureStorage2D(id, numMipLevels, internalFormat, extent.width, numLayers);
+                    break;
+
+                case GL_TEXTURE_2D:
+                    glTextureStorage2D(id, numMipLevels, internalFormat, extent.width, extent.height);
+                    break;
+                case GL_TEXTURE_2D_ARRAY:
+                    glTextureStorage3D(id, numMipLevels, internalFormat, extent.width, extent.height, numLayers);
+                    break;
+
+                case GL_TEXTURE_3D:
+                    glTextureStorage3D(id, numMipLevels, internalFormat, extent.width, extent.height, depth);
+                    break;
+
+                case GL_TEXTURE_CUBE_MAP:
+                    glTextureStorage2D(id, numMipLevels, internalFormat, extent.width, extent.height);
+                    break;
+                case GL_TEXTURE_CUBE_MAP_ARRAY:
+                    glTextureStorage3D(id, numMipLevels, internalFormat, extent.width, extent.height, numLayers * 6);
+                    break;
+            }
+
+            g_GpuMemoryTracker.onTextureCreated(
+                id, calcTextureMemorySize(pixelFormat, extent, depth, numFaces, numMipLevels, numLayers));
+
+            return Texture {
+                id,
+                target,
+                pixelFormat,
+                extent,
+                depth,
+                numMipLevels,
+                numLayers,
+            };
+        }
+
+        void RenderContext::createFaceView(Texture& cubeMap, GLuint mipLevel, GLuint layer, GLuint face)
+        {
+            assert(cubeMap.m_Type == GL_TEXTURE_CUBE_MAP || cubeMap.m_Type == GL_TEXTURE_CUBE_MAP_ARRAY);
+
+            if (cubeMap.m_View != GL_NONE)
+                glDeleteTextures(1, &cubeMap.m_View);
+            glGenTextures(1, &cubeMap.m_View);
+
+            glTextureView(cubeMap.m_View,
+                          GL_TEXTURE_2D,
+                          cubeMap.m_Id,
+                          static_cast<GLenum>(cubeMap.m_PixelFormat),
+                          mipLevel,
+                          1,
+                          (layer * 6) + face,
+                          1);
+        }
+
+        void RenderContext::attachTexture(GLuint framebuffer, GLenum attachment, const AttachmentInfo& info)
+        {
+            const auto& [image, mipLevel, maybeLayer, maybeFace, _] = info;
+
+            switch (image.m_Type)
+            {
+                case GL_TEXTURE_CUBE_MAP:
+                case GL_TEXTURE_CUBE_MAP_ARRAY:
+                    createFaceView(image, mipLevel, maybeLayer.value_or(0), maybeFace.value_or(0));
+                    glNamedFramebufferTexture(framebuffer, attachment, image.m_View, 0);
+                    break;
+
+                case GL_TEXTURE_2D:
+                    glNamedFramebufferTexture(framebuffer, attachment, image.m_Id, mipLevel);
+                    break;
+
+                case GL_TEXTURE_2D_ARRAY:
+                    assert(maybeLayer.has_value());
+                    glNamedFramebufferTextureLayer(
+                        framebuffer, attachment, image.m_Id, mipLevel, maybeLayer.value_or(0));
+                    break;
+
+                case GL_TEXTURE_3D:
+                    glNamedFramebufferTexture(framebuffer, attachment, image.m_Id, 0);
+                    break;
+
+                default:
+                    assert(false);
+            }
+        }
+
+        GLuint RenderContext::createShaderProgram(std::initializer_list<GLuint> shaders)
+        {
+            const auto program = glCreateProgram();
+
+            for (auto shader : shaders)
+                if (shader != GL_NONE)
+                    glAttachShader(program, shader);
+
+            glLinkProgram(program);
+
+            GLint status;
+            glGetProgramiv(program, GL_LINK_STATUS, &status);
+            if (GL_FALSE == status)
+            {
+                GLint infoLogLength;
+                glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLogLength);
+                assert(infoLogLength > 0);
+                std::string infoLog("", infoLogLength);
+                glGetProgramInfoLog(program, infoLogLength, nullptr, infoLog.data());
+
+                VGFW_ERROR("[ShaderInfoLog] {0}", infoLog);
+
+                throw std::runtime_error {infoLog};
+            }
+            for (auto shader : shaders)
+            {
+                if (shader != GL_NONE)
+                {
+                    glDetachShader(program, shader);
+                    glDeleteShader(shader);
+                }
+            }
+
+            return program;
+        }
+
+        GLuint RenderContext::createShaderObject(GLenum type, const std::string& shaderSource)
+        {
+            auto          id = glCreateShader(type);
+            const GLchar* strings {shaderSource.data()};
+            glShaderSource(id, 1, &strings, nullptr);
+            glCompileShader(id);
+
+            GLint status;
+            glGetShaderiv(id, GL_COMPILE_STATUS, &status);
+            if (GL_FALSE == status)
+            {
+                GLint infoLogLength;
+                glGetShaderiv(id, GL_INFO_LOG_LENGTH, &infoLogLength);
+                assert(infoLogLength > 0);
+                std::string infoLog("", infoLogLength);
+                glGetShaderInfoLog(id, infoLogLength, nullptr, infoLog.data());
+
+                VGFW_ERROR("[ShaderInfoLog] {0}", infoLog);
+                throw std::runtime_error {infoLog};
+            };
+
+            return id;
+        }
+
+        void RenderContext::setShaderProgram(GLuint program)
+        {
+            assert(program != GL_NONE);
+            if (auto& current = m_CurrentPipeline.m_Program; current != program)
+            {
+                glUseProgram(program);
+                current = program;
+                VGFW_RENDER_STAT(programBinds, 1)
+            }
+            else
+            {
+                VGFW_RENDER_STAT(redundantBindsSkipped, 1)
+            }
+        }
+
+        void RenderContext::setVertexArray(GLuint vao)
+        {
+            if (GL_NONE == vao)
+                vao = m_DummyVAO;
+
+            if (auto& current = m_CurrentPipeline.m_VAO; vao != current)
+            {
+                glBindVertexArray(vao);
+                current = vao;
+                VGFW_RENDER_STAT(vaoBinds, 1)
+            }
+            else
+            {
+                VGFW_RENDER_STAT(redundantBindsSkipped, 1)
+            }
+        }
+
+        void RenderContext::setVertexBuffer(const VertexBuffer& vertexBuffer) const
+        {
+            const auto vao = m_CurrentPipeline.m_VAO;
+            assert(vertexBuffer && vao != GL_NONE);
+            glVertexArrayVertexBuffer(vao, 0, vertexBuffer.m_Id, 0, vertexBuffer.getStride());
+        }
+
+        void RenderContext::setIndexBuffer(const IndexBuffer& indexBuffer) const
+        {
+            const auto vao = m_CurrentPipeline.m_VAO;
+            assert(indexBuffer && vao != GL_NONE);
+            glVertexArrayElementBuffer(vao, indexBuffer.m_Id);
+        }
+
+        void RenderContext::setDepthTest(bool enabled, CompareOp depthFunc)
+        {
+            auto& current = m_CurrentPipeline.m_DepthStencilState;
+            if (enabled != current.depthTest)
+            {
+                enabled ? glEnable(GL_DEPTH_TEST) : glDisable(GL_DEPTH_TEST);
+                current.depthTest = enabled;
+            }
+            if (enabled && depthFunc != current.depthCompareOp)
+            {
+                glDepthFunc(static_cast<GLenum>(depthFunc));
+                current.depthCompareOp = depthFunc;
+            }
+        }
+
+        void RenderContext::setDepthWrite(bool enabled)
+        {
+            auto& current = m_CurrentPipeline.m_DepthStencilState;
+            if (enabled != current.depthWrite)
+            {
+                glDepthMask(enabled);
+                current.depthWrite = enabled;
+            }
+        }
+
+        void RenderContext::setPolygonMode(PolygonMode polygonMode)
+        {
+            auto& current = m_CurrentPipeline.m_RasterizerState.polygonMode;
+            if (polygonMode != current)
+            {
+                glPolygonMode(GL_FRONT_AND_BACK, static_cast<GLenum>(polygonMode));
+                current = polygonMode;
+            }
+        }
+
+        void RenderContext::setPolygonOffset(std::optional<PolygonOffset> polygonOffset)
+        {
+            auto& current = m_CurrentPipeline.m_RasterizerState;
+            if (polygonOffset != current.polygonOffset)
+            {
+                const auto offsetCap = getPolygonOffsetCap(current.polygonMode);
+                if (polygonOffset.has_value())
+                {
+                    glEnable(offsetCap);
+                    glPolygonOffset(polygonOffset->factor, polygonOffset->units);
+                }
+                else
+                {
+                    glDisable(offsetCap);
+                }
+                current.polygonOffset = polygonOffset;
+            }
+        }
+
+        void RenderContext::setCullMode(CullMode cullMode)
+        {
+            auto& current = m_CurrentPipeline.m_RasterizerState.cullMode;
+            if (cullMode != current)
+            {
+                if (cullMode != CullMode::eNone)
+                {
+                    if (current == CullMode::eNone)
+                        glEnable(GL_CULL_FACE);
+                    glCullFace(static_cast<GLenum>(cullMode));
+                }
+                else
+                {
+                    glDisable(GL_CULL_FACE);
+                }
+                current = cullMode;
+            }
+        }
+
+        void RenderContext::setDepthClamp(bool enabled)
+        {
+            auto& current = m_CurrentPipeline.m_RasterizerState.depthClampEnable;
+            if (enabled != current)
+            {
+                enabled ? glEnable(GL_DEPTH_CLAMP) : glDisable(GL_DEPTH_CLAMP);
+                current = enabled;
+            }
+        }
+
+        void RenderContext::setScissorTest(bool enabled)
+        {
+            auto& current = m_CurrentPipeline.m_RasterizerState.scissorTest;
+            if (enabled != current)
+            {
+                enabled ? glEnable(GL_SCISSOR_TEST) : glDisable(GL_SCISSOR_TEST);
+                current = enabled;
+            }
+        }
+
+        void RenderContext::setBlendState(GLuint index, const BlendState& state)
+        {
+            auto& current = m_CurrentPipeline.m_BlendStates[index];
+            if (state != current)
+            {
+                if (state.enabled != current.enabled)
+                {
+                    state.enabled ? glEnablei(GL_BLEND, index) : glDisablei(GL_BLEND, index);
+                    current.enabled = state.enabled;
+                }
+                if (state.enabled)
+                {
+                    if (state.colorOp != current.colorOp || state.alphaOp != current.alphaOp)
+                    {
+                        glBlendEquationSeparatei(
+                            index, static_cast<GLenum>(state.colorOp), static_cast<GLenum>(state.alphaOp));
+
+                        current.colorOp = state.colorOp;
+                        current.alphaOp = state.alphaOp;
+                    }
+                    if (state.srcColor != current.srcColor || state.destColor != current.destColor ||
+                        state.srcAlpha != current.srcAlpha || state.destAlpha != current.destAlpha)
+                    {
+                        glBlendFuncSeparatei(index,
+                                             static_cast<GLenum>(state.srcColor),
+                                             static_cast<GLenum>(state.destColor),
+                                             static_cast<GLenum>(state.srcAlpha),
+                                             static_cast<GLenum>(state.destAlpha));
+
+                        current.srcColor  = state.srcColor;
+                        current.destColor = state.destColor;
+                        current.srcAlpha  = state.srcAlpha;
+                        current.destAlpha = state.destAlpha;
+                    }
+                }
+            }
+        }
+
+        template<typename T>
+        CommandList& CommandList::push(CommandType type, const T& payload, std::string_view name)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            assert(name.size() <= std::numeric_limits<uint16_t>::max());
+
+            const CommandHeader header {
+                .type        = type,
+                .nameLength  = static_cast<uint16_t>(name.size()),
+                .payloadSize = static_cast<uint32_t>(sizeof(T)),
+            };
+
+            const auto offset = m_Stream.size();
+            m_Stream.resize(offset + sizeof(CommandHeader) + sizeof(T) + name.size());
+
+            auto* dst = m_Stream.data() + offset;
+            memcpy(dst, &header, sizeof(CommandHeader));
+            memcpy(dst + sizeof(CommandHeader), &payload, sizeof(T));
+            if (!name.empty())
+                memcpy(dst + sizeof(CommandHeader) + sizeof(T), name.data(), name.size());
+
+            ++m_NumCommands;
+            return *this;
+        }
+
+        CommandList& CommandList::setViewport(const Rect2D& rect) { return push(CommandType::eSetViewport, rect); }
+        CommandList& CommandList::setScissor(const Rect2D& rect) { return push(CommandType::eSetScissor, rect); }
+
+        CommandList& CommandList::bindGraphicsPipeline(const GraphicsPipeline& gp)
+        {
+            return push(CommandType::eBindGraphicsPipeline, gp);
+        }
+
+        CommandList& CommandList::bindImage(GLuint unit, const Texture& texture, GLint mipLevel, GLenum access)
+        {
+            assert(texture);
+            return push(CommandType::eBindImage,
+                        command::BindImage {
+                            .unit     = unit,
+                            .texture  = &texture,
+                            .mipLevel = mipLevel,
+                            .access   = access,
+                        });
+        }
+
+        CommandList& CommandList::bindTexture(GLuint unit, const Texture& texture, std::optional<GLuint> samplerId)
+        {
+            assert(texture);
+            return push(CommandType::eBindTexture,
+                        command::BindTexture {
+                            .unit       = unit,
+                            .texture    = &texture,
+                            .hasSampler = samplerId.has_value(),
+                            .samplerId  = samplerId.value_or(GL_NONE),
+                        });
+        }
+
+        CommandList& CommandList::bindUniformBuffer(GLuint index, const UniformBuffer& buffer)
+        {
+            assert(buffer);
+            return push(CommandType::eBindUniformBuffer, command::BindBuffer {.index = index, .buffer = &buffer});
+        }
+
+        CommandList& CommandList::bindStorageBuffer(GLuint index, const StorageBuffer& buffer)
+        {
+            assert(buffer);
+            return push(CommandType::eBindStorageBuffer, command::BindBuffer {.index = index, .buffer = &buffer});
+        }
+
+        CommandList& CommandList::bindMeshPrimitiveMaterialBuffer(GLuint                         index,
+                                                                  const resource::MeshPrimitive& meshPrimitive)
+        {
+            return push(CommandType::eBindMeshPrimitiveMaterialBuffer,
+                        command::BindMeshPrimitive {
+                            .unit          = index,
+                            .meshPrimitive = &meshPrimitive,
+                            .hasSampler    = false,
+                            .samplerId     = GL_NONE,
+                        });
+        }
+
+        CommandList& CommandList::bindMeshPrimitiveTextures(GLuint                         startUnit,
+                                                            const resource::MeshPrimitive& meshPrimitive,
+                                                            std::optional<GLuint>          samplerId)
+        {
+            return push(CommandType::eBindMeshPrimitiveTextures,
+                        command::BindMeshPrimitive {
+                            .unit          = startUnit,
+                            .meshPrimitive = &meshPrimitive,
+                            .hasSampler    = samplerId.has_value(),
+                            .samplerId     = samplerId.value_or(GL_NONE),
+                        });
+        }
+
+        CommandList& CommandList::setUniform1f(std::string_view name, float f)
+        {
+            return push(CommandType::eSetUniform1f, f, name);
+        }
+
+        CommandList& CommandList::setUniform1i(std::string_view name, int32_t i)
+        {
+            return push(CommandType::eSetUniform1i, i, name);
         }
 
-        void* RenderContext::map(Buffer& buffer)
+        CommandList& CommandList::setUniform1ui(std::string_view name, uint32_t i)
         {
-            assert(buffer);
-
-            if (!buffer.isMapped())
-                buffer.m_MappedMemory = glMapNamedBuffer(buffer.m_Id, GL_WRITE_ONLY);
+            return push(CommandType::eSetUniform1ui, i, name);
+        }
 
-            return buffer.m_MappedMemory;
+        CommandList& CommandList::setUniformVec2(std::string_view name, const glm::vec2& v)
+        {
+            return push(CommandType::eSetUniformVec2, v, name);
         }
 
-        RenderContext& RenderContext::unmap(Buffer& buffer)
+        CommandList& CommandList::setUniformVec3(std::string_view name, const glm::vec3& v)
         {
-            assert(buffer);
+            return push(CommandType::eSetUniformVec3, v, name);
+        }
 
-            if (buffer.isMapped())
-            {
-                glUnmapNamedBuffer(buffer.m_Id);
-                buffer.m_MappedMemory = nullptr;
-            }
+        CommandList& CommandList::setUniformVec4(std::string_view name, const glm::vec4& v)
+        {
+            return push(CommandType::eSetUniformVec4, v, name);
+        }
 
-            return *this;
+        CommandList& CommandList::setUniformMat3(std::string_view name, const glm::mat3& m)
+        {
+            return push(CommandType::eSetUniformMat3, m, name);
         }
 
-        RenderContext& RenderContext::destroy(Buffer& buffer)
+        CommandList& CommandList::setUniformMat4(std::string_view name, const glm::mat4& m)
         {
-            if (buffer)
-            {
-                glDeleteBuffers(1, &buffer.m_Id);
-                buffer = {};
-            }
+            return push(CommandType::eSetUniformMat4, m, name);
+        }
 
-            return *this;
+        CommandList& CommandList::dispatch(GLuint computeProgram, const glm::uvec3& numGroups)
+        {
+            return push(CommandType::eDispatch,
+                        command::Dispatch {.computeProgram = computeProgram, .numGroups = numGroups});
         }
 
-        RenderContext& RenderContext::destroy(Texture& texture)
+        CommandList& CommandList::drawFullScreenTriangle()
         {
-            if (texture)
-            {
-                glDeleteTextures(1, &texture.m_Id);
-                if (texture.m_View != GL_NONE)
-                    glDeleteTextures(1, &texture.m_View);
-                texture = {};
-            }
-            return *this;
+            return draw({},
+                        {},
+                        {
+                            .topology    = PrimitiveTopology::eTriangleList,
+                            .numVertices = 3,
+                        });
         }
 
-        RenderContext& RenderContext::destroy(GraphicsPipeline& gp)
+        CommandList& CommandList::drawCube()
         {
-            if (gp.m_Program != GL_NONE)
-            {
-                glDeleteProgram(gp.m_Program);
-                gp.m_Program = GL_NONE;
-            }
-            gp.m_VAO = GL_NONE;
+            return draw({},
+                        {},
+                        {
+                            .topology    = PrimitiveTopology::eTriangleList,
+                            .numVertices = 36,
+                        });
+        }
 
-            return *this;
+        CommandList& CommandList::draw(OptionalReference<const VertexBuffer> vertexBuffer,
+                                       OptionalReference<const IndexBuffer>  indexBuffer,
+                                       const GeometryInfo&                   geometryInfo,
+                                       uint32_t                              numInstances)
+        {
+            return push(CommandType::eDraw,
+                        command::Draw {
+                            .vertexBuffer = vertexBuffer.has_value() ? &vertexBuffer->get() : nullptr,
+                            .indexBuffer  = indexBuffer.has_value() ? &indexBuffer->get() : nullptr,
+                            .geometryInfo = geometryInfo,
+                            .numInstances = numInstances,
+                        });
         }
 
-        RenderContext& RenderContext::dispatch(GLuint computeProgram, const glm::uvec3& numGroups)
+        CommandList& CommandList::drawMeshPrimitive(const resource::MeshPrimitive& meshPrimitive)
         {
-            setShaderProgram(computeProgram);
-            glDispatchCompute(numGroups.x, numGroups.y, numGroups.z);
-
-            return *this;
+            return push(CommandType::eDrawMeshPrimitive, &meshPrimitive);
         }
 
-        GLuint RenderContext::beginRendering(const RenderingInfo& renderingInfo)
+        void CommandList::reset()
         {
-            assert(!m_RenderingStarted);
+            m_Stream.clear();
+            m_NumCommands = 0;
+        }
 
-            GLuint framebuffer;
-            glCreateFramebuffers(1, &framebuffer);
-            if (renderingInfo.depthAttachment.has_value())
+        void CommandList::reserve(std::size_t numBytes) { m_Stream.reserve(numBytes); }
+
+        bool        CommandList::empty() const { return m_NumCommands == 0; }
+        uint32_t    CommandList::getNumCommands() const { return m_NumCommands; }
+        std::size_t CommandList::getSize() const { return m_Stream.size(); }
+
+        namespace trace
+        {
+            struct BufferRecord
             {
-                attachTexture(framebuffer, GL_DEPTH_ATTACHMENT, *renderingInfo.depthAttachment);
-            }
-            for (size_t i {0}; i < renderingInfo.colorAttachments.size(); ++i)
+                uint32_t        handle;
+                TraceBufferKind kind;
+                uint32_t        strideOrIndexType;
+                uint64_t        size;
+            };
+            struct TextureRecord
             {
-                attachTexture(framebuffer, GL_COLOR_ATTACHMENT0 + i, renderingInfo.colorAttachments[i]);
-            }
-            if (const auto n = renderingInfo.colorAttachments.size(); n > 0)
+                uint32_t    handle;
+                GLenum      type;
+                PixelFormat pixelFormat;
+                Extent2D    extent;
+                uint32_t    depth;
+                uint32_t    numMipLevels;
+                uint32_t    numLayers;
+                SamplerInfo samplerInfo;
+                // Pixel transfer format of the mip level data that follows
+                GLenum format;
+                GLenum dataType;
+            };
+            struct PipelineRecord
             {
-                std::vector<GLenum> colorBuffers(n);
-                std::iota(colorBuffers.begin(), colorBuffers.end(), GL_COLOR_ATTACHMENT0);
-                glNamedFramebufferDrawBuffers(framebuffer, colorBuffers.size(), colorBuffers.data());
-            }
-#ifdef _DEBUG
-            const auto status = glCheckNamedFramebufferStatus(framebuffer, GL_DRAW_FRAMEBUFFER);
-            assert(GL_FRAMEBUFFER_COMPLETE == status);
-#endif
+                uint32_t                                   program;
+                uint32_t                                   vao;
+                DepthStencilState                          depthStencilState;
+                RasterizerState                            rasterizerState;
+                std::array<BlendState, kMaxNumBlendStates> blendStates;
+            };
+            struct BindImage
+            {
+                uint32_t unit;
+                uint32_t texture;
+                GLint    mipLevel;
+                GLenum   access;
+            };
+            struct BindTexture
+            {
+                uint32_t unit;
+                uint32_t texture;
+                bool     hasSampler;
+                uint32_t sampler;
+            };
+            struct BindBuffer
+            {
+                uint32_t index;
+                uint32_t buffer;
+            };
+            struct Dispatch
+            {
+                uint32_t   program;
+                glm::uvec3 numGroups;
+            };
+            struct Draw
+            {
+                uint32_t     vertexBuffer;
+                uint32_t     indexBuffer;
+                GeometryInfo geometryInfo;
+                uint32_t     numInstances;
+            };
+            struct Attachment
+            {
+                enum class Clear : uint8_t
+                {
+                    eNone = 0,
+                    eColor,
+                    eDepth,
+                };
 
-            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
-            setViewport(renderingInfo.area);
-            setScissorTest(false);
+                uint32_t  texture;
+                uint32_t  mipLevel;
+                int32_t   layer; // Negative if not set
+                int32_t   face;  // Negative if not set
+                Clear     clear;
+                glm::vec4 clearValue;
+            };
+            struct DefaultRendering
+            {
+                Rect2D    area;
+                bool      hasClearColor;
+                bool      hasClearDepth;
+                bool      hasClearStencil;
+                glm::vec4 clearColor;
+                float     clearDepth;
+                int32_t   clearStencil;
+            };
+            struct UploadBuffer
+            {
+                uint32_t buffer;
+                int64_t  offset;
+                int64_t  size;
+            };
+            struct UploadTexture
+            {
+                uint32_t   texture;
+                GLint      mipLevel;
+                glm::uvec3 dimensions;
+                GLint      face;
+                GLsizei    layer;
+                GLenum     format;
+                GLenum     dataType;
+                uint64_t   size;
+            };
+            struct SetupSampler
+            {
+                uint32_t    texture;
+                SamplerInfo samplerInfo;
+            };
 
-            if (renderingInfo.depthAttachment.has_value())
-                if (renderingInfo.depthAttachment->clearValue.has_value())
-                {
-                    setDepthWrite(true);
+            // {type u8, payload size u32}
+            constexpr std::size_t kRecordHeaderSize = sizeof(TraceRecordType) + sizeof(uint32_t);
+            // {magic, version, numFrames, width, height}
+            constexpr std::size_t kFileHeaderSize = 5 * sizeof(uint32_t);
 
-                    const auto clearValue = std::get<float>(*renderingInfo.depthAttachment->clearValue);
-                    glClearNamedFramebufferfv(framebuffer, GL_DEPTH, 0, &clearValue);
-                }
-            for (int32_t i {0}; const auto& attachment : renderingInfo.colorAttachments)
+            class Reader
             {
-                if (attachment.clearValue.has_value())
+            public:
+                Reader(const std::byte* data, std::size_t size) : m_It(data), m_End(data + size) {}
+
+                template<typename T>
+                T read()
                 {
-                    const auto& clearValue = std::get<glm::vec4>(*attachment.clearValue);
-                    glClearNamedFramebufferfv(framebuffer, GL_COLOR, i, glm::value_ptr(clearValue));
+                    return command::read<T>(readBytes(sizeof(T)));
                 }
-                ++i;
-            }
 
-            m_RenderingStarted = true;
+                const std::byte* readBytes(std::size_t size)
+                {
+                    assert(m_It + size <= m_End);
+                    return std::exchange(m_It, m_It + size);
+                }
 
-            return framebuffer;
-        }
+                std::string readString()
+                {
+                    const auto size = read<uint32_t>();
+                    return {reinterpret_cast<const char*>(readBytes(size)), size};
+                }
 
-        RenderContext& RenderContext::beginRendering(const Rect2D&            area,
-                                                     std::optional<glm::vec4> clearColor,
-                                                     std::optional<float>     clearDepth,
-                                                     std::optional<int>       clearStencil)
-        {
-            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, GL_NONE);
-            setViewport(area);
-            setScissorTest(false);
+            private:
+                const std::byte* m_It;
+                const std::byte* m_End;
+            };
 
-            if (clearDepth.has_value())
-            {
-                setDepthWrite(true);
-                glClearNamedFramebufferfv(GL_NONE, GL_DEPTH, 0, &clearDepth.value());
-            }
-            if (clearStencil.has_value())
-                glClearNamedFramebufferiv(GL_NONE, GL_STENCIL, 0, &clearStencil.value());
-            if (clearColor.has_value())
+            // Format used to read back (and restore) the contents of a texture
+            ImageData getTransferFormat(PixelFormat pixelFormat)
             {
-                glClearNamedFramebufferfv(GL_NONE, GL_COLOR, 0, glm::value_ptr(clearColor.value()));
+                switch (pixelFormat)
+                {
+                    using enum PixelFormat;
+                    case eR8_UNorm:
+                        return {GL_RED, GL_UNSIGNED_BYTE};
+                    case eR32I:
+                        return {GL_RED_INTEGER, GL_INT};
+                    case eRGB8_UNorm:
+                        return {GL_RGB, GL_UNSIGNED_BYTE};
+                    case eRGBA8_UNorm:
+                        return {GL_RGBA, GL_UNSIGNED_BYTE};
+                    case eRGB8_SNorm:
+                        return {GL_RGB, GL_BYTE};
+                    case eRGBA8_SNorm:
+                        return {GL_RGBA, GL_BYTE};
+                    case eR16F:
+                        return {GL_RED, GL_HALF_FLOAT};
+                    case eRG16F:
+                        return {GL_RG, GL_HALF_FLOAT};
+                    case eRGB16F:
+                        return {GL_RGB, GL_HALF_FLOAT};
+                    case eRGBA16F:
+                        return {GL_RGBA, GL_HALF_FLOAT};
+                    case eRGB32F:
+                        return {GL_RGB, GL_FLOAT};
+                    case eRGBA32F:
+                        return {GL_RGBA, GL_FLOAT};
+                    case eRGBA32UI:
+                        return {GL_RGBA_INTEGER, GL_UNSIGNED_INT};
+                    case eDepth16:
+                        return {GL_DEPTH_COMPONENT, GL_UNSIGNED_SHORT};
+                    case eDepth24:
+                        return {GL_DEPTH_COMPONENT, GL_UNSIGNED_INT};
+                    case eDepth32F:
+                        return {GL_DEPTH_COMPONENT, GL_FLOAT};
+                    default:
+                        return {};
+                }
             }
 
-            return *this;
-        }
+            // @return Size of a mip level, z = depth (3D) or number of layer-faces
+            glm::uvec3 getLevelSize(const TextureRecord& record, uint32_t level)
+            {
+                uint32_t numSlices {1};
+                switch (record.type)
+                {
+                    case GL_TEXTURE_3D:
+                        numSlices = record.depth;
+                        break;
+                    case GL_TEXTURE_2D_ARRAY:
+                        numSlices = record.numLayers;
+                        break;
+                    case GL_TEXTURE_CUBE_MAP:
+                        numSlices = 6;
+                        break;
+                    case GL_TEXTURE_CUBE_MAP_ARRAY:
+                        numSlices = 6 * record.numLayers;
+                        break;
+                }
 
-        RenderContext& RenderContext::endRendering(GLuint frameBufferID)
-        {
-            assert(m_RenderingStarted && frameBufferID != GL_NONE);
+                auto size = glm::max(calcMipSize({record.extent.width, record.extent.height, numSlices}, level),
+                                     glm::uvec3 {1u});
+                if (record.type != GL_TEXTURE_3D)
+                    size.z = numSlices;
+                return size;
+            }
 
-            glDeleteFramebuffers(1, &frameBufferID);
-            m_RenderingStarted = false;
+            // Inverse of RenderContext::setupSampler
+            SamplerInfo getSamplerInfo(GLuint texture)
+            {
+                GLint minFilter {GL_NONE}, magFilter {GL_NONE}, compareMode {GL_NONE}, compareFunc {GL_NONE};
+                GLint wrap[3] {};
+
+                glGetTextureParameteriv(texture, GL_TEXTURE_MIN_FILTER, &minFilter);
+                glGetTextureParameteriv(texture, GL_TEXTURE_MAG_FILTER, &magFilter);
+                glGetTextureParameteriv(texture, GL_TEXTURE_WRAP_S, &wrap[0]);
+                glGetTextureParameteriv(texture, GL_TEXTURE_WRAP_T, &wrap[1]);
+                glGetTextureParameteriv(texture, GL_TEXTURE_WRAP_R, &wrap[2]);
+                glGetTextureParameteriv(texture, GL_TEXTURE_COMPARE_MODE, &compareMode);
+                glGetTextureParameteriv(texture, GL_TEXTURE_COMPARE_FUNC, &compareFunc);
+
+                SamplerInfo info {
+                    .magFilter    = static_cast<TexelFilter>(magFilter),
+                    .addressModeS = static_cast<SamplerAddressMode>(wrap[0]),
+                    .addressModeT = static_cast<SamplerAddressMode>(wrap[1]),
+                    .addressModeR = static_cast<SamplerAddressMode>(wrap[2]),
+                };
+                glGetTextureParameterfv(texture, GL_TEXTURE_MAX_ANISOTROPY, &info.maxAnisotropy);
+                glGetTextureParameterfv(texture, GL_TEXTURE_BORDER_COLOR, glm::value_ptr(info.borderColor));
 
-            return *this;
-        }
+                switch (minFilter)
+                {
+                    case GL_NEAREST:
+                    case GL_NEAREST_MIPMAP_NEAREST:
+                    case GL_NEAREST_MIPMAP_LINEAR:
+                        info.minFilter = TexelFilter::eNearest;
+                        break;
+                    default:
+                        info.minFilter = TexelFilter::eLinear;
+                }
+                switch (minFilter)
+                {
+                    case GL_NEAREST:
+                    case GL_LINEAR:
+                        info.mipmapMode = MipmapMode::eNone;
+                        break;
+                    case GL_NEAREST_MIPMAP_NEAREST:
+                    case GL_LINEAR_MIPMAP_NEAREST:
+                        info.mipmapMode = MipmapMode::eNearest;
+                        break;
+                    default:
+                        info.mipmapMode = MipmapMode::eLinear;
+                }
+                if (compareMode == GL_COMPARE_REF_TO_TEXTURE)
+                    info.compareOperator = static_cast<CompareOp>(compareFunc);
 
-        RenderContext& RenderContext::bindGraphicsPipeline(const GraphicsPipeline& gp)
-        {
-            {
-                const auto& state = gp.m_DepthStencilState;
-                setDepthTest(state.depthTest, state.depthCompareOp);
-                setDepthWrite(state.depthWrite);
+                return info;
             }
 
+            GLuint findOrNone(const std::unordered_map<uint32_t, GLuint>& objects, uint32_t handle)
             {
-                const auto& state = gp.m_RasterizerState;
-                setPolygonMode(state.polygonMode);
-                setCullMode(state.cullMode);
-                setPolygonOffset(state.polygonOffset);
-                setDepthClamp(state.depthClampEnable);
-                setScissorTest(state.scissorTest);
+                const auto it = objects.find(handle);
+                return it != objects.cend() ? it->second : GL_NONE;
             }
+        } // namespace trace
 
-            for (int32_t i {0}; i < gp.m_BlendStates.size(); ++i)
-                setBlendState(i, gp.m_BlendStates[i]);
-
-            setVertexArray(gp.m_VAO);
-            setShaderProgram(gp.m_Program);
-
-            return *this;
-        }
-
-        RenderContext& RenderContext::setUniform1f(const std::string& name, float f)
-        {
-            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
-            if (location != GL_INVALID_INDEX)
-                glProgramUniform1f(m_CurrentPipeline.m_Program, location, f);
-            return *this;
-        }
-
-        RenderContext& RenderContext::setUniform1i(const std::string& name, int32_t i)
+        bool TraceCapture::capture([[maybe_unused]] const std::filesystem::path& filePath,
+                                   [[maybe_unused]] uint32_t                     numFrames)
         {
-            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
-            if (location != GL_INVALID_INDEX)
-                glProgramUniform1i(m_CurrentPipeline.m_Program, location, i);
-            return *this;
-        }
+#ifdef VGFW_ENABLE_TRACE_CAPTURE
+            if (m_Active || m_NumPendingFrames > 0 || numFrames == 0)
+                return false;
 
-        RenderContext& RenderContext::setUniform1ui(const std::string& name, uint32_t i)
-        {
-            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
-            if (location != GL_INVALID_INDEX)
-                glProgramUniform1ui(m_CurrentPipeline.m_Program, location, i);
-            return *this;
+            m_FilePath         = filePath;
+            m_NumPendingFrames = numFrames;
+            return true;
+#else
+            VGFW_ERROR("[TraceCapture] Define VGFW_ENABLE_TRACE_CAPTURE to capture traces: {0} ({1} frames)",
+                       filePath.generic_string(),
+                       numFrames);
+            return false;
+#endif
         }
 
-        RenderContext& RenderContext::setUniformVec2(const std::string& name, const glm::vec2& v)
+        void TraceCapture::onPresent()
         {
-            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
-            if (location != GL_INVALID_INDEX)
+            if (m_Active)
             {
-                glProgramUniform2fv(m_CurrentPipeline.m_Program, location, 1, glm::value_ptr(v));
+                endRecord(beginRecord(TraceRecordType::eEndFrame));
+                ++m_NumFrames;
+                if (--m_NumPendingFrames == 0)
+                    finish();
             }
-            return *this;
-        }
-
-        RenderContext& RenderContext::setUniformVec3(const std::string& name, const glm::vec3& v)
-        {
-            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
-            if (location != GL_INVALID_INDEX)
+            else if (m_NumPendingFrames > 0)
             {
-                glProgramUniform3fv(m_CurrentPipeline.m_Program, location, 1, glm::value_ptr(v));
+                const auto window = g_GraphicsContext.getWindow();
+                m_Extent          = {window->getWidth(), window->getHeight()};
+                m_NumFrames       = 0;
+                m_NextHandle      = 1;
+                m_Active          = true;
+                VGFW_INFO("[TraceCapture] Capturing {0} frames: {1}", m_NumPendingFrames, m_FilePath.generic_string());
             }
-            return *this;
         }
 
-        RenderContext& RenderContext::setUniformVec4(const std::string& name, const glm::vec4& v)
+        void TraceCapture::finish()
         {
-            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
-            if (location != GL_INVALID_INDEX)
-            {
-                glProgramUniform4fv(m_CurrentPipeline.m_Program, location, 1, glm::value_ptr(v));
-            }
-            return *this;
-        }
+            m_Active = false;
 
-        RenderContext& RenderContext::setUniformMat3(const std::string& name, const glm::mat3& m)
-        {
-            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
-            if (location != GL_INVALID_INDEX)
-            {
-                glProgramUniformMatrix3fv(m_CurrentPipeline.m_Program, location, 1, GL_FALSE, glm::value_ptr(m));
-            }
-            return *this;
+            const std::array<uint32_t, 5> header {kMagic, kVersion, m_NumFrames, m_Extent.width, m_Extent.height};
+            static_assert(sizeof(header) == trace::kFileHeaderSize);
+
+            std::string file(sizeof(header) + m_Stream.size(), '\0');
+            memcpy(file.data(), header.data(), sizeof(header));
+            memcpy(file.data() + sizeof(header), m_Stream.data(), m_Stream.size());
+
+            if (utils::writeFileAllText(m_FilePath, file))
+                VGFW_INFO("[TraceCapture] Wrote trace ({0} frames, {1} bytes): {2}",
+                          m_NumFrames,
+                          file.size(),
+                          m_FilePath.generic_string());
+
+            m_Buffers.clear();
+            m_Textures.clear();
+            m_Programs.clear();
+            m_Samplers.clear();
+            m_VertexArrays.clear();
+            m_Stream = {};
         }
 
-        RenderContext& RenderContext::setUniformMat4(const std::string& name, const glm::mat4& m)
-        {
-            const auto location = glGetUniformLocation(m_CurrentPipeline.m_Program, name.data());
-            if (location != GL_INVALID_INDEX)
-            {
-                glProgramUniformMatrix4fv(m_CurrentPipeline.m_Program, location, 1, GL_FALSE, glm::value_ptr(m));
-            }
-            return *this;
+        void TraceCapture::onCreateGraphicsProgram(GLuint                            program,
+                                                   const std::string&                vertSource,
+                                                   const std::string&                fragSource,
+                                                   const std::optional<std::string>& geomSource)
+        {
+            auto& sources = m_ProgramSources[program];
+            sources       = {{GL_VERTEX_SHADER, vertSource}, {GL_FRAGMENT_SHADER, fragSource}};
+            if (geomSource)
+                sources.emplace_back(GL_GEOMETRY_SHADER, *geomSource);
         }
 
-        RenderContext& RenderContext::bindImage(GLuint unit, const Texture& texture, GLint mipLevel, GLenum access)
+        void TraceCapture::onCreateComputeProgram(GLuint program, const std::string& compSource)
         {
-            assert(texture && mipLevel < texture.m_NumMipLevels);
-            glBindImageTexture(
-                unit, texture.m_Id, mipLevel, GL_FALSE, 0, access, static_cast<GLenum>(texture.m_PixelFormat));
-            return *this;
+            m_ProgramSources[program] = {{GL_COMPUTE_SHADER, compSource}};
         }
 
-        RenderContext& RenderContext::bindTexture(GLuint unit, const Texture& texture, std::optional<GLuint> samplerId)
+        void TraceCapture::onCreateSampler(GLuint sampler, const SamplerInfo& samplerInfo)
         {
-            assert(texture);
-            glBindTextureUnit(unit, texture.m_Id);
-            if (samplerId.has_value())
-                glBindSampler(unit, *samplerId);
-            return *this;
+            m_SamplerInfos[sampler] = samplerInfo;
         }
 
-        RenderContext& RenderContext::bindUniformBuffer(GLuint index, const UniformBuffer& buffer)
+        void TraceCapture::onCreateVertexArray(GLuint vao, const VertexAttributes& attributes)
         {
-            assert(buffer);
-            glBindBufferBase(GL_UNIFORM_BUFFER, index, buffer.m_Id);
-            return *this;
+            m_VertexLayouts[vao] = attributes;
         }
 
-        RenderContext& RenderContext::bindStorageBuffer(GLuint index, const StorageBuffer& buffer)
+        void TraceCapture::onDestroyProgram(GLuint program)
         {
-            assert(buffer);
-            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index, buffer.m_Id);
-            return *this;
+            m_ProgramSources.erase(program);
+            m_Programs.erase(program);
         }
 
-        RenderContext& RenderContext::bindMeshPrimitiveMaterialBuffer(GLuint                         index,
-                                                                      const resource::MeshPrimitive& meshPrimitive)
+        // GL names get recycled, the next object with the same name is snapshotted again
+        void TraceCapture::onDestroy(const Buffer& buffer) { m_Buffers.erase(buffer.m_Id); }
+        void TraceCapture::onDestroy(const Texture& texture) { m_Textures.erase(texture.m_Id); }
+
+        void TraceCapture::onSetViewport(const Rect2D& rect)
         {
-            return bindUniformBuffer(index, *meshPrimitive.materialBuffer);
+            if (!m_Active)
+                return;
+
+            const auto record = beginRecord(TraceRecordType::eSetViewport);
+            write(rect);
+            endRecord(record);
         }
 
-        RenderContext& RenderContext::bindMeshPrimitiveTextures(GLuint                         startUnit,
-                                                                const resource::MeshPrimitive& meshPrimitive,
-                                                                std::optional<GLuint>          samplerId)
+        void TraceCapture::onSetScissor(const Rect2D& rect)
         {
-            meshPrimitive.ownerModel->bindMeshPrimitiveTextures(
-                meshPrimitive.indexInOwnerModel, startUnit, *this, samplerId);
-            return *this;
+            if (!m_Active)
+                return;
+
+            const auto record = beginRecord(TraceRecordType::eSetScissor);
+            write(rect);
+            endRecord(record);
         }
 
-        RenderContext& RenderContext::drawFullScreenTriangle()
+        void TraceCapture::onBindGraphicsPipeline(const GraphicsPipeline& gp)
         {
-            return draw({},
-                        {},
-                        {
-                            .topology    = PrimitiveTopology::eTriangleList,
-                            .numVertices = 3,
-                        });
+            if (!m_Active)
+                return;
+
+            const trace::PipelineRecord pipeline {
+                .program           = refProgram(gp.m_Program),
+                .vao               = refVertexArray(gp.m_VAO),
+                .depthStencilState = gp.m_DepthStencilState,
+                .rasterizerState   = gp.m_RasterizerState,
+                .blendStates       = gp.m_BlendStates,
+            };
+
+            const auto record = beginRecord(TraceRecordType::eBindGraphicsPipeline);
+            write(pipeline);
+            endRecord(record);
         }
 
-        RenderContext& RenderContext::drawCube()
+        void TraceCapture::onBindImage(GLuint unit, const Texture& texture, GLint mipLevel, GLenum access)
         {
-            return draw({},
-                        {},
-                        {
-                            .topology    = PrimitiveTopology::eTriangleList,
-                            .numVertices = 36,
-                        });
+            if (!m_Active)
+                return;
+
+            const trace::BindImage bindImage {
+                .unit = unit, .texture = refTexture(texture), .mipLevel = mipLevel, .access = access};
+
+            const auto record = beginRecord(TraceRecordType::eBindImage);
+            write(bindImage);
+            endRecord(record);
         }
 
-        RenderContext& RenderContext::draw(OptionalReference<const VertexBuffer> vertexBuffer,
-                                           OptionalReference<const IndexBuffer>  indexBuffer,
-                                           const GeometryInfo&                   geometryInfo,
-                                           uint32_t                              numInstances)
+        void TraceCapture::onBindTexture(GLuint unit, const Texture& texture, std::optional<GLuint> samplerId)
         {
-            VGFW_PROFILE_FUNCTION
-            if (vertexBuffer.has_value())
-                setVertexBuffer(*vertexBuffer);
+            if (!m_Active)
+                return;
 
-            if (geometryInfo.numIndices > 0)
-            {
-                assert(indexBuffer.has_value());
-                setIndexBuffer(*indexBuffer);
+            const trace::BindTexture bindTexture {
+                .unit       = unit,
+                .texture    = refTexture(texture),
+                .hasSampler = samplerId.has_value(),
+                .sampler    = samplerId ? refSampler(*samplerId) : 0,
+            };
 
-                const auto stride = static_cast<GLsizei>(indexBuffer->get().getIndexType());
-                const auto indices =
-                    reinterpret_cast<const void*>(static_cast<uint64_t>(stride) * geometryInfo.indexOffset);
+            const auto record = beginRecord(TraceRecordType::eBindTexture);
+            write(bindTexture);
+            endRecord(record);
+        }
 
-                glDrawElementsInstancedBaseVertex(static_cast<GLenum>(geometryInfo.topology),
-                                                  geometryInfo.numIndices,
-                                                  getIndexDataType(stride),
-                                                  indices,
-                                                  numInstances,
-                                                  geometryInfo.vertexOffset);
-            }
-            else
-            {
-                glDrawArraysInstanced(static_cast<GLenum>(geometryInfo.topology),
-                                      geometryInfo.vertexOffset,
-                                      geometryInfo.numVertices,
-                                      numInstances);
-            }
-            return *this;
+        void TraceCapture::onBindBuffer(TraceRecordType type, GLuint index, const Buffer& buffer)
+        {
+            if (!m_Active)
+                return;
+
+            const trace::BindBuffer bindBuffer {.index = index, .buffer = refBuffer(buffer)};
+
+            const auto record = beginRecord(type);
+            write(bindBuffer);
+            endRecord(record);
         }
 
-        RenderContext& RenderContext::drawMeshPrimitive(const resource::MeshPrimitive& meshPrimitive)
+        void TraceCapture::onSetUniform(CommandType type, const std::string& name, const void* value, uint32_t size)
         {
-            VGFW_PROFILE_FUNCTION
-            meshPrimitive.draw(*this);
-            return *this;
+            if (!m_Active)
+                return;
+
+            const auto record = beginRecord(TraceRecordType::eSetUniform);
+            write(type);
+            writeString(name);
+            writeBytes(value, size);
+            endRecord(record);
         }
 
-        GLuint RenderContext::createVertexArray(const VertexAttributes& attributes)
+        void TraceCapture::onDispatch(GLuint computeProgram, const glm::uvec3& numGroups)
         {
-            GLuint vao;
-            glCreateVertexArrays(1, &vao);
+            if (!m_Active)
+                return;
 
-            for (const auto& [location, attribute] : attributes)
-            {
-                const auto [type, size, normalized] = statAttribute(attribute.vertType);
-                assert(type != GL_INVALID_INDEX);
+            const trace::Dispatch dispatch {.program = refProgram(computeProgram), .numGroups = numGroups};
 
-                glEnableVertexArrayAttrib(vao, location);
-                if (attribute.vertType == VertexAttribute::Type::eInt4)
-                {
-                    glVertexArrayAttribIFormat(vao, location, size, type, attribute.offset);
-                }
-                else
-                {
-                    glVertexArrayAttribFormat(vao, location, size, type, normalized, attribute.offset);
-                }
-                glVertexArrayAttribBinding(vao, location, 0);
-            }
-            return vao;
+            const auto record = beginRecord(TraceRecordType::eDispatch);
+            write(dispatch);
+            endRecord(record);
         }
 
-        Texture RenderContext::createImmutableTexture(Extent2D    extent,
-                                                      uint32_t    depth,
-                                                      PixelFormat pixelFormat,
-                                                      uint32_t    numFaces,
-                                                      uint32_t    numMipLevels,
-                                                      uint32_t    numLayers)
+        void TraceCapture::onDraw(const VertexBuffer*  vertexBuffer,
+                                  const IndexBuffer*   indexBuffer,
+                                  const GeometryInfo& geometryInfo,
+                                  uint32_t            numInstances)
         {
-            assert(numMipLevels > 0);
+            if (!m_Active)
+                return;
 
-            // http://github.khronos.org/KTX-Specification/#_texture_type
+            const trace::Draw draw {
+                .vertexBuffer =
+                    vertexBuffer ? refBuffer(*vertexBuffer, TraceBufferKind::eVertexBuffer, vertexBuffer->getStride()) :
+                                   0,
+                .indexBuffer  = indexBuffer ? refBuffer(*indexBuffer,
+                                                       TraceBufferKind::eIndexBuffer,
+                                                       static_cast<uint32_t>(indexBuffer->getIndexType())) :
+                                              0,
+                .geometryInfo = geometryInfo,
+                .numInstances = numInstances,
+            };
 
-            GLenum target = numFaces == 6     ? GL_TEXTURE_CUBE_MAP :
-                            depth > 0         ? GL_TEXTURE_3D :
-                            extent.height > 0 ? GL_TEXTURE_2D :
-                                                GL_TEXTURE_1D;
-            assert(target == GL_TEXTURE_CUBE_MAP ? extent.width == extent.height : true);
+            const auto record = beginRecord(TraceRecordType::eDraw);
+            write(draw);
+            endRecord(record);
+        }
 
-            if (numLayers > 0)
-            {
-                switch (target)
-                {
-                    case GL_TEXTURE_1D:
-                        target = GL_TEXTURE_1D_ARRAY;
-                        break;
-                    case GL_TEXTURE_2D:
-                        target = GL_TEXTURE_2D_ARRAY;
-                        break;
-                    case GL_TEXTURE_CUBE_MAP:
-                        target = GL_TEXTURE_CUBE_MAP_ARRAY;
-                        break;
+        void TraceCapture::onBeginRendering(const Rect2D&                        area,
+                                            std::span<const AttachmentInfo>      colorAttachments,
+                                            const std::optional<AttachmentInfo>& depthAttachment)
+        {
+            if (!m_Active)
+                return;
 
-                    default:
-                        assert(false);
+            const auto toAttachment = [this](const AttachmentInfo& info) {
+                trace::Attachment attachment {
+                    .texture    = refTexture(info.image),
+                    .mipLevel   = info.mipLevel,
+                    .layer      = info.layer ? static_cast<int32_t>(*info.layer) : -1,
+                    .face       = info.face ? static_cast<int32_t>(*info.face) : -1,
+                    .clear      = trace::Attachment::Clear::eNone,
+                    .clearValue = glm::vec4 {0.0f},
+                };
+                if (info.clearValue)
+                {
+                    if (const auto* color = std::get_if<glm::vec4>(&*info.clearValue))
+                    {
+                        attachment.clear      = trace::Attachment::Clear::eColor;
+                        attachment.clearValue = *color;
+                    }
+                    else
+                    {
+                        attachment.clear      = trace::Attachment::Clear::eDepth;
+                        attachment.clearValue = glm::vec4 {std::get<float>(*info.clearValue)};
+                    }
                 }
-            }
+                return attachment;
+            };
 
-            GLuint id {GL_NONE};
-            glCreateTextures(target, 1, &id);
+            // Snapshot the attachments before the record starts
+            std::vector<trace::Attachment> attachments;
+            if (depthAttachment)
+                attachments.push_back(toAttachment(*depthAttachment));
+            for (const auto& colorAttachment : colorAttachments)
+                attachments.push_back(toAttachment(colorAttachment));
+
+            const auto record = beginRecord(TraceRecordType::eBeginRendering);
+            write(area);
+            write(depthAttachment.has_value());
+            write(static_cast<uint32_t>(colorAttachments.size()));
+            writeBytes(attachments.data(), attachments.size() * sizeof(trace::Attachment));
+            endRecord(record);
+        }
 
-            const auto internalFormat = static_cast<GLenum>(pixelFormat);
-            switch (target)
-            {
-                case GL_TEXTURE_1D:
-                    glTextureStorage1D(id, numMipLevels, internalFormat, extent.width);
-                    break;
-                case GL_TEXTURE_1D_ARRAY:
-                    glTextureStorage2D(id, numMipLevels, internalFormat, extent.width, numLayers);
-                    break;
+        void TraceCapture::onBeginRendering(const Rect2D&            area,
+                                            std::optional<glm::vec4> clearColor,
+                                            std::optional<float>     clearDepth,
+                                            std::optional<int>       clearStencil)
+        {
+            if (!m_Active)
+                return;
 
-                case GL_TEXTURE_2D:
-                    glTextureStorage2D(id, numMipLevels, internalFormat, extent.width, extent.height);
-                    break;
-                case GL_TEXTURE_2D_ARRAY:
-                    glTextureStorage3D(id, numMipLevels, internalFormat, extent.width, extent.height, numLayers);
-                    break;
+            const trace::DefaultRendering rendering {
+                .area            = area,
+                .hasClearColor   = clearColor.has_value(),
+                .hasClearDepth   = clearDepth.has_value(),
+                .hasClearStencil = clearStencil.has_value(),
+                .clearColor      = clearColor.value_or(glm::vec4 {0.0f}),
+                .clearDepth      = clearDepth.value_or(0.0f),
+                .clearStencil    = clearStencil.value_or(0),
+            };
 
-                case GL_TEXTURE_3D:
-                    glTextureStorage3D(id, numMipLevels, internalFormat, extent.width, extent.height, depth);
-                    break;
+            const auto record = beginRecord(TraceRecordType::eBeginDefaultRendering);
+            write(rendering);
+            endRecord(record);
+        }
 
-                case GL_TEXTURE_CUBE_MAP:
-                    glTextureStorage2D(id, numMipLevels, internalFormat, extent.width, extent.height);
-                    break;
-                case GL_TEXTURE_CUBE_MAP_ARRAY:
-                    glTextureStorage3D(id, numMipLevels, internalFormat, extent.width, extent.height, numLayers * 6);
-                    break;
-            }
+        void TraceCapture::onEndRendering()
+        {
+            if (m_Active)
+                endRecord(beginRecord(TraceRecordType::eEndRendering));
+        }
 
-            return Texture {
-                id,
-                target,
-                pixelFormat,
-                extent,
-                depth,
-                numMipLevels,
-                numLayers,
+        void TraceCapture::onUpload(const Buffer& buffer, GLintptr offset, GLsizeiptr size, const void* data)
+        {
+            if (!m_Active)
+                return;
+
+            const trace::UploadBuffer upload {.buffer = refBuffer(buffer), .offset = offset, .size = size};
+
+            const auto record = beginRecord(TraceRecordType::eUploadBuffer);
+            write(upload);
+            writeBytes(data, static_cast<std::size_t>(size));
+            endRecord(record);
+        }
+
+        void TraceCapture::onUpload(const Texture&    texture,
+                                    GLint             mipLevel,
+                                    const glm::uvec3& dimensions,
+                                    GLint             face,
+                                    GLsizei           layer,
+                                    const ImageData&  image)
+        {
+            if (!m_Active)
+                return;
+
+            // Source rows are aligned to GL_UNPACK_ALIGNMENT (4, never changed by vgfw)
+            const uint64_t rowSize  = static_cast<uint64_t>(dimensions.x) * getImageDataPixelSize(image);
+            const uint64_t rowPitch = (rowSize + 3) & ~uint64_t {3};
+            const uint64_t numRows =
+                std::max(dimensions.y, 1u) *
+                (texture.m_Type == GL_TEXTURE_CUBE_MAP_ARRAY ? 6 * texture.m_NumLayers : std::max(dimensions.z, 1u));
+
+            const trace::UploadTexture upload {
+                .texture    = refTexture(texture),
+                .mipLevel   = mipLevel,
+                .dimensions = dimensions,
+                .face       = face,
+                .layer      = layer,
+                .format     = image.format,
+                .dataType   = image.dataType,
+                .size       = rowPitch * (numRows - 1) + rowSize,
             };
+
+            const auto record = beginRecord(TraceRecordType::eUploadTexture);
+            write(upload);
+            writeBytes(image.pixels, static_cast<std::size_t>(upload.size));
+            endRecord(record);
         }
 
-        void RenderContext::createFaceView(Texture& cubeMap, GLuint mipLevel, GLuint layer, GLuint face)
+        void TraceCapture::onUnmap(const Buffer& buffer)
         {
-            assert(cubeMap.m_Type == GL_TEXTURE_CUBE_MAP || cubeMap.m_Type == GL_TEXTURE_CUBE_MAP_ARRAY);
+            if (!m_Active)
+                return;
 
-            if (cubeMap.m_View != GL_NONE)
-                glDeleteTextures(1, &cubeMap.m_View);
-            glGenTextures(1, &cubeMap.m_View);
+            // Whatever was written through the mapping is recorded as a whole-buffer upload
+            const trace::UploadBuffer upload {.buffer = refBuffer(buffer), .offset = 0, .size = buffer.m_Size};
 
-            glTextureView(cubeMap.m_View,
-                          GL_TEXTURE_2D,
-                          cubeMap.m_Id,
-                          static_cast<GLenum>(cubeMap.m_PixelFormat),
-                          mipLevel,
-                          1,
-                          (layer * 6) + face,
-                          1);
+            const auto record = beginRecord(TraceRecordType::eUploadBuffer);
+            write(upload);
+            const auto dataOffset = m_Stream.size();
+            m_Stream.resize(dataOffset + static_cast<std::size_t>(buffer.m_Size));
+            glGetNamedBufferSubData(buffer.m_Id, 0, buffer.m_Size, m_Stream.data() + dataOffset);
+            endRecord(record);
         }
 
-        void RenderContext::attachTexture(GLuint framebuffer, GLenum attachment, const AttachmentInfo& info)
+        void TraceCapture::onClear(const Buffer& buffer)
         {
-            const auto& [image, mipLevel, maybeLayer, maybeFace, _] = info;
+            if (!m_Active)
+                return;
 
-            switch (image.m_Type)
-            {
-                case GL_TEXTURE_CUBE_MAP:
-                case GL_TEXTURE_CUBE_MAP_ARRAY:
-                    createFaceView(image, mipLevel, maybeLayer.value_or(0), maybeFace.value_or(0));
-                    glNamedFramebufferTexture(framebuffer, attachment, image.m_View, 0);
-                    break;
+            const auto handle = refBuffer(buffer);
+            const auto record = beginRecord(TraceRecordType::eClearBuffer);
+            write(handle);
+            endRecord(record);
+        }
 
-                case GL_TEXTURE_2D:
-                    glNamedFramebufferTexture(framebuffer, attachment, image.m_Id, mipLevel);
-                    break;
+        void TraceCapture::onClear(const Texture& texture)
+        {
+            if (!m_Active)
+                return;
+
+            const auto handle = refTexture(texture);
+            const auto record = beginRecord(TraceRecordType::eClearTexture);
+            write(handle);
+            endRecord(record);
+        }
+
+        void TraceCapture::onGenerateMipmaps(const Texture& texture)
+        {
+            if (!m_Active)
+                return;
+
+            const auto handle = refTexture(texture);
+            const auto record = beginRecord(TraceRecordType::eGenerateMipmaps);
+            write(handle);
+            endRecord(record);
+        }
+
+        void TraceCapture::onSetupSampler(const Texture& texture, const SamplerInfo& samplerInfo)
+        {
+            if (!m_Active)
+                return;
+
+            const trace::SetupSampler setupSampler {.texture = refTexture(texture), .samplerInfo = samplerInfo};
+
+            const auto record = beginRecord(TraceRecordType::eSetupSampler);
+            write(setupSampler);
+            endRecord(record);
+        }
+
+        uint32_t TraceCapture::refBuffer(const Buffer& buffer, TraceBufferKind kind, uint32_t strideOrIndexType)
+        {
+            if (const auto it = m_Buffers.find(buffer.m_Id); it != m_Buffers.cend())
+                return it->second;
 
-                case GL_TEXTURE_2D_ARRAY:
-                    assert(maybeLayer.has_value());
-                    glNamedFramebufferTextureLayer(
-                        framebuffer, attachment, image.m_Id, mipLevel, maybeLayer.value_or(0));
-                    break;
+            const auto handle = m_NextHandle++;
+            m_Buffers.emplace(buffer.m_Id, handle);
 
-                case GL_TEXTURE_3D:
-                    glNamedFramebufferTexture(framebuffer, attachment, image.m_Id, 0);
-                    break;
+            const auto record = beginRecord(TraceRecordType::eBuffer);
+            write(trace::BufferRecord {
+                .handle            = handle,
+                .kind              = kind,
+                .strideOrIndexType = strideOrIndexType,
+                .size              = static_cast<uint64_t>(buffer.m_Size),
+            });
 
-                default:
-                    assert(false);
-            }
+            const auto dataOffset = m_Stream.size();
+            m_Stream.resize(dataOffset + static_cast<std::size_t>(buffer.m_Size));
+            // Contents of a mapped buffer are recorded on unmap
+            if (!buffer.isMapped())
+                glGetNamedBufferSubData(buffer.m_Id, 0, buffer.m_Size, m_Stream.data() + dataOffset);
+            endRecord(record);
+
+            return handle;
         }
 
-        GLuint RenderContext::createShaderProgram(std::initializer_list<GLuint> shaders)
+        uint32_t TraceCapture::refTexture(const Texture& texture)
         {
-            const auto program = glCreateProgram();
+            if (const auto it = m_Textures.find(texture.m_Id); it != m_Textures.cend())
+                return it->second;
 
-            for (auto shader : shaders)
-                if (shader != GL_NONE)
-                    glAttachShader(program, shader);
+            const auto handle = m_NextHandle++;
+            m_Textures.emplace(texture.m_Id, handle);
+
+            const auto                 transferFormat = trace::getTransferFormat(texture.m_PixelFormat);
+            const trace::TextureRecord textureRecord {
+                .handle       = handle,
+                .type         = texture.m_Type,
+                .pixelFormat  = texture.m_PixelFormat,
+                .extent       = texture.m_Extent,
+                .depth        = texture.m_Depth,
+                .numMipLevels = texture.m_NumMipLevels,
+                .numLayers    = texture.m_NumLayers,
+                .samplerInfo  = trace::getSamplerInfo(texture.m_Id),
+                .format       = transferFormat.format,
+                .dataType     = transferFormat.dataType,
+            };
 
-            glLinkProgram(program);
+            const auto record = beginRecord(TraceRecordType::eTexture);
+            write(textureRecord);
 
-            GLint status;
-            glGetProgramiv(program, GL_LINK_STATUS, &status);
-            if (GL_FALSE == status)
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            const auto pixelSize = getImageDataPixelSize(transferFormat);
+            for (uint32_t level {0}; level < texture.m_NumMipLevels; ++level)
             {
-                GLint infoLogLength;
-                glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLogLength);
-                assert(infoLogLength > 0);
-                std::string infoLog("", infoLogLength);
-                glGetProgramInfoLog(program, infoLogLength, nullptr, infoLog.data());
+                const auto     size = trace::getLevelSize(textureRecord, level);
+                const uint64_t numBytes =
+                    pixelSize > 0 ? static_cast<uint64_t>(size.x) * size.y * size.z * pixelSize : 0;
+                write(numBytes);
+
+                const auto dataOffset = m_Stream.size();
+                m_Stream.resize(dataOffset + static_cast<std::size_t>(numBytes));
+                if (numBytes > 0)
+                    glGetTextureImage(texture.m_Id,
+                                      level,
+                                      transferFormat.format,
+                                      transferFormat.dataType,
+                                      static_cast<GLsizei>(numBytes),
+                                      m_Stream.data() + dataOffset);
+            }
+            glPixelStorei(GL_PACK_ALIGNMENT, 4);
+            endRecord(record);
 
-                VGFW_ERROR("[ShaderInfoLog] {0}", infoLog);
+            return handle;
+        }
 
-                throw std::runtime_error {infoLog};
-            }
-            for (auto shader : shaders)
+        uint32_t TraceCapture::refProgram(GLuint program)
+        {
+            if (program == GL_NONE)
+                return 0;
+            if (const auto it = m_Programs.find(program); it != m_Programs.cend())
+                return it->second;
+
+            const auto handle = m_NextHandle++;
+            m_Programs.emplace(program, handle);
+
+            const auto it = m_ProgramSources.find(program);
+            if (it == m_ProgramSources.cend())
+                VGFW_WARN("[TraceCapture] Unknown sources of program {0}, it will not be replayed", program);
+
+            const auto record = beginRecord(TraceRecordType::eProgram);
+            write(handle);
+            write(static_cast<uint32_t>(it != m_ProgramSources.cend() ? it->second.size() : 0));
+            if (it != m_ProgramSources.cend())
             {
-                if (shader != GL_NONE)
+                for (const auto& [stage, source] : it->second)
                 {
-                    glDetachShader(program, shader);
-                    glDeleteShader(shader);
+                    write(stage);
+                    writeString(source);
                 }
             }
+            endRecord(record);
 
-            return program;
+            return handle;
         }
 
-        GLuint RenderContext::createShaderObject(GLenum type, const std::string& shaderSource)
+        uint32_t TraceCapture::refSampler(GLuint sampler)
         {
-            auto          id = glCreateShader(type);
-            const GLchar* strings {shaderSource.data()};
-            glShaderSource(id, 1, &strings, nullptr);
-            glCompileShader(id);
+            if (sampler == GL_NONE)
+                return 0;
+            if (const auto it = m_Samplers.find(sampler); it != m_Samplers.cend())
+                return it->second;
 
-            GLint status;
-            glGetShaderiv(id, GL_COMPILE_STATUS, &status);
-            if (GL_FALSE == status)
-            {
-                GLint infoLogLength;
-                glGetShaderiv(id, GL_INFO_LOG_LENGTH, &infoLogLength);
-                assert(infoLogLength > 0);
-                std::string infoLog("", infoLogLength);
-                glGetShaderInfoLog(id, infoLogLength, nullptr, infoLog.data());
+            const auto handle = m_NextHandle++;
+            m_Samplers.emplace(sampler, handle);
 
-                VGFW_ERROR("[ShaderInfoLog] {0}", infoLog);
-                throw std::runtime_error {infoLog};
-            };
+            const auto it = m_SamplerInfos.find(sampler);
+            if (it == m_SamplerInfos.cend())
+                VGFW_WARN("[TraceCapture] Unknown sampler {0}, replayed with default states", sampler);
 
-            return id;
+            const auto record = beginRecord(TraceRecordType::eSampler);
+            write(handle);
+            write(it != m_SamplerInfos.cend() ? it->second : SamplerInfo {});
+            endRecord(record);
+
+            return handle;
         }
 
-        void RenderContext::setShaderProgram(GLuint program)
+        uint32_t TraceCapture::refVertexArray(GLuint vao)
         {
-            assert(program != GL_NONE);
-            if (auto& current = m_CurrentPipeline.m_Program; current != program)
+            if (vao == GL_NONE)
+                return 0;
+            if (const auto it = m_VertexArrays.find(vao); it != m_VertexArrays.cend())
+                return it->second;
+
+            const auto handle = m_NextHandle++;
+            m_VertexArrays.emplace(vao, handle);
+
+            const auto it = m_VertexLayouts.find(vao);
+            if (it == m_VertexLayouts.cend())
+                VGFW_WARN("[TraceCapture] Unknown vertex array {0}, it will not be replayed", vao);
+
+            const auto record = beginRecord(TraceRecordType::eVertexArray);
+            write(handle);
+            write(static_cast<uint32_t>(it != m_VertexLayouts.cend() ? it->second.size() : 0));
+            if (it != m_VertexLayouts.cend())
             {
-                glUseProgram(program);
-                current = program;
+                for (const auto& [location, attribute] : it->second)
+                {
+                    write(location);
+                    write(attribute);
+                }
             }
+            endRecord(record);
+
+            return handle;
         }
 
-        void RenderContext::setVertexArray(GLuint vao)
+        std::size_t TraceCapture::beginRecord(TraceRecordType type)
         {
-            if (GL_NONE == vao)
-                vao = m_DummyVAO;
+            write(type);
+            const auto recordOffset = m_Stream.size();
+            write(uint32_t {0});
+            return recordOffset;
+        }
 
-            if (auto& current = m_CurrentPipeline.m_VAO; vao != current)
-            {
-                glBindVertexArray(vao);
-                current = vao;
-            }
+        void TraceCapture::endRecord(std::size_t recordOffset)
+        {
+            const auto size = static_cast<uint32_t>(m_Stream.size() - recordOffset - sizeof(uint32_t));
+            memcpy(m_Stream.data() + recordOffset, &size, sizeof(size));
         }
 
-        void RenderContext::setVertexBuffer(const VertexBuffer& vertexBuffer) const
+        template<typename T>
+        void TraceCapture::write(const T& v)
         {
-            const auto vao = m_CurrentPipeline.m_VAO;
-            assert(vertexBuffer && vao != GL_NONE);
-            glVertexArrayVertexBuffer(vao, 0, vertexBuffer.m_Id, 0, vertexBuffer.getStride());
+            static_assert(std::is_trivially_copyable_v<T>);
+            writeBytes(&v, sizeof(T));
         }
 
-        void RenderContext::setIndexBuffer(const IndexBuffer& indexBuffer) const
+        void TraceCapture::writeBytes(const void* data, std::size_t size)
         {
-            const auto vao = m_CurrentPipeline.m_VAO;
-            assert(indexBuffer && vao != GL_NONE);
-            glVertexArrayElementBuffer(vao, indexBuffer.m_Id);
+            if (size == 0)
+                return;
+
+            const auto offset = m_Stream.size();
+            m_Stream.resize(offset + size);
+            memcpy(m_Stream.data() + offset, data, size);
         }
 
-        void RenderContext::setDepthTest(bool enabled, CompareOp depthFunc)
+        void TraceCapture::writeString(std::string_view str)
         {
-            auto& current = m_CurrentPipeline.m_DepthStencilState;
-            if (enabled != current.depthTest)
-            {
-                enabled ? glEnable(GL_DEPTH_TEST) : glDisable(GL_DEPTH_TEST);
-                current.depthTest = enabled;
-            }
-            if (enabled && depthFunc != current.depthCompareOp)
-            {
-                glDepthFunc(static_cast<GLenum>(depthFunc));
-                current.depthCompareOp = depthFunc;
-            }
+            write(static_cast<uint32_t>(str.size()));
+            writeBytes(str.data(), str.size());
         }
 
-        void RenderContext::setDepthWrite(bool enabled)
+        TracePlayer::~TracePlayer() { destroyResources(); }
+
+        bool TracePlayer::load(const std::filesystem::path& filePath)
         {
-            auto& current = m_CurrentPipeline.m_DepthStencilState;
-            if (enabled != current.depthWrite)
+            destroyResources();
+            m_ResourceRecords.clear();
+            m_Frames.clear();
+
+            std::ifstream fileStream(filePath, std::ios::binary | std::ios::ate);
+            if (!fileStream.is_open())
             {
-                glDepthMask(enabled);
-                current.depthWrite = enabled;
+                VGFW_ERROR("[TracePlayer] Could not open trace: {0}", filePath.generic_string());
+                return false;
             }
-        }
+            m_Data.resize(static_cast<std::size_t>(fileStream.tellg()));
+            fileStream.seekg(0);
+            fileStream.read(reinterpret_cast<char*>(m_Data.data()), static_cast<std::streamsize>(m_Data.size()));
 
-        void RenderContext::setPolygonMode(PolygonMode polygonMode)
-        {
-            auto& current = m_CurrentPipeline.m_RasterizerState.polygonMode;
-            if (polygonMode != current)
+            if (m_Data.size() < trace::kFileHeaderSize ||
+                command::read<uint32_t>(m_Data.data()) != TraceCapture::kMagic ||
+                command::read<uint32_t>(m_Data.data() + 4) != TraceCapture::kVersion)
             {
-                glPolygonMode(GL_FRONT_AND_BACK, static_cast<GLenum>(polygonMode));
-                current = polygonMode;
+                VGFW_ERROR("[TracePlayer] Not a vgfw trace (version {0}): {1}",
+                           TraceCapture::kVersion,
+                           filePath.generic_string());
+                return false;
             }
-        }
+            m_Extent = {command::read<uint32_t>(m_Data.data() + 12), command::read<uint32_t>(m_Data.data() + 16)};
 
-        void RenderContext::setPolygonOffset(std::optional<PolygonOffset> polygonOffset)
-        {
-            auto& current = m_CurrentPipeline.m_RasterizerState;
-            if (polygonOffset != current.polygonOffset)
+            auto frameBegin = trace::kFileHeaderSize;
+            for (auto offset = trace::kFileHeaderSize; offset < m_Data.size();)
             {
-                const auto offsetCap = getPolygonOffsetCap(current.polygonMode);
-                if (polygonOffset.has_value())
-                {
-                    glEnable(offsetCap);
-                    glPolygonOffset(polygonOffset->factor, polygonOffset->units);
-                }
-                else
+                if (offset + trace::kRecordHeaderSize > m_Data.size())
                 {
-                    glDisable(offsetCap);
+                    VGFW_ERROR("[TracePlayer] Truncated trace: {0}", filePath.generic_string());
+                    return false;
                 }
-                current.polygonOffset = polygonOffset;
-            }
-        }
 
-        void RenderContext::setCullMode(CullMode cullMode)
-        {
-            auto& current = m_CurrentPipeline.m_RasterizerState.cullMode;
-            if (cullMode != current)
-            {
-                if (cullMode != CullMode::eNone)
+                const auto type = command::read<TraceRecordType>(m_Data.data() + offset);
+                const auto next = offset + trace::kRecordHeaderSize +
+                                  command::read<uint32_t>(m_Data.data() + offset + sizeof(TraceRecordType));
+                if (next > m_Data.size())
                 {
-                    if (current == CullMode::eNone)
-                        glEnable(GL_CULL_FACE);
-                    glCullFace(static_cast<GLenum>(cullMode));
+                    VGFW_ERROR("[TracePlayer] Truncated trace: {0}", filePath.generic_string());
+                    return false;
                 }
-                else
+
+                if (type < TraceRecordType::eEndFrame)
+                    m_ResourceRecords.push_back(offset);
+                else if (type == TraceRecordType::eEndFrame)
                 {
-                    glDisable(GL_CULL_FACE);
+                    m_Frames.emplace_back(frameBegin, offset);
+                    frameBegin = next;
                 }
-                current = cullMode;
+                offset = next;
             }
+
+            VGFW_INFO("[TracePlayer] Loaded trace ({0} frames, {1} resources, {2}x{3}): {4}",
+                      m_Frames.size(),
+                      m_ResourceRecords.size(),
+                      m_Extent.width,
+                      m_Extent.height,
+                      filePath.generic_string());
+            return !m_Frames.empty();
         }
 
-        void RenderContext::setDepthClamp(bool enabled)
+        void TracePlayer::createResources(RenderContext& rc)
         {
-            auto& current = m_CurrentPipeline.m_RasterizerState.depthClampEnable;
-            if (enabled != current)
+            VGFW_PROFILE_FUNCTION
+            destroyResources();
+            m_RenderContext = &rc;
+
+            for (const auto offset : m_ResourceRecords)
             {
-                enabled ? glEnable(GL_DEPTH_CLAMP) : glDisable(GL_DEPTH_CLAMP);
-                current = enabled;
+                const auto type = command::read<TraceRecordType>(m_Data.data() + offset);
+                const auto size = command::read<uint32_t>(m_Data.data() + offset + sizeof(TraceRecordType));
+                createResource(type, m_Data.data() + offset + trace::kRecordHeaderSize, size);
             }
         }
 
-        void RenderContext::setScissorTest(bool enabled)
+        void TracePlayer::createResource(TraceRecordType type, const std::byte* payload, std::size_t size)
         {
-            auto& current = m_CurrentPipeline.m_RasterizerState.scissorTest;
-            if (enabled != current)
+            auto&         rc = *m_RenderContext;
+            trace::Reader reader {payload, size};
+
+            switch (type)
             {
-                enabled ? glEnable(GL_SCISSOR_TEST) : glDisable(GL_SCISSOR_TEST);
-                current = enabled;
+                using enum TraceRecordType;
+                case eBuffer: {
+                    const auto  record = reader.read<trace::BufferRecord>();
+                    const auto* data   = reader.readBytes(record.size);
+                    switch (record.kind)
+                    {
+                        case TraceBufferKind::eVertexBuffer: {
+                            const auto stride   = static_cast<GLsizei>(record.strideOrIndexType);
+                            const auto capacity = static_cast<int64_t>(record.size) / stride;
+                            m_VertexBuffers.emplace(record.handle,
+                                                    RenderContext::createVertexBuffer(stride, capacity, data));
+                        }
+                        break;
+                        case TraceBufferKind::eIndexBuffer: {
+                            const auto indexType = static_cast<IndexType>(record.strideOrIndexType);
+                            const auto capacity  = static_cast<int64_t>(record.size) / record.strideOrIndexType;
+                            m_IndexBuffers.emplace(record.handle,
+                                                   RenderContext::createIndexBuffer(indexType, capacity, data));
+                        }
+                        break;
+                        default:
+                            m_Buffers.emplace(record.handle,
+                                              RenderContext::createBuffer(static_cast<GLsizeiptr>(record.size), data));
+                    }
+                }
+                break;
+
+                case eTexture: {
+                    const auto record = reader.read<trace::TextureRecord>();
+
+                    Texture texture;
+                    switch (record.type)
+                    {
+                        case GL_TEXTURE_3D:
+                            texture = RenderContext::createTexture3D(record.extent, record.depth, record.pixelFormat);
+                            break;
+                        case GL_TEXTURE_CUBE_MAP:
+                        case GL_TEXTURE_CUBE_MAP_ARRAY:
+                            texture = RenderContext::createCubemap(
+                                record.extent.width, record.pixelFormat, record.numMipLevels, record.numLayers);
+                            break;
+                        default:
+                            texture = RenderContext::createTexture2D(
+                                record.extent, record.pixelFormat, record.numMipLevels, record.numLayers);
+                    }
+                    rc.setupSampler(texture, record.samplerInfo);
+
+                    // Snapshots are tightly packed
+                    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+                    for (uint32_t level {0}; level < record.numMipLevels; ++level)
+                    {
+                        const auto  numBytes = reader.read<uint64_t>();
+                        const auto* pixels   = reader.readBytes(numBytes);
+                        if (numBytes == 0)
+                            continue;
+
+                        const auto levelSize = trace::getLevelSize(record, level);
+                        const auto sliceSize = numBytes / levelSize.z;
+                        ImageData  image {.format = record.format, .dataType = record.dataType, .pixels = pixels};
+                        switch (record.type)
+                        {
+                            case GL_TEXTURE_2D_ARRAY:
+                                for (uint32_t layer {0}; layer < levelSize.z; ++layer)
+                                {
+                                    image.pixels = pixels + layer * sliceSize;
+                                    rc.upload(texture, level, {levelSize.x, levelSize.y, 0}, 0, layer, image);
+                                }
+                                break;
+                            case GL_TEXTURE_CUBE_MAP:
+                                for (uint32_t face {0}; face < levelSize.z; ++face)
+                                {
+                                    image.pixels = pixels + face * sliceSize;
+                                    rc.upload(texture, level, {levelSize.x, levelSize.y, 0}, face, 0, image);
+                                }
+                                break;
+                            default:
+                                rc.upload(texture, level, levelSize, 0, 0, image);
+                        }
+                    }
+                    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+                    m_Textures.emplace(record.handle, std::move(texture));
+                }
+                break;
+
+                case eProgram: {
+                    const auto handle    = reader.read<uint32_t>();
+                    const auto numStages = reader.read<uint32_t>();
+
+                    std::string                vertSource, fragSource, compSource;
+                    std::optional<std::string> geomSource;
+                    for (uint32_t i {0}; i < numStages; ++i)
+                    {
+                        const auto stage  = reader.read<GLenum>();
+                        auto       source = reader.readString();
+                        switch (stage)
+                        {
+                            case GL_VERTEX_SHADER:
+                                vertSource = std::move(source);
+                                break;
+                            case GL_FRAGMENT_SHADER:
+                                fragSource = std::move(source);
+                                break;
+                            case GL_GEOMETRY_SHADER:
+                                geomSource = std::move(source);
+                                break;
+                            case GL_COMPUTE_SHADER:
+                                compSource = std::move(source);
+                                break;
+                        }
+                    }
+
+                    GLuint program {GL_NONE};
+                    if (!compSource.empty())
+                        program = RenderContext::createComputeProgram(compSource);
+                    else if (!vertSource.empty())
+                        program = RenderContext::createGraphicsProgram(vertSource, fragSource, geomSource);
+                    m_Programs.emplace(handle, program);
+                }
+                break;
+
+                case eSampler: {
+                    const auto handle = reader.read<uint32_t>();
+                    m_Samplers.emplace(handle, RenderContext::createSampler(reader.read<SamplerInfo>()));
+                }
+                break;
+
+                case eVertexArray: {
+                    const auto handle        = reader.read<uint32_t>();
+                    const auto numAttributes = reader.read<uint32_t>();
+
+                    VertexAttributes attributes;
+                    for (uint32_t i {0}; i < numAttributes; ++i)
+                    {
+                        const auto location  = reader.read<int32_t>();
+                        attributes[location] = reader.read<VertexAttribute>();
+                    }
+                    m_VertexArrays.emplace(handle, attributes.empty() ? GL_NONE : rc.getVertexArray(attributes));
+                }
+                break;
+
+                default:
+                    assert(false);
             }
         }
 
-        void RenderContext::setBlendState(GLuint index, const BlendState& state)
+        void TracePlayer::destroyResources()
         {
-            auto& current = m_CurrentPipeline.m_BlendStates[index];
-            if (state != current)
+            if (!m_RenderContext)
+                return;
+
+            auto& rc = *m_RenderContext;
+            for (auto& [_, buffer] : m_Buffers)
+                rc.destroy(buffer);
+            for (auto& [_, buffer] : m_VertexBuffers)
+                rc.destroy(buffer);
+            for (auto& [_, buffer] : m_IndexBuffers)
+                rc.destroy(buffer);
+            for (auto& [_, texture] : m_Textures)
+                rc.destroy(texture);
+            for (auto [_, program] : m_Programs)
+                glDeleteProgram(program);
+            for (auto [_, sampler] : m_Samplers)
+                glDeleteSamplers(1, &sampler);
+
+            m_Buffers.clear();
+            m_VertexBuffers.clear();
+            m_IndexBuffers.clear();
+            m_Textures.clear();
+            m_Programs.clear();
+            m_Samplers.clear();
+            m_VertexArrays.clear(); // Owned by the RenderContext
+
+            m_RenderContext = nullptr;
+        }
+
+        Buffer& TracePlayer::getBuffer(uint32_t handle)
+        {
+            if (const auto it = m_Buffers.find(handle); it != m_Buffers.cend())
+                return it->second;
+            if (const auto it = m_VertexBuffers.find(handle); it != m_VertexBuffers.cend())
+                return it->second;
+            return m_IndexBuffers.at(handle);
+        }
+
+        void TracePlayer::replayFrame(uint32_t frameIndex)
+        {
+            VGFW_PROFILE_FUNCTION
+            assert(m_RenderContext && frameIndex < m_Frames.size());
+
+            auto&      rc           = *m_RenderContext;
+            const auto [begin, end] = m_Frames[frameIndex];
+            for (auto offset = begin; offset < end;)
             {
-                if (state.enabled != current.enabled)
-                {
-                    state.enabled ? glEnablei(GL_BLEND, index) : glDisablei(GL_BLEND, index);
-                    current.enabled = state.enabled;
-                }
-                if (state.enabled)
+                const auto    type = command::read<TraceRecordType>(m_Data.data() + offset);
+                const auto    size = command::read<uint32_t>(m_Data.data() + offset + sizeof(TraceRecordType));
+                trace::Reader reader {m_Data.data() + offset + trace::kRecordHeaderSize, size};
+                offset += trace::kRecordHeaderSize + size;
+
+                switch (type)
                 {
-                    if (state.colorOp != current.colorOp || state.alphaOp != current.alphaOp)
-                    {
-                        glBlendEquationSeparatei(
-                            index, static_cast<GLenum>(state.colorOp), static_cast<GLenum>(state.alphaOp));
+                    using enum TraceRecordType;
+                    case eSetViewport:
+                        rc.setViewport(reader.read<Rect2D>());
+                        break;
+                    case eSetScissor:
+                        rc.setScissor(reader.read<Rect2D>());
+                        break;
+
+                    case eBindGraphicsPipeline: {
+                        const auto record = reader.read<trace::PipelineRecord>();
+
+                        GraphicsPipeline::Builder builder {};
+                        builder.setShaderProgram(trace::findOrNone(m_Programs, record.program))
+                            .setVAO(trace::findOrNone(m_VertexArrays, record.vao))
+                            .setDepthStencil(record.depthStencilState)
+                            .setRasterizerState(record.rasterizerState);
+                        for (uint32_t i {0}; i < record.blendStates.size(); ++i)
+                            builder.setBlendState(i, record.blendStates[i]);
+
+                        rc.bindGraphicsPipeline(builder.build());
+                    }
+                    break;
+                    case eBindImage: {
+                        const auto record = reader.read<trace::BindImage>();
+                        rc.bindImage(record.unit, m_Textures.at(record.texture), record.mipLevel, record.access);
+                    }
+                    break;
+                    case eBindTexture: {
+                        const auto record = reader.read<trace::BindTexture>();
+                        rc.bindTexture(record.unit,
+                                       m_Textures.at(record.texture),
+                                       record.hasSampler ?
+                                           std::optional<GLuint> {trace::findOrNone(m_Samplers, record.sampler)} :
+                                           std::nullopt);
+                    }
+                    break;
+                    case eBindUniformBuffer: {
+                        const auto record = reader.read<trace::BindBuffer>();
+                        rc.bindUniformBuffer(record.index, getBuffer(record.buffer));
+                    }
+                    break;
+                    case eBindStorageBuffer: {
+                        const auto record = reader.read<trace::BindBuffer>();
+                        rc.bindStorageBuffer(record.index, getBuffer(record.buffer));
+                    }
+                    break;
 
-                        current.colorOp = state.colorOp;
-                        current.alphaOp = state.alphaOp;
+                    case eSetUniform: {
+                        const auto uniformType = reader.read<CommandType>();
+                        const auto name        = reader.readString();
+                        switch (uniformType)
+                        {
+                            using enum CommandType;
+                            case eSetUniform1f:
+                                rc.setUniform1f(name, reader.read<float>());
+                                break;
+                            case eSetUniform1i:
+                                rc.setUniform1i(name, reader.read<int32_t>());
+                                break;
+                            case eSetUniform1ui:
+                                rc.setUniform1ui(name, reader.read<uint32_t>());
+                                break;
+                            case eSetUniformVec2:
+                                rc.setUniformVec2(name, reader.read<glm::vec2>());
+                                break;
+                            case eSetUniformVec3:
+                                rc.setUniformVec3(name, reader.read<glm::vec3>());
+                                break;
+                            case eSetUniformVec4:
+                                rc.setUniformVec4(name, reader.read<glm::vec4>());
+                                break;
+                            case eSetUniformMat3:
+                                rc.setUniformMat3(name, reader.read<glm::mat3>());
+                                break;
+                            case eSetUniformMat4:
+                                rc.setUniformMat4(name, reader.read<glm::mat4>());
+                                break;
+
+                            default:
+                                assert(false);
+                        }
                     }
-                    if (state.srcColor != current.srcColor || state.destColor != current.destColor ||
-                        state.srcAlpha != current.srcAlpha || state.destAlpha != current.destAlpha)
-                    {
-                        glBlendFuncSeparatei(index,
-                                             static_cast<GLenum>(state.srcColor),
-                                             static_cast<GLenum>(state.destColor),
-                                             static_cast<GLenum>(state.srcAlpha),
-                                             static_cast<GLenum>(state.destAlpha));
+                    break;
 
-                        current.srcColor  = state.srcColor;
-                        current.destColor = state.destColor;
-                        current.srcAlpha  = state.srcAlpha;
-                        current.destAlpha = state.destAlpha;
+                    case eDispatch: {
+                        const auto record = reader.read<trace::Dispatch>();
+                        rc.dispatch(trace::findOrNone(m_Programs, record.program), record.numGroups);
+                    }
+                    break;
+                    case eDraw: {
+                        const auto record = reader.read<trace::Draw>();
+
+                        OptionalReference<const VertexBuffer> vertexBuffer;
+                        if (record.vertexBuffer != 0)
+                            vertexBuffer = m_VertexBuffers.at(record.vertexBuffer);
+                        OptionalReference<const IndexBuffer> indexBuffer;
+                        if (record.indexBuffer != 0)
+                            indexBuffer = m_IndexBuffers.at(record.indexBuffer);
+
+                        rc.draw(vertexBuffer, indexBuffer, record.geometryInfo, record.numInstances);
+                    }
+                    break;
+
+                    case eBeginRendering: {
+                        const auto toAttachment = [this](const trace::Attachment& attachment) {
+                            std::optional<ClearValue> clearValue;
+                            if (attachment.clear == trace::Attachment::Clear::eColor)
+                                clearValue = attachment.clearValue;
+                            else if (attachment.clear == trace::Attachment::Clear::eDepth)
+                                clearValue = attachment.clearValue.x;
+
+                            std::optional<uint32_t> layer, face;
+                            if (attachment.layer >= 0)
+                                layer = static_cast<uint32_t>(attachment.layer);
+                            if (attachment.face >= 0)
+                                face = static_cast<uint32_t>(attachment.face);
+
+                            return AttachmentInfo {
+                                .image      = m_Textures.at(attachment.texture),
+                                .mipLevel   = attachment.mipLevel,
+                                .layer      = layer,
+                                .face       = face,
+                                .clearValue = clearValue,
+                            };
+                        };
+
+                        RenderingInfo renderingInfo {.area = reader.read<Rect2D>(), .colorAttachments = {}};
+                        const auto    hasDepthAttachment  = reader.read<bool>();
+                        const auto    numColorAttachments = reader.read<uint32_t>();
+                        if (hasDepthAttachment)
+                            renderingInfo.depthAttachment.emplace(toAttachment(reader.read<trace::Attachment>()));
+                        for (uint32_t i {0}; i < numColorAttachments; ++i)
+                            renderingInfo.colorAttachments.push_back(toAttachment(reader.read<trace::Attachment>()));
+
+                        m_Framebuffer = rc.beginRendering(renderingInfo);
+                    }
+                    break;
+                    case eBeginDefaultRendering: {
+                        const auto record = reader.read<trace::DefaultRendering>();
+                        rc.beginRendering(record.area,
+                                          record.hasClearColor ? std::optional {record.clearColor} : std::nullopt,
+                                          record.hasClearDepth ? std::optional {record.clearDepth} : std::nullopt,
+                                          record.hasClearStencil ? std::optional {record.clearStencil} : std::nullopt);
+                    }
+                    break;
+                    case eEndRendering:
+                        if (m_Framebuffer != GL_NONE)
+                            rc.endRendering(std::exchange(m_Framebuffer, GL_NONE));
+                        break;
+
+                    case eUploadBuffer: {
+                        const auto record = reader.read<trace::UploadBuffer>();
+                        rc.upload(getBuffer(record.buffer),
+                                  record.offset,
+                                  record.size,
+                                  reader.readBytes(static_cast<std::size_t>(record.size)));
+                    }
+                    break;
+                    case eUploadTexture: {
+                        const auto record = reader.read<trace::UploadTexture>();
+                        rc.upload(m_Textures.at(record.texture),
+                                  record.mipLevel,
+                                  record.dimensions,
+                                  record.face,
+                                  record.layer,
+                                  {
+                                      .format   = record.format,
+                                      .dataType = record.dataType,
+                                      .pixels   = reader.readBytes(static_cast<std::size_t>(record.size)),
+                                  });
+                    }
+                    break;
+                    case eClearBuffer:
+                        rc.clear(getBuffer(reader.read<uint32_t>()));
+                        break;
+                    case eClearTexture:
+                        rc.clear(m_Textures.at(reader.read<uint32_t>()));
+                        break;
+                    case eGenerateMipmaps:
+                        rc.generateMipmaps(m_Textures.at(reader.read<uint32_t>()));
+                        break;
+                    case eSetupSampler: {
+                        const auto record = reader.read<trace::SetupSampler>();
+                        rc.setupSampler(m_Textures.at(record.texture), record.samplerInfo);
                     }
+                    break;
+
+                    default:
+                        // Resources are created by createResources
+                        break;
                 }
             }
         }
@@ -3102,6 +10183,8 @@ namespace vgfw
 
                 if (pool.empty())
                 {
+                    const GpuMemoryScope memoryScope {GpuMemoryCategory::eTransientTargets};
+
                     Texture texture;
                     if (desc.depth > 0)
                     {
@@ -3166,6 +10249,9 @@ namespace vgfw
                 auto&      pool = m_BufferPools[h];
                 if (pool.empty())
                 {
+                    // Framegraph buffers back per-frame uniform/storage blocks
+                    const GpuMemoryScope memoryScope {GpuMemoryCategory::eUniforms};
+
                     auto buffer = m_RenderContext.createBuffer(desc.size);
                     m_Buffers.push_back(std::make_unique<Buffer>(std::move(buffer)));
                     auto* ptr = m_Buffers.back().get();
@@ -3371,7 +10457,9 @@ namespace vgfw
                     io.ConfigFlags |= ImGuiConfigFlags_DockingEnable; // Enable Docking
                 }
 
+#ifndef VGFW_NULL_GL
                 io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable; // Enable Multi-Viewport
+#endif
                 // io.ConfigFlags |= ImGuiConfigFlags_ViewportsNoTaskBarIcons;
                 // io.ConfigFlags |= ImGuiConfigFlags_ViewportsNoMerge;
 
@@ -3385,15 +10473,27 @@ namespace vgfw
                     style.PopupRounding = style.TabRounding = 6.0f;
                 }
 
-                ImGui_ImplGlfw_InitForOpenGL(
-                    static_cast<GLFWwindow*>(getGraphicsContext().getWindow()->getPlatformWindow()), true);
+                const auto window = getGraphicsContext().getWindow();
+                if (window->getType() == window::WindowType::eGLFW)
+                    ImGui_ImplGlfw_InitForOpenGL(static_cast<GLFWwindow*>(window->getPlatformWindow()), true);
+#ifdef VGFW_NULL_GL
+                // No renderer backend: the draw lists are still built every frame, just never submitted
+                io.Fonts->Build();
+#else
                 ImGui_ImplOpenGL3_Init("#version 330");
+#endif
             }
 
             void beginFrame()
             {
+                const auto window = getGraphicsContext().getWindow();
+#ifndef VGFW_NULL_GL
                 ImGui_ImplOpenGL3_NewFrame();
-                ImGui_ImplGlfw_NewFrame();
+#endif
+                if (window->getType() == window::WindowType::eGLFW)
+                    ImGui_ImplGlfw_NewFrame();
+                else
+                    ImGui::GetIO().DisplaySize = ImVec2(window->getWidth(), window->getHeight());
                 ImGui::NewFrame();
 
                 if (g_EnableDocking)
@@ -3452,7 +10552,9 @@ namespace vgfw
 
                 ImGui::Render();
 
+#ifndef VGFW_NULL_GL
                 ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+#endif
 
                 if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
                 {
@@ -3465,8 +10567,11 @@ namespace vgfw
 
             void shutdown()
             {
+#ifndef VGFW_NULL_GL
                 ImGui_ImplOpenGL3_Shutdown();
-                ImGui_ImplGlfw_Shutdown();
+#endif
+                if (getGraphicsContext().getWindow()->getType() == window::WindowType::eGLFW)
+                    ImGui_ImplGlfw_Shutdown();
                 ImGui::DestroyContext();
             }
         } // namespace imgui
@@ -3476,6 +10581,13 @@ namespace vgfw
             g_GraphicsContext.init(initInfo.window);
             g_RenderContext = std::make_shared<RenderContext>();
 
+            g_FramePacer.init(initInfo.framePacing);
+            g_FrameStatsRecorder.init();
+            if (initInfo.trackLatency)
+                g_LatencyTracker.init();
+            if (initInfo.enableGpuProfiler)
+                g_GpuProfiler.init();
+
             imgui::init(initInfo.enableImGuiDocking);
 
             g_RendererInit = true;
@@ -3484,6 +10596,11 @@ namespace vgfw
         void beginFrame()
         {
             VGFW_PROFILE_FUNCTION
+            memory::getFrameArena().nextFrame();
+            g_FrameStatsRecorder.beginFrame();
+            g_GpuProfiler.beginFrame();
+            jobs::pumpGLThread();
+            io::processUploads();
             imgui::beginFrame();
         }
 
@@ -3496,27 +10613,230 @@ namespace vgfw
         void present()
         {
             VGFW_PROFILE_FUNCTION
+            g_FrameStatsRecorder.beginPresent();
+            g_GpuProfiler.endFrame();
+            g_RenderContext->flushFrameStats();
             g_GraphicsContext.swapBuffers();
+            if (g_LatencyTracker.isEnabled())
+                g_LatencyTracker.onPresent(g_GraphicsContext.getWindow()->getLastPollTime());
+            g_FramePacer.onPresent();
+            g_RenderContext->collectGarbage(g_FramePacer.getStats().framesInFlight);
+            g_FrameStatsRecorder.endPresent();
+            g_TraceCapture.onPresent();
+
+            VGFW_PROFILE_END_OF_FRAME
         }
 
         void shutdown()
         {
             imgui::shutdown();
+            // Registry resources go while the GL context is still alive
+            if (g_RenderContext)
+                g_RenderContext->destroyResources();
+            g_FramePacer.shutdown();
+            g_LatencyTracker.shutdown();
+            g_GpuProfiler.shutdown();
+            g_FrameStatsRecorder.shutdown();
             g_GraphicsContext.shutdown();
         }
 
         bool isLoaded() { return g_RendererInit; }
 
-        GraphicsContext& getGraphicsContext() { return g_GraphicsContext; }
-        RenderContext&   getRenderContext() { return *g_RenderContext; }
+        GraphicsContext&    getGraphicsContext() { return g_GraphicsContext; }
+        RenderContext&      getRenderContext() { return *g_RenderContext; }
+        FramePacer&         getFramePacer() { return g_FramePacer; }
+        LatencyTracker&     getLatencyTracker() { return g_LatencyTracker; }
+        GpuProfiler&        getGpuProfiler() { return g_GpuProfiler; }
+        GpuMemoryTracker&   getGpuMemoryTracker() { return g_GpuMemoryTracker; }
+        FrameStatsRecorder& getFrameStatsRecorder() { return g_FrameStatsRecorder; }
+        TraceCapture&       getTraceCapture() { return g_TraceCapture; }
     } // namespace renderer
 
+    namespace io
+    {
+        const char* toString(LoadStage stage)
+        {
+            switch (stage)
+            {
+                case LoadStage::eFileRead:
+                    return "file_read";
+                case LoadStage::eParse:
+                    return "parse";
+                case LoadStage::eImageDecode:
+                    return "image_decode";
+                case LoadStage::eMeshProcessing:
+                    return "mesh_processing";
+                case LoadStage::eBufferUpload:
+                    return "buffer_upload";
+                case LoadStage::eTextureUpload:
+                    return "texture_upload";
+                case LoadStage::eMipGeneration:
+                    return "mip_generation";
+                default:
+                    return "unknown";
+            }
+        }
+
+        std::string exportStagesJson(const LoadStageArray& stages)
+        {
+            std::string json = "{";
+            for (size_t i = 0; i < kNumLoadStages; ++i)
+            {
+                json += fmt::format("{0}\"{1}\":{{\"ms\":{2:.4f},\"bytes\":{3},\"count\":{4}}}",
+                                    i > 0 ? "," : "",
+                                    toString(static_cast<LoadStage>(i)),
+                                    stages[i].ms,
+                                    stages[i].bytes,
+                                    stages[i].count);
+            }
+            json += "}";
+            return json;
+        }
+
+        std::string LoadReport::exportJson() const
+        {
+            std::string json = fmt::format("{{\"path\":\"{0}\",\"total_ms\":{1:.4f},\"mesh_primitives\":{2},"
+                                           "\"vertices\":{3},\"indices\":{4},\"stages\":{5},\"textures\":[",
+                                           utils::escapeJson(path.generic_string()),
+                                           totalMs,
+                                           numMeshPrimitives,
+                                           numVertices,
+                                           numIndices,
+                                           exportStagesJson(stages));
+            for (size_t i = 0; i < textures.size(); ++i)
+            {
+                json += fmt::format("{0}{{\"path\":\"{1}\",\"width\":{2},\"height\":{3},\"stages\":{4}}}",
+                                    i > 0 ? "," : "",
+                                    utils::escapeJson(textures[i].path.generic_string()),
+                                    textures[i].width,
+                                    textures[i].height,
+                                    exportStagesJson(textures[i].stages));
+            }
+            json += "]}";
+            return json;
+        }
+
+        static std::vector<LoadReport> g_LoadReports;
+        static LoadReport*             g_ActiveLoadReport = nullptr;
+
+        const std::vector<LoadReport>& getLoadReports() { return g_LoadReports; }
+
+        const LoadReport* findLoadReport(const std::filesystem::path& assetPath)
+        {
+            const auto it = std::find_if(g_LoadReports.crbegin(), g_LoadReports.crend(), [&](const auto& report) {
+                return report.path == assetPath;
+            });
+            return it != g_LoadReports.crend() ? &*it : nullptr;
+        }
+
+        void clearLoadReports() { g_LoadReports.clear(); }
+
+        std::string exportLoadReportsJson()
+        {
+            std::string json = "[";
+            for (size_t i = 0; i < g_LoadReports.size(); ++i)
+            {
+                if (i > 0)
+                    json += ",";
+                json += g_LoadReports[i].exportJson();
+            }
+            json += "]";
+            return json;
+        }
+
+        bool exportLoadReports(const std::filesystem::path& filePath)
+        {
+            return utils::writeFileAllText(filePath, exportLoadReportsJson());
+        }
+
+        void mergeLoadStages(LoadStageArray& dst, const LoadStageArray& src)
+        {
+            for (size_t i = 0; i < kNumLoadStages; ++i)
+            {
+                dst[i].ms += src[i].ms;
+                dst[i].bytes += src[i].bytes;
+                dst[i].count += src[i].count;
+            }
+        }
+
+        // Adds the wall time of a stage to the given stages (those of the active report by default) when stopped
+        class LoadStageTimer
+        {
+        public:
+            explicit LoadStageTimer(LoadStage stage, LoadStageArray* stages = nullptr) :
+                m_Stage {stage}, m_Stages {stages}, m_Begin {time::Clock::now()}
+            {
+                if (!m_Stages && g_ActiveLoadReport)
+                    m_Stages = &g_ActiveLoadReport->stages;
+            }
+            ~LoadStageTimer() { stop(); }
+
+            LoadStageTimer(const LoadStageTimer&)            = delete;
+            LoadStageTimer& operator=(const LoadStageTimer&) = delete;
+
+            void addBytes(uint64_t bytes) { m_Bytes += bytes; }
+
+            void stop()
+            {
+                if (!m_Stages)
+                    return;
+
+                auto& stats = (*m_Stages)[static_cast<size_t>(m_Stage)];
+                stats.ms += std::chrono::duration<double, std::milli>(time::Clock::now() - m_Begin).count();
+                stats.bytes += m_Bytes;
+                ++stats.count;
+                m_Stages = nullptr;
+            }
+
+        private:
+            LoadStage       m_Stage;
+            LoadStageArray* m_Stages;
+            time::TimePoint m_Begin;
+            uint64_t        m_Bytes {0};
+        };
+
+        // Opens the report of a top-level load on the GL thread. Nested loads (the textures of a model) add to it.
+        class LoadReportScope
+        {
+        public:
+            explicit LoadReportScope(const std::filesystem::path& assetPath, time::TimePoint begin = time::Clock::now())
+            {
+                if (g_ActiveLoadReport)
+                    return;
+
+                m_Report.emplace().path = assetPath;
+                m_Begin                 = begin;
+                g_ActiveLoadReport      = &*m_Report;
+            }
+            ~LoadReportScope()
+            {
+                if (!m_Report)
+                    return;
+
+                g_ActiveLoadReport = nullptr;
+                m_Report->totalMs  = std::chrono::duration<double, std::milli>(time::Clock::now() - m_Begin).count();
+                VGFW_TRACE("[IO] Loaded {0} in {1:.2f} ms", m_Report->path.generic_string(), m_Report->totalMs);
+
+                g_LoadReports.push_back(std::move(*m_Report));
+            }
+
+            LoadReportScope(const LoadReportScope&)            = delete;
+            LoadReportScope& operator=(const LoadReportScope&) = delete;
+
+        private:
+            std::optional<LoadReport> m_Report;
+            time::TimePoint           m_Begin {};
+        };
+    } // namespace io
+
     namespace resource
     {
         void MeshPrimitive::build(renderer::VertexFormat::Builder& vertexFormatBuilder,
                                   const glm::vec3&                 scale,
                                   renderer::RenderContext&         rc)
         {
+            io::LoadStageTimer meshTimer {io::LoadStage::eMeshProcessing};
+
             vertexFormat = vertexFormatBuilder.build();
             indexCount   = indices.size();
 
@@ -3529,6 +10849,8 @@ namespace vgfw
             aabb.min = {floatMax, floatMax, floatMax};
             aabb.max = {-floatMax, -floatMax, -floatMax};
 
+            vertices.reserve(vertices.size() + vertexCount * vertexFormat->getStride() / sizeof(float));
+
             for (uint32_t v = 0; v < vertexCount; ++v)
             {
                 // apply scale factor
@@ -3577,88 +10899,521 @@ namespace vgfw
 
             assert(ownerModel);
             ownerModel->aabb.merge(aabb);
+            ownerModel->m_RenderContext = &rc;
+
+            meshTimer.addBytes(vertices.size() * sizeof(float) + indices.size() * sizeof(uint32_t));
+            meshTimer.stop();
+
+            io::LoadStageTimer uploadTimer {io::LoadStage::eBufferUpload};
+            uploadTimer.addBytes(vertices.size() * sizeof(float) + indices.size() * sizeof(uint32_t) +
+                                 sizeof(PrimitiveMaterial));
+            if (io::g_ActiveLoadReport)
+            {
+                ++io::g_ActiveLoadReport->numMeshPrimitives;
+                io::g_ActiveLoadReport->numVertices += vertexCount;
+                io::g_ActiveLoadReport->numIndices += indexCount;
+            }
 
             // Load index buffer & vertex buffer
             auto indexBuf  = rc.createIndexBuffer(renderer::IndexType::eUInt32, indices.size(), indices.data());
             auto vertexBuf = rc.createVertexBuffer(vertexFormat->getStride(), vertexCount, vertices.data());
 
-            indexBuffer  = std::shared_ptr<renderer::IndexBuffer>(new renderer::IndexBuffer {std::move(indexBuf)},
-                                                                 renderer::RenderContext::ResourceDeleter {rc});
-            vertexBuffer = std::shared_ptr<renderer::VertexBuffer>(new renderer::VertexBuffer {std::move(vertexBuf)},
-                                                                   renderer::RenderContext::ResourceDeleter {rc});
+            indexBuffer  = rc.add(std::move(indexBuf));
+            vertexBuffer = rc.add(std::move(vertexBuf));
+
+            // Load material buffer
+            materialBuffer = rc.add(rc.createBuffer(sizeof(PrimitiveMaterial), &material));
+        }
+
+        void MeshPrimitive::release(renderer::RenderContext& rc)
+        {
+            rc.release(std::exchange(indexBuffer, {}));
+            rc.release(std::exchange(vertexBuffer, {}));
+            rc.release(std::exchange(materialBuffer, {}));
+        }
+
+        void MeshPrimitive::draw(renderer::RenderContext& rc) const
+        {
+            assert(vertexBuffer && indexBuffer);
+            rc.draw(*rc.get(vertexBuffer),
+                    *rc.get(indexBuffer),
+                    {
+                        .topology    = renderer::PrimitiveTopology::eTriangleList,
+                        .numVertices = vertexCount,
+                        .numIndices  = indexCount,
+                    });
+        }
+
+        void Model::bindMeshPrimitiveTextures(uint32_t                 primitiveIndex,
+                                              uint32_t                 startUnit,
+                                              renderer::RenderContext& rc,
+                                              std::optional<GLuint>    samplerId) const
+        {
+            assert(primitiveIndex >= 0 && primitiveIndex < meshPrimitives.size());
+
+            const auto& primitive = meshPrimitives[primitiveIndex];
+
+            for (uint32_t i = 0; i < primitive.textureIndices.size(); ++i)
+            {
+                rc.bindTexture(startUnit + i, *rc.get(textures[primitive.textureIndices[i]]), samplerId);
+            }
+        }
+
+        Model::~Model()
+        {
+            if (m_RenderContext)
+                release(*m_RenderContext);
+
+            // The primitives must be gone before the arena they were allocated from
+            meshPrimitives.clear();
+        }
+
+        Model& Model::operator=(Model&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (m_RenderContext)
+                    release(*m_RenderContext);
+                meshPrimitives.clear();
+
+                meshPrimitives  = std::move(other.meshPrimitives);
+                textures        = std::move(other.textures);
+                materials       = std::move(other.materials);
+                aabb            = other.aabb;
+                m_Arena         = std::move(other.m_Arena);
+                m_RenderContext = std::exchange(other.m_RenderContext, nullptr);
+            }
+            return *this;
+        }
+
+        MeshPrimitive& Model::addMeshPrimitive()
+        {
+            return meshPrimitives.emplace_back(MeshPrimitive::allocator_type {getMemoryResource()});
+        }
+
+        std::pmr::memory_resource* Model::getMemoryResource()
+        {
+            constexpr size_t kInitialArenaSize = 64 * 1024;
+
+            if (!m_Arena)
+                m_Arena = std::make_unique<std::pmr::monotonic_buffer_resource>(kInitialArenaSize);
+            return m_Arena.get();
+        }
+
+        void Model::release(renderer::RenderContext& rc)
+        {
+            for (auto& meshPrimitive : meshPrimitives)
+                meshPrimitive.release(rc);
+            m_RenderContext = nullptr;
+        }
+    } // namespace resource
+
+    namespace scene
+    {
+        glm::mat4 Transform::toMatrix() const
+        {
+            auto matrix = glm::mat4_cast(rotation);
+            matrix[0] *= scale.x;
+            matrix[1] *= scale.y;
+            matrix[2] *= scale.z;
+            matrix[3] = glm::vec4 {translation, 1.0f};
+            return matrix;
+        }
+
+        NodeHandle Scene::createNode(NodeHandle                     parent,
+                                     const Transform&               local,
+                                     const resource::MeshPrimitive* meshPrimitive)
+        {
+            const auto index       = static_cast<uint32_t>(m_Handles.size());
+            const auto parentIndex = parent ? getIndex(parent) : kNoParent;
+            const auto level       = parent ? m_Levels[parentIndex] + 1 : 0;
+
+            // Appending keeps the levels sorted unless the node belongs to an earlier level than the last node
+            if (!m_Levels.empty() && level < m_Levels.back())
+                m_TopologyChanged = true;
+            if (!m_TopologyChanged)
+            {
+                if (level + 1 == m_LevelOffsets.size())
+                    m_LevelOffsets.push_back(index + 1);
+                else
+                    m_LevelOffsets.back() = index + 1;
+            }
+
+            const auto handle = m_Nodes.insert({index});
+            m_Handles.push_back(handle);
+            m_Parents.push_back(parentIndex);
+            m_Levels.push_back(level);
+            m_Translations.push_back(local.translation);
+            m_Rotations.push_back(local.rotation);
+            m_Scales.push_back(local.scale);
+            m_LocalAABBs.push_back(meshPrimitive ? meshPrimitive->aabb : math::AABB {.min {0.0f}, .max {0.0f}});
+            m_WorldMatrices.emplace_back(1.0f);
+            m_WorldAABBs.push_back(m_LocalAABBs.back());
+            m_Dirty.push_back(true);
+            m_UpdateStamps.push_back(0);
+
+            if (meshPrimitive)
+            {
+                m_DrawIndices.push_back(static_cast<uint32_t>(m_DrawMeshes.size()));
+                m_DrawMeshes.push_back(meshPrimitive);
+                m_DrawTransforms.emplace_back(1.0f);
+            }
+            else
+            {
+                m_DrawIndices.push_back(kNoDraw);
+            }
+
+            if (level >= m_NumDirtyPerLevel.size())
+                m_NumDirtyPerLevel.resize(level + 1, 0);
+            ++m_NumDirtyPerLevel[level];
+
+            return handle;
+        }
+
+        NodeHandle Scene::addModel(const resource::Model& model, NodeHandle parent, const Transform& local)
+        {
+            const auto root = createNode(parent, local);
+            for (const auto& meshPrimitive : model.meshPrimitives)
+                createNode(root, {}, &meshPrimitive);
+            return root;
+        }
+
+        void Scene::destroyNode(NodeHandle node)
+        {
+            const auto index = getIndex(node);
+
+            // Parents come before their children, one pass from the node marks the whole subtree
+            std::vector<uint8_t> removed(m_Handles.size(), false);
+            removed[index] = true;
+            for (auto i = index + 1; i < m_Handles.size(); ++i)
+                removed[i] = m_Parents[i] != kNoParent && removed[m_Parents[i]];
+
+            for (auto i = index; i < m_Handles.size(); ++i)
+            {
+                if (removed[i])
+                    m_Nodes.remove(m_Handles[i]);
+            }
+
+            reorder(sortByLevel(removed));
+        }
+
+        bool Scene::contains(NodeHandle node) const { return m_Nodes.contains(node); }
+
+        uint32_t Scene::getNumNodes() const { return static_cast<uint32_t>(m_Handles.size()); }
+
+        uint32_t Scene::getNumLevels() const { return static_cast<uint32_t>(m_NumDirtyPerLevel.size()); }
+
+        NodeHandle Scene::getParent(NodeHandle node) const
+        {
+            const auto parentIndex = m_Parents[getIndex(node)];
+            return parentIndex != kNoParent ? m_Handles[parentIndex] : NodeHandle {};
+        }
+
+        void Scene::setLocalTransform(NodeHandle node, const Transform& local)
+        {
+            const auto index = getIndex(node);
+
+            m_Translations[index] = local.translation;
+            m_Rotations[index]    = local.rotation;
+            m_Scales[index]       = local.scale;
+
+            if (!m_Dirty[index])
+            {
+                m_Dirty[index] = true;
+                ++m_NumDirtyPerLevel[m_Levels[index]];
+            }
+        }
+
+        Transform Scene::getLocalTransform(NodeHandle node) const
+        {
+            const auto index = getIndex(node);
+            return {.translation = m_Translations[index], .rotation = m_Rotations[index], .scale = m_Scales[index]};
+        }
+
+        const glm::mat4& Scene::getWorldMatrix(NodeHandle node) const { return m_WorldMatrices[getIndex(node)]; }
+
+        const math::AABB& Scene::getWorldAABB(NodeHandle node) const { return m_WorldAABBs[getIndex(node)]; }
+
+        uint32_t Scene::update()
+        {
+            VGFW_PROFILE_FUNCTION
+
+            if (m_TopologyChanged)
+                reorder(sortByLevel({}));
+
+            ++m_UpdateCount;
+
+            // A level is visited when nodes of its own were changed or when nodes of the level above were recomputed
+            uint32_t numUpdated      = 0;
+            uint32_t numParentsDirty = 0;
+            for (uint32_t level = 0; level < getNumLevels(); ++level)
+            {
+                if (numParentsDirty == 0 && m_NumDirtyPerLevel[level] == 0)
+                    continue;
+
+                const auto begin = m_LevelOffsets[level];
+                const auto count = m_LevelOffsets[level + 1] - begin;
+                numParentsDirty  = jobs::parallelReduce(
+                    count,
+                    kUpdateGrainSize,
+                    0u,
+                    [this, begin](uint32_t i) { return updateNode(begin + i); },
+                    std::plus<uint32_t> {});
+
+                m_NumDirtyPerLevel[level] = 0;
+                numUpdated += numParentsDirty;
+            }
+
+            if (numUpdated > 0)
+                ++m_TransformsVersion;
+            return numUpdated;
+        }
+
+        uint32_t Scene::getDrawIndex(NodeHandle node) const { return m_DrawIndices[getIndex(node)]; }
+
+        const renderer::StorageBuffer& Scene::uploadTransforms(renderer::RenderContext& rc)
+        {
+            // Frames in flight may still read the buffers of the previous frames, each frame writes its own
+            assert(!m_TransformBuffers.renderContext || m_TransformBuffers.renderContext == &rc);
+            m_TransformBuffers.renderContext = &rc;
+
+            auto&      transformBuffer = m_TransformBuffers.buffers[rc.getFrameIndex() % kNumTransformBuffers];
+            const auto size            = std::max<size_t>(m_DrawTransforms.size(), 1) * sizeof(glm::mat4);
+
+            auto* buffer = rc.get(transformBuffer.buffer);
+            if (!buffer || static_cast<size_t>(buffer->getSize()) < size)
+            {
+                rc.release(transformBuffer.buffer);
+
+                const renderer::GpuMemoryScope memoryScope {renderer::GpuMemoryCategory::eUniforms, false};
+                transformBuffer.buffer  = rc.add(rc.createBuffer(static_cast<GLsizeiptr>(std::bit_ceil(size))));
+                transformBuffer.version = 0;
+                buffer                  = rc.get(transformBuffer.buffer);
+            }
+
+            if (transformBuffer.version != m_TransformsVersion)
+            {
+                rc.upload(*buffer, 0, m_DrawTransforms.size() * sizeof(glm::mat4), m_DrawTransforms.data());
+                transformBuffer.version = m_TransformsVersion;
+            }
+
+            return *buffer;
+        }
+
+        void Scene::release([[maybe_unused]] renderer::RenderContext& rc)
+        {
+            assert(!m_TransformBuffers.renderContext || m_TransformBuffers.renderContext == &rc);
+            m_TransformBuffers.release();
+        }
+
+        Scene::TransformBufferRing& Scene::TransformBufferRing::operator=(TransformBufferRing&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                renderContext = std::exchange(other.renderContext, nullptr);
+                buffers       = std::exchange(other.buffers, {});
+            }
+            return *this;
+        }
+
+        void Scene::TransformBufferRing::release()
+        {
+            if (!renderContext)
+                return;
 
-            // Load material buffer
-            auto materialBuf = rc.createBuffer(sizeof(PrimitiveMaterial), &material);
-            materialBuffer   = std::shared_ptr<renderer::Buffer>(new renderer::Buffer {std::move(materialBuf)},
-                                                               renderer::RenderContext::ResourceDeleter {rc});
+            for (auto& transformBuffer : buffers)
+                renderContext->release(std::exchange(transformBuffer, {}).buffer);
+            renderContext = nullptr;
         }
 
-        void MeshPrimitive::draw(renderer::RenderContext& rc) const
+        uint32_t Scene::getIndex(NodeHandle node) const { return m_Nodes[node].index; }
+
+        uint32_t Scene::updateNode(uint32_t index)
         {
-            assert(vertexBuffer && indexBuffer);
-            rc.draw(*vertexBuffer,
-                    *indexBuffer,
-                    {
-                        .topology    = renderer::PrimitiveTopology::eTriangleList,
-                        .numVertices = vertexCount,
-                        .numIndices  = indexCount,
-                    });
+            // Nodes only read the level above, which is complete, and write their own slots
+            const auto parent        = m_Parents[index];
+            const bool parentUpdated = parent != kNoParent && m_UpdateStamps[parent] == m_UpdateCount;
+            if (!m_Dirty[index] && !parentUpdated)
+                return 0;
+
+            const auto local = Transform {m_Translations[index], m_Rotations[index], m_Scales[index]}.toMatrix();
+
+            auto& world = m_WorldMatrices[index];
+            world       = parent != kNoParent ? m_WorldMatrices[parent] * local : local;
+
+            m_WorldAABBs[index]   = m_LocalAABBs[index].transform(world);
+            m_Dirty[index]        = false;
+            m_UpdateStamps[index] = m_UpdateCount;
+
+            if (m_DrawIndices[index] != kNoDraw)
+                m_DrawTransforms[m_DrawIndices[index]] = world;
+
+            return 1;
         }
 
-        void Model::bindMeshPrimitiveTextures(uint32_t                 primitiveIndex,
-                                              uint32_t                 startUnit,
-                                              renderer::RenderContext& rc,
-                                              std::optional<GLuint>    samplerId) const
+        std::vector<uint32_t> Scene::sortByLevel(const std::vector<uint8_t>& removed) const
         {
-            assert(primitiveIndex >= 0 && primitiveIndex < meshPrimitives.size());
-
-            const auto& primitive = meshPrimitives[primitiveIndex];
+            // Counting sort, stable so the nodes of a level keep their relative order
+            std::vector<uint32_t> offsets(getNumLevels() + 1, 0);
+            for (uint32_t i = 0; i < m_Handles.size(); ++i)
+            {
+                if (removed.empty() || !removed[i])
+                    ++offsets[m_Levels[i] + 1];
+            }
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
 
-            for (uint32_t i = 0; i < primitive.textureIndices.size(); ++i)
+            std::vector<uint32_t> order(offsets.back());
+            for (uint32_t i = 0; i < m_Handles.size(); ++i)
             {
-                rc.bindTexture(startUnit + i, *textures[primitive.textureIndices[i]], samplerId);
+                if (removed.empty() || !removed[i])
+                    order[offsets[m_Levels[i]]++] = i;
             }
+            return order;
         }
-    } // namespace resource
 
-    namespace io
-    {
-        renderer::Texture* loadTexture(const std::filesystem::path& texturePath, renderer::RenderContext& rc, bool flip)
+        void Scene::reorder(const std::vector<uint32_t>& order)
         {
-            if (texturePath.empty())
+            VGFW_PROFILE_FUNCTION
+
+            const auto numNodes = static_cast<uint32_t>(order.size());
+
+            std::vector<uint32_t> newIndices(m_Handles.size(), kNoParent);
+            for (uint32_t i = 0; i < numNodes; ++i)
+                newIndices[order[i]] = i;
+
+            const auto permute = [&order]<typename T>(std::vector<T>& values) {
+                std::vector<T> permuted;
+                permuted.reserve(order.size());
+                for (const auto index : order)
+                    permuted.push_back(values[index]);
+                values = std::move(permuted);
+            };
+
+            // The draws are referenced by their mesh until the draw indices are rebuilt below
+            std::vector<const resource::MeshPrimitive*> meshes(m_Handles.size(), nullptr);
+            for (uint32_t i = 0; i < m_Handles.size(); ++i)
             {
-                return nullptr;
+                if (m_DrawIndices[i] != kNoDraw)
+                    meshes[i] = m_DrawMeshes[m_DrawIndices[i]];
             }
 
-            auto       p = std::filesystem::absolute(texturePath);
-            const auto h = std::filesystem::hash_value(p);
-            if (auto it = g_TextureCache.find(h); it != g_TextureCache.cend())
+            permute(m_Handles);
+            permute(m_Parents);
+            permute(m_Levels);
+            permute(m_Translations);
+            permute(m_Rotations);
+            permute(m_Scales);
+            permute(m_LocalAABBs);
+            permute(m_WorldMatrices);
+            permute(m_WorldAABBs);
+            permute(m_Dirty);
+            permute(m_UpdateStamps);
+            permute(meshes);
+
+            m_LevelOffsets.assign(1, 0);
+            m_NumDirtyPerLevel.clear();
+            m_DrawIndices.assign(numNodes, kNoDraw);
+            m_DrawMeshes.clear();
+            m_DrawTransforms.clear();
+
+            for (uint32_t i = 0; i < numNodes; ++i)
             {
-                auto extent = it->second->getExtent();
-                assert(extent.width > 0 && extent.height > 0);
+                m_Nodes[m_Handles[i]].index = i;
+                if (m_Parents[i] != kNoParent)
+                    m_Parents[i] = newIndices[m_Parents[i]];
 
-                return it->second;
+                const auto level = m_Levels[i];
+                if (level + 1 == m_LevelOffsets.size())
+                {
+                    m_LevelOffsets.push_back(i + 1);
+                    m_NumDirtyPerLevel.push_back(0);
+                }
+                else
+                {
+                    m_LevelOffsets.back() = i + 1;
+                }
+                m_NumDirtyPerLevel[level] += m_Dirty[i];
+
+                if (meshes[i])
+                {
+                    m_DrawIndices[i] = static_cast<uint32_t>(m_DrawMeshes.size());
+                    m_DrawMeshes.push_back(meshes[i]);
+                    m_DrawTransforms.push_back(m_WorldMatrices[i]);
+                }
             }
 
-            stbi_set_flip_vertically_on_load(flip);
+            m_TopologyChanged = false;
+            ++m_TransformsVersion;
+        }
+    } // namespace scene
 
-            auto* f = stbi__fopen(texturePath.string().c_str(), "rb");
-            assert(f);
+    namespace io
+    {
+        // Reads an asset through the VFS without copying pack entries, returns empty data on failure
+        vfs::FileData readAsset(const std::filesystem::path& filePath)
+        {
+            auto file = vfs::readFile(filePath);
+            if (!file)
+            {
+                VGFW_ERROR("Could not open file: {0}", filePath.generic_string());
+                return {};
+            }
+            return std::move(*file);
+        }
 
-            const auto hdr = stbi_is_hdr_from_file(f);
+        struct DecodedImage
+        {
+            int32_t        width {0};
+            int32_t        height {0};
+            int32_t        numChannels {0};
+            bool           hdr {false};
+            void*          pixels {nullptr};
+            LoadStageArray stages {}; // File read & decode, merged into the report on upload
+        };
 
-            int32_t width, height, numChannels;
-            auto*   pixels = hdr ? reinterpret_cast<void*>(stbi_loadf_from_file(f, &width, &height, &numChannels, 0)) :
-                                   reinterpret_cast<void*>(stbi_load_from_file(f, &width, &height, &numChannels, 0));
-            fclose(f);
-            assert(pixels);
+        // CPU-only part of texture loading, safe to call from job threads
+        DecodedImage decodeImage(const std::filesystem::path& texturePath, bool flip)
+        {
+            VGFW_PROFILE_FUNCTION
+            stbi_set_flip_vertically_on_load_thread(flip);
+
+            DecodedImage image {};
+
+            LoadStageTimer readTimer {LoadStage::eFileRead, &image.stages};
+            const auto     file = readAsset(texturePath);
+            readTimer.addBytes(file.size());
+            readTimer.stop();
+
+            LoadStageTimer decodeTimer {LoadStage::eImageDecode, &image.stages};
+            const auto*    data = reinterpret_cast<const stbi_uc*>(file.data());
+            const auto     size = static_cast<int>(file.size());
+
+            image.hdr    = stbi_is_hdr_from_memory(data, size);
+            image.pixels = image.hdr ? reinterpret_cast<void*>(stbi_loadf_from_memory(
+                                           data, size, &image.width, &image.height, &image.numChannels, 0)) :
+                                       reinterpret_cast<void*>(stbi_load_from_memory(
+                                           data, size, &image.width, &image.height, &image.numChannels, 0));
+            assert(image.pixels);
+            decodeTimer.addBytes(static_cast<uint64_t>(image.width) * image.height * image.numChannels *
+                                 (image.hdr ? sizeof(float) : 1));
+            decodeTimer.stop();
+
+            return image;
+        }
 
+        // GL part of texture loading, must run on the GL thread. Frees the decoded pixels.
+        renderer::GpuTextureHandle uploadTexture(const std::filesystem::path& texturePath,
+                                                 DecodedImage&                image,
+                                                 renderer::RenderContext&     rc)
+        {
+            VGFW_PROFILE_FUNCTION
             renderer::ImageData imageData {
-                .dataType = static_cast<GLenum>(hdr ? GL_FLOAT : GL_UNSIGNED_BYTE),
-                .pixels   = pixels,
+                .dataType = static_cast<GLenum>(image.hdr ? GL_FLOAT : GL_UNSIGNED_BYTE),
+                .pixels   = image.pixels,
             };
             renderer::PixelFormat pixelFormat {renderer::PixelFormat::eUnknown};
-            switch (numChannels)
+            switch (image.numChannels)
             {
                 case 1:
                     imageData.format = GL_RED;
@@ -3666,22 +11421,35 @@ namespace vgfw
                     break;
                 case 3:
                     imageData.format = GL_RGB;
-                    pixelFormat      = hdr ? renderer::PixelFormat::eRGB16F : renderer::PixelFormat::eRGB8_UNorm;
+                    pixelFormat = image.hdr ? renderer::PixelFormat::eRGB16F : renderer::PixelFormat::eRGB8_UNorm;
                     break;
                 case 4:
                     imageData.format = GL_RGBA;
-                    pixelFormat      = hdr ? renderer::PixelFormat::eRGBA16F : renderer::PixelFormat::eRGBA8_UNorm;
+                    pixelFormat = image.hdr ? renderer::PixelFormat::eRGBA16F : renderer::PixelFormat::eRGBA8_UNorm;
                     break;
 
                 default:
                     assert(false);
             }
 
+            const auto width  = image.width;
+            const auto height = image.height;
+
+            const renderer::GpuMemoryScope memoryScope {renderer::GpuMemoryCategory::eMaterialTextures};
+
             uint32_t numMipLevels {1u};
             if (math::isPowerOf2(width) && math::isPowerOf2(height))
                 numMipLevels = renderer::calcMipLevels(glm::max(width, height));
 
-            auto texture = rc.createTexture2D(
+            TextureLoadReport textureReport {
+                .path   = texturePath,
+                .width  = static_cast<uint32_t>(width),
+                .height = static_cast<uint32_t>(height),
+                .stages = image.stages,
+            };
+
+            LoadStageTimer uploadTimer {LoadStage::eTextureUpload, &textureReport.stages};
+            auto           texture = rc.createTexture2D(
                 {static_cast<uint32_t>(width), static_cast<uint32_t>(height)}, pixelFormat, numMipLevels);
             rc.upload(texture, 0, {width, height}, imageData)
                 .setupSampler(texture,
@@ -3691,22 +11459,68 @@ namespace vgfw
                                   .magFilter     = renderer::TexelFilter::eLinear,
                                   .maxAnisotropy = 16.0f,
                               });
-            stbi_image_free(pixels);
+            uploadTimer.addBytes(image.stages[static_cast<size_t>(LoadStage::eImageDecode)].bytes);
+            uploadTimer.stop();
+
+            stbi_image_free(image.pixels);
+            image.pixels = nullptr;
 
             if (numMipLevels > 1)
+            {
+                LoadStageTimer mipTimer {LoadStage::eMipGeneration, &textureReport.stages};
                 rc.generateMipmaps(texture);
+                for (uint32_t level = 1; level < numMipLevels; ++level)
+                {
+                    mipTimer.addBytes(static_cast<uint64_t>(std::max(width >> level, 1)) *
+                                      std::max(height >> level, 1) * renderer::getBytesPerPixel(pixelFormat));
+                }
+            }
+
+            if (g_ActiveLoadReport)
+            {
+                mergeLoadStages(g_ActiveLoadReport->stages, textureReport.stages);
+                g_ActiveLoadReport->textures.push_back(std::move(textureReport));
+            }
 
-            auto* newTexture  = new renderer::Texture {std::move(texture)};
-            g_TextureCache[h] = newTexture;
+            const auto newTexture = rc.add(std::move(texture));
+            const auto h          = std::filesystem::hash_value(std::filesystem::absolute(texturePath));
+            g_TextureCache[h]     = newTexture;
 
             VGFW_TRACE("[IO] Loaded texture: {0}", texturePath.generic_string());
 
             return newTexture;
         }
 
-        void releaseTexture(const std::filesystem::path& texturePath,
-                            renderer::Texture&           texture,
-                            renderer::RenderContext&     rc)
+        renderer::GpuTextureHandle
+        acquireTexture(const std::filesystem::path& texturePath, renderer::RenderContext& rc, bool flip)
+        {
+            if (texturePath.empty())
+            {
+                return {};
+            }
+
+            auto       p = std::filesystem::absolute(texturePath);
+            const auto h = std::filesystem::hash_value(p);
+            if (auto it = g_TextureCache.find(h); it != g_TextureCache.cend())
+            {
+                auto extent = rc.get(it->second)->getExtent();
+                assert(extent.width > 0 && extent.height > 0);
+
+                return it->second;
+            }
+
+            const LoadReportScope reportScope {texturePath};
+
+            auto image = decodeImage(texturePath, flip);
+            return uploadTexture(texturePath, image, rc);
+        }
+
+        renderer::Texture* loadTexture(const std::filesystem::path& texturePath, renderer::RenderContext& rc, bool flip)
+        {
+            return rc.get(acquireTexture(texturePath, rc, flip));
+        }
+
+        void releaseTexture(const std::filesystem::path& texturePath, renderer::RenderContext& rc)
         {
             if (texturePath.empty())
             {
@@ -3717,50 +11531,104 @@ namespace vgfw
             const auto h = std::filesystem::hash_value(p);
             if (auto it = g_TextureCache.find(h); it != g_TextureCache.cend())
             {
-                rc.destroy(texture);
-                g_TextureCache.erase(h);
+                rc.release(it->second);
+                g_TextureCache.erase(it);
             }
         }
 
+        // Loads the MTL files referenced by an OBJ file through the VFS
+        class VfsMaterialReader : public tinyobj::MaterialReader
+        {
+        public:
+            explicit VfsMaterialReader(std::filesystem::path baseDir) : m_BaseDir(std::move(baseDir)) {}
+
+            bool operator()(const std::string&                matId,
+                            std::vector<tinyobj::material_t>* materials,
+                            std::map<std::string, int>*       matMap,
+                            std::string*                      warn,
+                            std::string*                      err) override
+            {
+                const auto file = vfs::readFile(m_BaseDir / matId);
+                if (!file)
+                {
+                    if (warn)
+                        *warn += "Material file [ " + matId + " ] not found.\n";
+                    return false;
+                }
+
+                std::istringstream mtlStream {std::string(file->text())};
+                tinyobj::LoadMtl(matMap, materials, &mtlStream, warn, err);
+                return true;
+            }
+
+        private:
+            std::filesystem::path m_BaseDir;
+        };
+
         bool loadOBJ(const std::filesystem::path& modelPath,
                      resource::Model&             model,
                      renderer::RenderContext&     rc,
                      const glm::vec3&             scale)
         {
-            std::string              inputfile = modelPath.generic_string();
-            tinyobj::ObjReaderConfig readerConfig;
+            const LoadReportScope reportScope {modelPath};
+
+            // Read the file up front so that file read and parse are reported separately
+            LoadStageTimer readTimer {LoadStage::eFileRead};
+            const auto     file = readAsset(modelPath);
+            readTimer.addBytes(file.size());
+            readTimer.stop();
+            if (file.empty())
+                return false;
+
+            tinyobj::attrib_t                attrib;
+            std::vector<tinyobj::shape_t>    shapes;
+            std::vector<tinyobj::material_t> materials;
+            std::string                      warn;
+            std::string                      err;
+
+            LoadStageTimer parseTimer {LoadStage::eParse};
+            parseTimer.addBytes(file.size());
 
-            // The MTL file path was not correctly parsed when loading the OBJ model, causing the material file to fail
-            // to load. Comment out this line to load the MTL file from the same directory as the OBJ file.
-            // readerConfig.mtl_search_path = "./"; // Path to material files
+            // MTL files are loaded from the same directory as the OBJ file
+            std::istringstream objStream {std::string(file.text())};
+            VfsMaterialReader  materialReader {modelPath.parent_path()};
+            const bool ret = tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, &objStream, &materialReader);
+            parseTimer.stop();
 
-            tinyobj::ObjReader reader;
+            if (!warn.empty())
+            {
+                VGFW_WARN("[TinyObjReader] {0}", warn);
+            }
 
-            if (!reader.ParseFromFile(inputfile, readerConfig))
+            if (!ret)
             {
-                if (!reader.Error().empty())
+                if (!err.empty())
                 {
-                    VGFW_ERROR("[TinyObjReader] {0}", reader.Error());
+                    VGFW_ERROR("[TinyObjReader] {0}", err);
                 }
                 return false;
             }
 
-            if (!reader.Warning().empty())
-            {
-                VGFW_WARN("[TinyObjReader] {0}", reader.Warning());
-            }
-
-            const auto& attrib    = reader.GetAttrib();
-            const auto& shapes    = reader.GetShapes();
-            const auto& materials = reader.GetMaterials();
+            model.meshPrimitives.reserve(model.meshPrimitives.size() + shapes.size());
 
             // Loop over shapes
             for (const auto& shape : shapes)
             {
-                auto& meshPrimitive = model.meshPrimitives.emplace_back();
+                LoadStageTimer meshTimer {LoadStage::eMeshProcessing};
+
+                auto& meshPrimitive = model.addMeshPrimitive();
 
                 meshPrimitive.name = shape.name;
 
+                // Every face vertex becomes a vertex, reserve up front so the arena is not filled with regrowths
+                const size_t numFaceVertices = shape.mesh.indices.size();
+                meshPrimitive.record.positions.reserve(numFaceVertices);
+                meshPrimitive.indices.reserve(numFaceVertices);
+                if (!attrib.normals.empty())
+                    meshPrimitive.record.normals.reserve(numFaceVertices);
+                if (!attrib.texcoords.empty())
+                    meshPrimitive.record.texcoords.reserve(numFaceVertices);
+
                 auto    vertexFormatBuilder = renderer::VertexFormat::Builder {};
                 int32_t attributeOffset     = 0;
 
@@ -3834,39 +11702,93 @@ namespace vgfw
 
                 meshPrimitive.ownerModel        = &model;
                 meshPrimitive.indexInOwnerModel = model.meshPrimitives.size() - 1;
+                meshTimer.stop();
                 meshPrimitive.build(vertexFormatBuilder, scale, rc);
             }
 
             return true;
         }
 
-        bool loadGLTF(const std::filesystem::path& modelPath,
-                      resource::Model&             model,
-                      renderer::RenderContext&     rc,
-                      const glm::vec3&             scale)
+        // Routes the files tinygltf reads itself (external buffers and images) through the VFS
+        tinygltf::FsCallbacks getGltfFsCallbacks()
+        {
+            tinygltf::FsCallbacks callbacks {};
+            callbacks.FileExists     = [](const std::string& filePath, void*) { return vfs::exists(filePath); };
+            callbacks.ExpandFilePath = &tinygltf::ExpandFilePath;
+            callbacks.ReadWholeFile  = [](std::vector<unsigned char>* out,
+                                         std::string*                err,
+                                         const std::string&          filePath,
+                                         void*) {
+                auto file = vfs::readFile(filePath);
+                if (!file)
+                {
+                    if (err)
+                        *err += "File open error : " + filePath + "\n";
+                    return false;
+                }
+                *out = std::move(*file).toBytes();
+                return true;
+            };
+            callbacks.WriteWholeFile = &tinygltf::WriteWholeFile;
+
+            // Only newer tinygltf versions query the file size, and then require the callback to be set
+            [](auto& fs) {
+                if constexpr (requires { fs.GetFileSizeInBytes; })
+                {
+                    fs.GetFileSizeInBytes =
+                        [](size_t* fileSize, std::string* err, const std::string& filePath, void*) {
+                            const auto size = vfs::getFileSize(filePath);
+                            if (!size)
+                            {
+                                if (err)
+                                    *err += "File does not exist: " + filePath + "\n";
+                                return false;
+                            }
+                            *fileSize = static_cast<size_t>(*size);
+                            return true;
+                        };
+                }
+            }(callbacks);
+
+            callbacks.user_data = nullptr;
+            return callbacks;
+        }
+
+        // CPU-only part of glTF loading, safe to call from job threads
+        bool parseGLTF(const std::filesystem::path& modelPath, tinygltf::Model& gltfModel, LoadStageArray& stages)
         {
+            VGFW_PROFILE_FUNCTION
             tinygltf::TinyGLTF loader;
-            tinygltf::Model    gltfModel;
             std::string        err;
             std::string        warn;
+            loader.SetFsCallbacks(getGltfFsCallbacks());
 
-            bool        ret = false;
             const auto& ext = modelPath.extension();
-
-            if (ext == ".gltf")
-            {
-                ret = loader.LoadASCIIFromFile(&gltfModel, &err, &warn, modelPath.generic_string());
-            }
-            else if (ext == ".glb")
-            {
-                ret = loader.LoadBinaryFromFile(&gltfModel, &err, &warn, modelPath.generic_string());
-            }
-            else
+            if (ext != ".gltf" && ext != ".glb")
             {
                 VGFW_ERROR("[TinyGLTF] Unsupported format");
                 return false;
             }
 
+            // Read the file up front so that file read and parse are reported separately, external buffers are still
+            // read by the parser
+            LoadStageTimer readTimer {LoadStage::eFileRead, &stages};
+            const auto     file = readAsset(modelPath);
+            readTimer.addBytes(file.size());
+            readTimer.stop();
+
+            LoadStageTimer parseTimer {LoadStage::eParse, &stages};
+            parseTimer.addBytes(file.size());
+
+            const auto baseDir = modelPath.parent_path().generic_string();
+            const auto size    = static_cast<unsigned int>(file.size());
+            const bool ret =
+                ext == ".gltf" ?
+                    loader.LoadASCIIFromString(
+                        &gltfModel, &err, &warn, reinterpret_cast<const char*>(file.data()), size, baseDir) :
+                    loader.LoadBinaryFromMemory(&gltfModel, &err, &warn, file.data(), size, baseDir);
+            parseTimer.stop();
+
             if (!warn.empty())
             {
                 VGFW_WARN("[TinyGLTF] {0}", warn);
@@ -3884,14 +11806,54 @@ namespace vgfw
                 return false;
             }
 
-            // Load textures
+            return true;
+        }
+
+        bool buildGLTF(const std::filesystem::path& modelPath,
+                       const tinygltf::Model&       gltfModel,
+                       resource::Model&             model,
+                       renderer::RenderContext&     rc,
+                       const glm::vec3&             scale)
+        {
+            VGFW_PROFILE_FUNCTION
+            // Load textures, decoding runs on the job system and only the upload stays on the GL thread
             model.textures.resize(gltfModel.textures.size());
-            for (const auto& texture : gltfModel.textures)
             {
-                const auto&              image = gltfModel.images[texture.source];
-                vgfw::renderer::Texture* loadedTexture =
-                    vgfw::io::loadTexture(modelPath.parent_path() / image.uri, rc, false);
-                model.textures[texture.source] = loadedTexture;
+                std::vector<std::filesystem::path> texturePaths(gltfModel.textures.size());
+                std::vector<DecodedImage>          decodedImages(gltfModel.textures.size());
+                for (size_t i = 0; i < gltfModel.textures.size(); ++i)
+                {
+                    const auto& image = gltfModel.images[gltfModel.textures[i].source];
+                    const auto  path  = modelPath.parent_path() / image.uri;
+                    if (!g_TextureCache.contains(std::filesystem::hash_value(std::filesystem::absolute(path))))
+                        texturePaths[i] = path;
+                }
+
+                jobs::parallelFor(
+                    static_cast<uint32_t>(texturePaths.size()), 1, [&](uint32_t begin, uint32_t end) {
+                        for (auto i = begin; i < end; ++i)
+                        {
+                            if (!texturePaths[i].empty())
+                                decodedImages[i] = decodeImage(texturePaths[i], false);
+                        }
+                    });
+
+                for (size_t i = 0; i < gltfModel.textures.size(); ++i)
+                {
+                    const auto& texture = gltfModel.textures[i];
+                    const auto& image   = gltfModel.images[texture.source];
+                    const auto  path    = modelPath.parent_path() / image.uri;
+
+                    // Several textures may share one image, only the first one uploads it
+                    const auto h = std::filesystem::hash_value(std::filesystem::absolute(path));
+                    if (decodedImages[i].pixels && !g_TextureCache.contains(h))
+                        model.textures[texture.source] = uploadTexture(path, decodedImages[i], rc);
+                    else
+                        model.textures[texture.source] = acquireTexture(path, rc, false);
+
+                    if (decodedImages[i].pixels)
+                        stbi_image_free(decodedImages[i].pixels);
+                }
             }
 
             // Load materials
@@ -3918,7 +11880,12 @@ namespace vgfw
                 model.materials[&material - &gltfModel.materials[0]] = mat;
             }
 
-            // Load meshes
+            size_t numPrimitives = 0;
+            for (const auto& mesh : gltfModel.meshes)
+                numPrimitives += mesh.primitives.size();
+            model.meshPrimitives.reserve(model.meshPrimitives.size() + numPrimitives);
+
+            // Load meshes, the accessor counts are known so every array is reserved before it is filled
             for (const auto& mesh : gltfModel.meshes)
             {
                 for (const auto& primitive : mesh.primitives)
@@ -3926,13 +11893,17 @@ namespace vgfw
                     if (primitive.indices < 0)
                         continue;
 
-                    auto& meshPrimitive = model.meshPrimitives.emplace_back();
+                    LoadStageTimer meshTimer {LoadStage::eMeshProcessing};
+
+                    auto& meshPrimitive = model.addMeshPrimitive();
                     meshPrimitive.name  = mesh.name;
 
                     const tinygltf::Accessor&   indexAccessor   = gltfModel.accessors[primitive.indices];
                     const tinygltf::BufferView& indexBufferView = gltfModel.bufferViews[indexAccessor.bufferView];
                     const tinygltf::Buffer&     indexBuffer     = gltfModel.buffers[indexBufferView.buffer];
 
+                    meshPrimitive.indices.reserve(indexAccessor.count);
+
                     const void* indicesData =
                         indexBuffer.data.data() + indexBufferView.byteOffset + indexAccessor.byteOffset;
 
@@ -3969,6 +11940,7 @@ namespace vgfw
                     const tinygltf::BufferView& positionBufferView = gltfModel.bufferViews[positionAccessor.bufferView];
                     const tinygltf::Buffer&     positionBuffer     = gltfModel.buffers[positionBufferView.buffer];
 
+                    meshPrimitive.record.positions.reserve(positionAccessor.count);
                     for (size_t i = 0; i < positionAccessor.count; ++i)
                     {
                         const float* positions = reinterpret_cast<const float*>(
@@ -3989,6 +11961,7 @@ namespace vgfw
                         const tinygltf::BufferView& normalBufferView = gltfModel.bufferViews[normalAccessor.bufferView];
                         const tinygltf::Buffer&     normalBuffer     = gltfModel.buffers[normalBufferView.buffer];
 
+                        meshPrimitive.record.normals.reserve(normalAccessor.count);
                         for (size_t i = 0; i < normalAccessor.count; ++i)
                         {
                             const float* normals = reinterpret_cast<const float*>(
@@ -4011,6 +11984,7 @@ namespace vgfw
                             gltfModel.bufferViews[texCoordAccessor.bufferView];
                         const tinygltf::Buffer& texCoordBuffer = gltfModel.buffers[texCoordBufferView.buffer];
 
+                        meshPrimitive.record.texcoords.reserve(texCoordAccessor.count);
                         for (size_t i = 0; i < texCoordAccessor.count; ++i)
                         {
                             const float* texCoords = reinterpret_cast<const float*>(texCoordBuffer.data.data() +
@@ -4034,6 +12008,7 @@ namespace vgfw
                             gltfModel.bufferViews[tangentAccessor.bufferView];
                         const tinygltf::Buffer& tangentBuffer = gltfModel.buffers[tangentBufferView.buffer];
 
+                        meshPrimitive.record.tangents.reserve(tangentAccessor.count);
                         for (size_t i = 0; i < tangentAccessor.count; ++i)
                         {
                             const float* tangents = reinterpret_cast<const float*>(
@@ -4089,6 +12064,7 @@ namespace vgfw
 
                     meshPrimitive.ownerModel        = &model;
                     meshPrimitive.indexInOwnerModel = model.meshPrimitives.size() - 1;
+                    meshTimer.stop();
                     meshPrimitive.build(vertexFormatBuilder, scale, rc);
                 }
             }
@@ -4096,6 +12072,22 @@ namespace vgfw
             return true;
         }
 
+        bool loadGLTF(const std::filesystem::path& modelPath,
+                      resource::Model&             model,
+                      renderer::RenderContext&     rc,
+                      const glm::vec3&             scale)
+        {
+            const LoadReportScope reportScope {modelPath};
+
+            tinygltf::Model gltfModel;
+            LoadStageArray  stages {};
+            const bool      parsed = parseGLTF(modelPath, gltfModel, stages);
+            if (g_ActiveLoadReport)
+                mergeLoadStages(g_ActiveLoadReport->stages, stages);
+
+            return parsed && buildGLTF(modelPath, gltfModel, model, rc, scale);
+        }
+
         bool loadModel(const std::filesystem::path& modelPath,
                        resource::Model&             model,
                        renderer::RenderContext&     rc,
@@ -4113,22 +12105,219 @@ namespace vgfw
 
             return false;
         }
+
+        struct UploadScheduler
+        {
+            std::mutex                          mutex;
+            std::deque<std::coroutine_handle<>> queue;
+            time::Duration                      budget {0.002f};
+        };
+
+        static UploadScheduler            g_UploadScheduler;
+        static renderer::GpuTextureHandle g_PlaceholderTexture;
+        static resource::Model            g_PlaceholderModel {};
+
+        renderer::Texture* getPlaceholderTexture(renderer::RenderContext& rc)
+        {
+            if (!g_PlaceholderTexture)
+            {
+                constexpr uint32_t kWhite {0xFFFFFFFFu};
+
+                auto texture = rc.createTexture2D({1, 1}, renderer::PixelFormat::eRGBA8_UNorm);
+                rc.upload(texture,
+                          0,
+                          {1, 1},
+                          {.format = GL_RGBA, .dataType = GL_UNSIGNED_BYTE, .pixels = &kWhite});
+                g_PlaceholderTexture = rc.add(std::move(texture));
+            }
+            return rc.get(g_PlaceholderTexture);
+        }
+
+        Task streamTexture(std::filesystem::path    texturePath,
+                           renderer::RenderContext& rc,
+                           bool                     flip,
+                           TextureHandle            handle)
+        {
+            const auto begin = time::Clock::now();
+
+            co_await resumeOnWorker();
+            auto image = decodeImage(texturePath, flip);
+
+            co_await resumeOnUploadQueue();
+
+            // Another request may have uploaded the same texture in the meantime
+            const auto h = std::filesystem::hash_value(std::filesystem::absolute(texturePath));
+            if (auto it = g_TextureCache.find(h); it != g_TextureCache.cend())
+            {
+                stbi_image_free(image.pixels);
+                handle.resolve(rc.get(it->second));
+                co_return;
+            }
+
+            // Total time includes the time spent waiting in the job system and the upload queue
+            const auto texture = [&] {
+                const LoadReportScope reportScope {texturePath, begin};
+                return uploadTexture(texturePath, image, rc);
+            }();
+            handle.resolve(rc.get(texture));
+        }
+
+        Task streamModel(std::filesystem::path    modelPath,
+                         renderer::RenderContext& rc,
+                         glm::vec3                scale,
+                         ModelHandle              handle)
+        {
+            auto       model = std::make_unique<resource::Model>();
+            const auto begin = time::Clock::now();
+
+            const auto& ext = modelPath.extension();
+            if (ext == ".gltf" || ext == ".glb")
+            {
+                co_await resumeOnWorker();
+
+                tinygltf::Model gltfModel;
+                LoadStageArray  stages {};
+                if (!parseGLTF(modelPath, gltfModel, stages))
+                {
+                    co_await resumeOnUploadQueue();
+                    handle.resolve(&g_PlaceholderModel);
+                    co_return;
+                }
+
+                // Stream textures one upload at a time, buildGLTF then picks them up from the cache
+                std::vector<TextureHandle> textures;
+                for (const auto& texture : gltfModel.textures)
+                {
+                    co_await resumeOnUploadQueue();
+                    textures.push_back(
+                        loadTextureAsync(modelPath.parent_path() / gltfModel.images[texture.source].uri, rc, false));
+                }
+                for (const auto& texture : textures)
+                    co_await texture;
+
+                co_await resumeOnUploadQueue();
+
+                const LoadReportScope reportScope {modelPath, begin};
+                if (g_ActiveLoadReport)
+                    mergeLoadStages(g_ActiveLoadReport->stages, stages);
+                buildGLTF(modelPath, gltfModel, *model, rc, scale);
+            }
+            else
+            {
+                // tinyobj parsing and buffer creation are interleaved, so OBJ models are built in a single upload slice
+                co_await resumeOnUploadQueue();
+
+                const LoadReportScope reportScope {modelPath, begin};
+                loadModel(modelPath, *model, rc, scale);
+            }
+
+            handle.resolve(handle.own(std::move(model)));
+        }
+
+        TextureHandle loadTextureAsync(const std::filesystem::path& texturePath,
+                                       renderer::RenderContext&     rc,
+                                       bool                         flip,
+                                       renderer::Texture*           placeholder)
+        {
+            assert(jobs::isGLThread());
+
+            TextureHandle handle {placeholder ? placeholder : getPlaceholderTexture(rc)};
+            if (texturePath.empty())
+            {
+                handle.resolve(handle.get());
+                return handle;
+            }
+
+            const auto h = std::filesystem::hash_value(std::filesystem::absolute(texturePath));
+            if (auto it = g_TextureCache.find(h); it != g_TextureCache.cend())
+            {
+                handle.resolve(rc.get(it->second));
+                return handle;
+            }
+
+            streamTexture(texturePath, rc, flip, handle);
+            return handle;
+        }
+
+        ModelHandle
+        loadModelAsync(const std::filesystem::path& modelPath, renderer::RenderContext& rc, const glm::vec3& scale)
+        {
+            assert(jobs::isGLThread());
+
+            ModelHandle handle {&g_PlaceholderModel};
+            streamModel(modelPath, rc, scale, handle);
+            return handle;
+        }
+
+        void setUploadBudget(time::Duration budget) { g_UploadScheduler.budget = budget; }
+
+        time::Duration getUploadBudget() { return g_UploadScheduler.budget; }
+
+        uint32_t getNumPendingUploads()
+        {
+            std::lock_guard lock {g_UploadScheduler.mutex};
+            return static_cast<uint32_t>(g_UploadScheduler.queue.size());
+        }
+
+        void enqueueUpload(std::coroutine_handle<> handle)
+        {
+            {
+                std::lock_guard lock {g_UploadScheduler.mutex};
+                g_UploadScheduler.queue.push_back(handle);
+            }
+
+            // Wake up an event-driven window so the upload gets a frame
+            if (renderer::isLoaded())
+                renderer::getGraphicsContext().getWindow()->requestRedraw();
+        }
+
+        void processUploads()
+        {
+            VGFW_PROFILE_FUNCTION
+
+            const auto start = time::Clock::now();
+            do
+            {
+                std::coroutine_handle<> handle {};
+                {
+                    std::lock_guard lock {g_UploadScheduler.mutex};
+                    if (g_UploadScheduler.queue.empty())
+                        break;
+                    handle = g_UploadScheduler.queue.front();
+                    g_UploadScheduler.queue.pop_front();
+                }
+                handle.resume();
+            } while (time::Duration(time::Clock::now() - start) < g_UploadScheduler.budget);
+
+            if (getNumPendingUploads() > 0 && renderer::isLoaded())
+                renderer::getGraphicsContext().getWindow()->requestRedraw();
+        }
     } // namespace io
 
-    bool init()
+    bool init(const log::LogInitInfo& logInitInfo)
     {
-        log::init();
+        log::init(logInitInfo);
+#ifdef VGFW_ENABLE_BUILTIN_PROFILER
+        profiler::setThreadName("Main Thread");
+#endif
 
         return true;
     }
 
     void shutdown()
     {
+        // Jobs may still hold GL work, drain them while the context is alive
+        if (jobs::isInitialized())
+        {
+            jobs::shutdown();
+        }
+
         if (renderer::isLoaded())
         {
             renderer::shutdown();
         }
 
+        vfs::unmountAll();
         log::shutdown();
     }
 } // namespace vgfw
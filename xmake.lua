@@ -12,6 +12,30 @@ option("examples") -- build examples?
     set_default(true)
 option_end()
 
+option("tools") -- build tools? (vgfw-replay, vgfw-pack)
+    set_default(true)
+option_end()
+
+option("bench") -- build CPU micro-benchmarks? (vgfw-bench, needs google benchmark)
+    set_default(false)
+option_end()
+
+option("null_gl") -- stub out every GL call? (CPU overhead measurements without a GPU, see VGFW_NULL_GL)
+    set_default(false)
+option_end()
+
+option("lz4") -- support LZ4 compressed entries in asset packs? (see VGFW_ENABLE_LZ4)
+    set_default(false)
+option_end()
+
+if has_config("null_gl") then
+    add_defines("VGFW_NULL_GL")
+end
+
+if has_config("lz4") then
+    add_defines("VGFW_ENABLE_LZ4")
+end
+
 -- if build on windows
 if is_plat("windows") then
     add_cxxflags("/EHsc")
@@ -87,6 +111,9 @@ add_repositories("my-xmake-repo https://github.com/zzxzzk115/xmake-repo.git dev"
 -- add requirements
 add_requires("fg", "glad", "glfw", "glm", "spdlog", "stb", "tinyobjloader", "tinygltf")
 add_requires("imgui v1.90.8-docking", {configs = {glfw = true, opengl3 = true, wchar32 = true}})
+if has_config("lz4") then
+    add_requires("lz4")
+end
 
 -- target defination, name: vgfw
 target("vgfw")
@@ -111,8 +138,21 @@ target("vgfw")
     add_packages("stb", { public = true })
     add_packages("tinyobjloader", { public = true })
     add_packages("tinygltf", { public = true })
+    if has_config("lz4") then
+        add_packages("lz4", { public = true })
+    end
 
 -- if build examples, then include examples
 if has_config("examples") then
     includes("examples")
 end
+
+-- if build tools, then include tools
+if has_config("tools") then
+    includes("tools")
+end
+
+-- if build benchmarks, then include bench
+if has_config("bench") then
+    includes("bench")
+end